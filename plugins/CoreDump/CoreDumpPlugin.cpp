@@ -0,0 +1,454 @@
+#include "CoreDumpPlugin.h"
+
+#include <QStyle>
+#include <QApplication>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QMap>
+#include <QMutexLocker>
+#include <algorithm>
+#include <cstring>
+
+// ──────────────────────────────────────────────────────────────────────────
+// ELF layout
+//
+// Only the handful of fields a core file needs are decoded, straight from
+// the byte layout, so the plugin builds on hosts without <elf.h>.  Cores are
+// read in host order and must be little-endian (every platform we ship on).
+// ──────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+constexpr uint8_t  kElfClass32   = 1;
+constexpr uint8_t  kElfClass64   = 2;
+constexpr uint8_t  kElfDataLsb   = 1;
+constexpr uint16_t kEtCore       = 4;
+constexpr uint16_t kPnXnum       = 0xFFFF;  // real phnum lives in shdr[0].sh_info
+constexpr uint32_t kPtLoad       = 1;
+constexpr uint32_t kPtNote       = 4;
+constexpr uint32_t kPfX          = 1;
+constexpr uint32_t kPfW          = 2;
+constexpr uint32_t kPfR          = 4;
+constexpr uint32_t kNtFile       = 0x46494C45;  // "FILE"
+constexpr uint32_t kMaxPhnum     = 1u << 20;
+constexpr uint64_t kMaxNoteBytes = 64ull << 20;
+
+template<typename T>
+T rd(const char* p) { T v; std::memcpy(&v, p, sizeof(T)); return v; }
+
+uint64_t rdWord(const char* p, bool is64) {
+    return is64 ? rd<uint64_t>(p) : rd<uint32_t>(p);
+}
+
+uint64_t align4(uint64_t v) { return (v + 3) & ~uint64_t(3); }
+
+} // namespace
+
+// ──────────────────────────────────────────────────────────────────────────
+// CoreDumpProvider implementation
+// ──────────────────────────────────────────────────────────────────────────
+
+CoreDumpProvider::CoreDumpProvider(const QString& path)
+    : m_file(path)
+    , m_name(QFileInfo(path).fileName())
+{
+    // Unbuffered: a seek into QFile's read-ahead would hand back bytes from
+    // an earlier read, which for /proc/kcore means a stale tick
+    if (!m_file.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+        m_error = m_file.errorString();
+        return;
+    }
+    m_isLive = QFileInfo(path).canonicalFilePath() == QStringLiteral("/proc/kcore");
+    m_fileSize = static_cast<uint64_t>(qMax<qint64>(0, m_file.size()));
+
+    // procfs files cannot be mapped; everything else should map fine
+    if (!m_isLive && m_fileSize > 0)
+        m_map = m_file.map(0, static_cast<qint64>(m_fileSize));
+
+    if (!parse()) {
+        m_segments.clear();
+        m_modules.clear();
+        m_regions.clear();
+    }
+}
+
+CoreDumpProvider::~CoreDumpProvider()
+{
+    if (m_map)
+        m_file.unmap(const_cast<uchar*>(m_map));
+}
+
+bool CoreDumpProvider::fetch(uint64_t offset, void* buf, uint64_t len) const
+{
+    if (m_map) {
+        if (offset > m_fileSize || len > m_fileSize - offset) return false;
+        std::memcpy(buf, m_map + offset, len);
+        return true;
+    }
+    QMutexLocker lock(&m_fileLock);
+    if (!m_file.seek(static_cast<qint64>(offset))) return false;
+    return m_file.read(static_cast<char*>(buf), static_cast<qint64>(len))
+        == static_cast<qint64>(len);
+}
+
+bool CoreDumpProvider::parse()
+{
+    char eh[64];
+    if (!fetch(0, eh, 52) || std::memcmp(eh, "\x7f" "ELF", 4) != 0) {
+        m_error = QStringLiteral("Not an ELF file");
+        return false;
+    }
+    uint8_t cls = static_cast<uint8_t>(eh[4]);
+    if (cls != kElfClass32 && cls != kElfClass64) {
+        m_error = QStringLiteral("Unknown ELF class %1").arg(cls);
+        return false;
+    }
+    if (static_cast<uint8_t>(eh[5]) != kElfDataLsb) {
+        m_error = QStringLiteral("Big-endian cores are not supported");
+        return false;
+    }
+    m_is64 = (cls == kElfClass64);
+    if (m_is64 && !fetch(0, eh, 64)) {
+        m_error = QStringLiteral("Truncated ELF header");
+        return false;
+    }
+    if (rd<uint16_t>(eh + 16) != kEtCore) {
+        m_error = QStringLiteral("ELF file is not a core dump");
+        return false;
+    }
+
+    uint64_t phoff, shoff;
+    uint32_t phentsize, phnum;
+    if (m_is64) {
+        phoff     = rd<uint64_t>(eh + 32);
+        shoff     = rd<uint64_t>(eh + 40);
+        phentsize = rd<uint16_t>(eh + 54);
+        phnum     = rd<uint16_t>(eh + 56);
+    } else {
+        phoff     = rd<uint32_t>(eh + 28);
+        shoff     = rd<uint32_t>(eh + 32);
+        phentsize = rd<uint16_t>(eh + 42);
+        phnum     = rd<uint16_t>(eh + 44);
+    }
+
+    // More than 65534 mappings: the count moves to section header 0
+    if (phnum == kPnXnum) {
+        char info[4];
+        if (!shoff || !fetch(shoff + (m_is64 ? 44 : 28), info, 4)) {
+            m_error = QStringLiteral("PN_XNUM core without section header");
+            return false;
+        }
+        phnum = rd<uint32_t>(info);
+    }
+
+    const uint32_t minEnt = m_is64 ? 56 : 32;
+    if (phentsize < minEnt || phentsize > 256 || phnum == 0 || phnum > kMaxPhnum) {
+        m_error = QStringLiteral("Bad program header table");
+        return false;
+    }
+
+    QByteArray ph(static_cast<int>(phentsize * phnum), Qt::Uninitialized);
+    if (!fetch(phoff, ph.data(), static_cast<uint64_t>(ph.size()))) {
+        m_error = QStringLiteral("Truncated program header table");
+        return false;
+    }
+
+    QVector<QPair<uint64_t, uint64_t>> notes;
+    m_segments.reserve(static_cast<int>(phnum));
+    for (uint32_t i = 0; i < phnum; i++) {
+        const char* p = ph.constData() + static_cast<size_t>(i) * phentsize;
+        uint32_t type = rd<uint32_t>(p);
+        uint32_t flags;
+        uint64_t offset, vaddr, filesz, memsz;
+        if (m_is64) {
+            flags  = rd<uint32_t>(p + 4);
+            offset = rd<uint64_t>(p + 8);
+            vaddr  = rd<uint64_t>(p + 16);
+            filesz = rd<uint64_t>(p + 32);
+            memsz  = rd<uint64_t>(p + 40);
+        } else {
+            offset = rd<uint32_t>(p + 4);
+            vaddr  = rd<uint32_t>(p + 8);
+            filesz = rd<uint32_t>(p + 16);
+            memsz  = rd<uint32_t>(p + 20);
+            flags  = rd<uint32_t>(p + 24);
+        }
+
+        if (type == kPtNote) {
+            notes.append({offset, filesz});
+        } else if (type == kPtLoad && memsz > 0) {
+            if (vaddr + memsz < vaddr) continue;   // wraps the address space
+            filesz = qMin(filesz, memsz);
+            // A truncated core keeps its headers but loses the tail; treat
+            // the missing bytes like undumped pages rather than failing.
+            if (m_map)
+                filesz = offset >= m_fileSize ? 0 : qMin(filesz, m_fileSize - offset);
+            uint32_t prot = rcx::RP_None;
+            if (flags & kPfR) prot |= rcx::RP_Read;
+            if (flags & kPfW) prot |= rcx::RP_Write;
+            if (flags & kPfX) prot |= rcx::RP_Exec;
+            m_segments.append({vaddr, memsz, filesz, offset, prot});
+        }
+    }
+
+    if (m_segments.isEmpty()) {
+        m_error = QStringLiteral("Core has no PT_LOAD segments");
+        return false;
+    }
+
+    // Sort for binary search and trim any overlap so each address maps to
+    // exactly one segment (first one wins, matching the kernel's order).
+    std::stable_sort(m_segments.begin(), m_segments.end(),
+        [](const Segment& a, const Segment& b) { return a.vaddr < b.vaddr; });
+    QVector<Segment> merged;
+    merged.reserve(m_segments.size());
+    for (Segment s : m_segments) {
+        if (!merged.isEmpty()) {
+            uint64_t prevEnd = merged.last().vaddr + merged.last().memsz;
+            if (s.vaddr + s.memsz <= prevEnd) continue;
+            if (s.vaddr < prevEnd) {
+                uint64_t cut = prevEnd - s.vaddr;
+                s.vaddr  += cut;
+                s.memsz  -= cut;
+                s.offset += cut;
+                s.filesz  = s.filesz > cut ? s.filesz - cut : 0;
+            }
+        }
+        merged.append(s);
+    }
+    m_segments = std::move(merged);
+
+    for (const auto& n : notes)
+        parseNotes(n.first, n.second);
+
+    buildModules();
+    buildRegions();
+
+    m_base = m_modules.isEmpty() ? m_segments.first().vaddr : m_modules.first().base;
+    return true;
+}
+
+void CoreDumpProvider::parseNotes(uint64_t offset, uint64_t size)
+{
+    if (size < 12 || size > kMaxNoteBytes) return;
+    QByteArray buf(static_cast<int>(size), Qt::Uninitialized);
+    if (!fetch(offset, buf.data(), size)) return;
+
+    const char* p = buf.constData();
+    uint64_t pos = 0;
+    while (pos + 12 <= size) {
+        uint32_t namesz = rd<uint32_t>(p + pos);
+        uint32_t descsz = rd<uint32_t>(p + pos + 4);
+        uint32_t type   = rd<uint32_t>(p + pos + 8);
+        uint64_t nameOff = pos + 12;
+        uint64_t descOff = nameOff + align4(namesz);
+        if (descOff > size || descsz > size - descOff) break;
+
+        if (type == kNtFile && namesz >= 4
+            && std::memcmp(p + nameOff, "CORE", 4) == 0)
+            parseFileNote(p + descOff, descsz);
+
+        pos = descOff + align4(descsz);
+    }
+}
+
+void CoreDumpProvider::parseFileNote(const char* desc, uint64_t size)
+{
+    // NT_FILE: count, page_size, count × {start, end, file_ofs}, then
+    // count NUL-terminated paths.  All words are the target's long.
+    const uint64_t w = m_is64 ? 8 : 4;
+    if (size < 2 * w) return;
+    uint64_t count = rdWord(desc, m_is64);
+    if (count == 0 || count > (size - 2 * w) / (3 * w)) return;
+
+    const char* entries = desc + 2 * w;
+    const char* names = entries + count * 3 * w;
+    const char* end = desc + size;
+
+    m_fileMaps.reserve(static_cast<int>(count));
+    for (uint64_t i = 0; i < count && names < end; i++) {
+        const char* e = entries + i * 3 * w;
+        uint64_t start = rdWord(e, m_is64);
+        uint64_t stop  = rdWord(e + w, m_is64);
+        const char* nul = static_cast<const char*>(std::memchr(names, 0, end - names));
+        if (!nul) break;
+        if (stop > start) {
+            rcx::MemoryRegion r;
+            r.base = start;
+            r.size = stop - start;
+            r.name = QString::fromUtf8(names, static_cast<int>(nul - names));
+            m_fileMaps.append(r);
+        }
+        names = nul + 1;
+    }
+}
+
+void CoreDumpProvider::buildModules()
+{
+    // One module per backing file, spanning all of its mappings
+    QMap<QString, QPair<uint64_t, uint64_t>> ranges;
+    for (const auto& fm : m_fileMaps) {
+        if (fm.name.startsWith(QStringLiteral("/dev/"))
+            || fm.name.startsWith(QStringLiteral("/memfd:")))
+            continue;
+        auto it = ranges.find(fm.name);
+        if (it == ranges.end()) {
+            ranges.insert(fm.name, {fm.base, fm.end()});
+        } else {
+            it->first  = qMin(it->first, fm.base);
+            it->second = qMax(it->second, fm.end());
+        }
+    }
+
+    m_modules.reserve(ranges.size());
+    for (auto it = ranges.constBegin(); it != ranges.constEnd(); ++it)
+        m_modules.append({QFileInfo(it.key()).fileName(),
+                          it->first, it->second - it->first});
+    std::sort(m_modules.begin(), m_modules.end(),
+        [](const Module& a, const Module& b) { return a.base < b.base; });
+}
+
+void CoreDumpProvider::buildRegions()
+{
+    QVector<rcx::MemoryRegion> files = m_fileMaps;
+    std::sort(files.begin(), files.end(),
+        [](const rcx::MemoryRegion& a, const rcx::MemoryRegion& b) { return a.base < b.base; });
+
+    m_regions.reserve(m_segments.size());
+    for (const auto& s : m_segments) {
+        rcx::MemoryRegion r;
+        r.base = s.vaddr;
+        r.size = s.memsz;
+        r.prot = s.prot;
+        auto it = std::upper_bound(files.cbegin(), files.cend(), s.vaddr,
+            [](uint64_t a, const rcx::MemoryRegion& f) { return a < f.base; });
+        if (it != files.cbegin() && s.vaddr < (it - 1)->end())
+            r.name = (it - 1)->name;
+        m_regions.append(r);
+    }
+}
+
+const CoreDumpProvider::Segment* CoreDumpProvider::segmentFor(uint64_t addr) const
+{
+    auto it = std::upper_bound(m_segments.cbegin(), m_segments.cend(), addr,
+        [](uint64_t a, const Segment& s) { return a < s.vaddr; });
+    if (it == m_segments.cbegin()) return nullptr;
+    --it;
+    return (addr - it->vaddr < it->memsz) ? &*it : nullptr;
+}
+
+bool CoreDumpProvider::read(uint64_t addr, void* buf, int len) const
+{
+    if (len <= 0) return false;
+    char* out = static_cast<char*>(buf);
+    uint64_t cur = addr;
+    uint64_t remaining = static_cast<uint64_t>(len);
+    while (remaining > 0) {
+        const Segment* s = segmentFor(cur);
+        if (!s || !(s->prot & rcx::RP_Read)) return false;
+        uint64_t off = cur - s->vaddr;
+        uint64_t chunk = qMin(remaining, s->memsz - off);
+        uint64_t fromFile = off < s->filesz ? qMin(chunk, s->filesz - off) : 0;
+        if (fromFile && !fetch(s->offset + off, out, fromFile))
+            return false;
+        if (chunk > fromFile)
+            std::memset(out + fromFile, 0, chunk - fromFile);
+        out += chunk;
+        cur += chunk;
+        remaining -= chunk;
+    }
+    return true;
+}
+
+bool CoreDumpProvider::isReadable(uint64_t addr, int len) const
+{
+    if (len <= 0) return (len == 0);
+    return rcx::regionsCover(m_regions, addr, static_cast<uint64_t>(len));
+}
+
+uint64_t CoreDumpProvider::size64() const
+{
+    if (m_segments.isEmpty()) return 0;
+    const Segment& last = m_segments.last();
+    return last.vaddr + last.memsz;
+}
+
+int CoreDumpProvider::size() const
+{
+    return static_cast<int>(qMin<uint64_t>(size64(), INT_MAX));
+}
+
+QString CoreDumpProvider::getSymbol(uint64_t addr) const
+{
+    auto it = std::upper_bound(m_modules.cbegin(), m_modules.cend(), addr,
+        [](uint64_t a, const Module& m) { return a < m.base; });
+    if (it == m_modules.cbegin()) return {};
+    --it;
+    if (addr - it->base >= it->size) return {};
+    return QStringLiteral("%1+0x%2")
+        .arg(it->name)
+        .arg(addr - it->base, 0, 16, QChar('0'));
+}
+
+uint64_t CoreDumpProvider::symbolToAddress(const QString& name) const
+{
+    for (const auto& mod : m_modules) {
+        if (mod.name.compare(name, Qt::CaseInsensitive) == 0)
+            return mod.base;
+    }
+    return 0;
+}
+
+// ──────────────────────────────────────────────────────────────────────────
+// CoreDumpPlugin implementation
+// ──────────────────────────────────────────────────────────────────────────
+
+QIcon CoreDumpPlugin::Icon() const
+{
+    return qApp->style()->standardIcon(QStyle::SP_DriveHDIcon);
+}
+
+bool CoreDumpPlugin::canHandle(const QString& target) const
+{
+    return target.startsWith("core:", Qt::CaseInsensitive);
+}
+
+std::unique_ptr<rcx::Provider> CoreDumpPlugin::createProvider(const QString& target, QString* errorMsg)
+{
+    QString path = target.mid(5);
+    auto provider = std::make_unique<CoreDumpProvider>(path);
+    if (!provider->isValid())
+    {
+        if (errorMsg)
+            *errorMsg = QString("Failed to open core dump.\n\n"
+                               "Target: %1\n\n%2")
+                        .arg(path, provider->errorString());
+        return nullptr;
+    }
+    return provider;
+}
+
+uint64_t CoreDumpPlugin::getInitialBaseAddress(const QString& target) const
+{
+    // Only the headers are touched; the segment data stays unmapped-in
+    CoreDumpProvider provider(target.mid(5));
+    return provider.base();
+}
+
+bool CoreDumpPlugin::selectTarget(QWidget* parent, QString* target)
+{
+    QString path = QFileDialog::getOpenFileName(parent, "Open Core Dump", {},
+        "Core dumps (core core.* *.core);;Kernel (kcore);;All files (*)");
+    if (path.isEmpty()) return false;
+    *target = QStringLiteral("core:") + path;
+    return true;
+}
+
+// ──────────────────────────────────────────────────────────────────────────
+// Plugin factory
+// ──────────────────────────────────────────────────────────────────────────
+
+extern "C" RCX_PLUGIN_EXPORT IPlugin* CreatePlugin()
+{
+    return new CoreDumpPlugin();
+}
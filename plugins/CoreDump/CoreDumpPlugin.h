@@ -0,0 +1,121 @@
+#pragma once
+#include "../../src/iplugin.h"
+#include "../../src/core.h"
+
+#include <cstdint>
+#include <QFile>
+#include <QMutex>
+#include <QVector>
+
+/**
+ * ELF core dump provider
+ *
+ * Opens an ELF core file (gdb/systemd-coredump output, or /proc/kcore) and
+ * serves the dumped virtual address space.
+ *
+ *   - The file is memory-mapped read-only, so opening a multi-GB core is
+ *     O(1) and reads are a memcpy straight out of the mapping.  Files that
+ *     cannot be mapped (/proc/kcore, procfs in general) fall back to
+ *     positioned reads.
+ *   - PT_LOAD segments are kept in a table sorted by vaddr, so address
+ *     translation is a binary search.  The tail of a segment past p_filesz
+ *     (pages the kernel chose not to dump) reads as zeros.
+ *   - The NT_FILE note supplies the module list for getSymbol() and
+ *     symbolToAddress().
+ *
+ * Target string format:
+ *   "core:/path/to/core"   - open a core file
+ *   "core:/proc/kcore"     - running kernel (live, needs CAP_SYS_RAWIO)
+ */
+class CoreDumpProvider : public rcx::Provider
+{
+public:
+    explicit CoreDumpProvider(const QString& path);
+    ~CoreDumpProvider() override;
+
+    CoreDumpProvider(const CoreDumpProvider&) = delete;
+    CoreDumpProvider& operator=(const CoreDumpProvider&) = delete;
+
+    // Required overrides
+    bool read(uint64_t addr, void* buf, int len) const override;
+    int size() const override;
+
+    // Optional overrides
+    uint64_t size64() const override;
+    bool isReadable(uint64_t addr, int len) const override;
+    QVector<rcx::MemoryRegion> regions() const override { return m_regions; }
+    QString name() const override { return m_name; }
+    QString kind() const override { return QStringLiteral("CoreDump"); }
+    QString getSymbol(uint64_t addr) const override;
+    uint64_t symbolToAddress(const QString& name) const override;
+    bool isLive() const override { return m_isLive; }
+    uint64_t base() const override { return m_base; }
+    // Mapped dumps are plain memcpy and page faults, safe from any thread;
+    // the unmapped fallback serialises on m_fileLock anyway
+    int maxConcurrentReads() const override { return m_map ? 4 : 1; }
+
+    // Empty on success, otherwise why the file was rejected
+    QString errorString() const { return m_error; }
+    bool isMapped() const { return m_map != nullptr; }
+
+    struct Segment {
+        uint64_t vaddr;
+        uint64_t memsz;
+        uint64_t filesz;   // <= memsz; bytes past this read as zero
+        uint64_t offset;   // file offset of vaddr
+        uint32_t prot;     // rcx::RegionProt bits
+    };
+    struct Module {
+        QString  name;
+        uint64_t base;
+        uint64_t size;
+    };
+    const QVector<Segment>& segments() const { return m_segments; }
+    const QVector<Module>& modules() const { return m_modules; }
+
+private:
+    bool parse();
+    void parseNotes(uint64_t offset, uint64_t size);
+    void parseFileNote(const char* desc, uint64_t size);
+    void buildModules();
+    void buildRegions();
+    bool fetch(uint64_t offset, void* buf, uint64_t len) const;
+    const Segment* segmentFor(uint64_t addr) const;
+
+    mutable QFile    m_file;
+    mutable QMutex   m_fileLock;    // guards m_file seek+read when unmapped
+    const uchar*     m_map = nullptr;
+    uint64_t         m_fileSize = 0;
+    bool             m_is64 = true;
+    bool             m_isLive = false;
+    uint64_t         m_base = 0;
+    QString          m_name;
+    QString          m_error;
+
+    QVector<Segment>            m_segments;   // sorted by vaddr, non-overlapping
+    QVector<Module>             m_modules;    // sorted by base
+    QVector<rcx::MemoryRegion>  m_regions;
+    QVector<rcx::MemoryRegion>  m_fileMaps;   // NT_FILE entries, in note order
+};
+
+/**
+ * Plugin that provides CoreDumpProvider
+ */
+class CoreDumpPlugin : public IProviderPlugin
+{
+public:
+    std::string Name() const override { return "Core Dump"; }
+    std::string Version() const override { return "1.0.0"; }
+    std::string Author() const override { return "Reclass"; }
+    std::string Description() const override { return "Open ELF core dumps and /proc/kcore"; }
+    k_ELoadType LoadType() const override { return k_ELoadTypeAuto; }
+    QIcon Icon() const override;
+
+    bool canHandle(const QString& target) const override;
+    std::unique_ptr<rcx::Provider> createProvider(const QString& target, QString* errorMsg) override;
+    uint64_t getInitialBaseAddress(const QString& target) const override;
+    bool selectTarget(QWidget* parent, QString* target) override;
+};
+
+// Plugin export
+extern "C" RCX_PLUGIN_EXPORT IPlugin* CreatePlugin();
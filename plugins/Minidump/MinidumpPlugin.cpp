@@ -0,0 +1,400 @@
+#include "MinidumpPlugin.h"
+
+#include <QStyle>
+#include <QApplication>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <algorithm>
+#include <cstring>
+
+// ──────────────────────────────────────────────────────────────────────────
+// Minidump layout
+//
+// Decoded straight from the byte layout (all little-endian) so the plugin
+// does not need <dbghelp.h> and builds on every host.
+// ──────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+constexpr uint32_t kSignature            = 0x504D444D;  // "MDMP"
+constexpr uint32_t kModuleListStream     = 4;
+constexpr uint32_t kMemoryListStream     = 5;
+constexpr uint32_t kMemory64ListStream   = 9;
+constexpr uint32_t kMemoryInfoListStream = 16;
+constexpr uint32_t kModuleEntrySize      = 108;  // MINIDUMP_MODULE
+constexpr uint32_t kMemInfoMinEntry      = 48;   // MINIDUMP_MEMORY_INFO
+constexpr uint32_t kMemCommit            = 0x1000;
+constexpr uint32_t kMaxStreams           = 1u << 16;
+constexpr uint64_t kMaxNameBytes         = 64 * 1024;
+
+template<typename T>
+T rd(const char* p) { T v; std::memcpy(&v, p, sizeof(T)); return v; }
+
+// PAGE_* protection constant → RegionProt bits
+uint32_t protFromPage(uint32_t protect)
+{
+    switch (protect & 0xFF) {
+    case 0x02: return rcx::RP_Read;                                    // READONLY
+    case 0x04: case 0x08: return rcx::RP_Read | rcx::RP_Write;         // READWRITE, WRITECOPY
+    case 0x10: return rcx::RP_Exec;                                    // EXECUTE
+    case 0x20: return rcx::RP_Read | rcx::RP_Exec;                     // EXECUTE_READ
+    case 0x40: case 0x80: return rcx::RP_Read | rcx::RP_Write | rcx::RP_Exec;
+    default:   return rcx::RP_None;                                    // NOACCESS, guard
+    }
+}
+
+} // namespace
+
+// ──────────────────────────────────────────────────────────────────────────
+// MinidumpProvider implementation
+// ──────────────────────────────────────────────────────────────────────────
+
+MinidumpProvider::MinidumpProvider(const QString& path)
+    : m_file(path)
+    , m_name(QFileInfo(path).fileName())
+{
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = m_file.errorString();
+        return;
+    }
+    m_fileSize = static_cast<uint64_t>(qMax<qint64>(0, m_file.size()));
+    if (m_fileSize > 0)
+        m_map = m_file.map(0, static_cast<qint64>(m_fileSize));
+
+    if (!parse()) {
+        m_ranges.clear();
+        m_modules.clear();
+        m_regions.clear();
+    }
+}
+
+MinidumpProvider::~MinidumpProvider()
+{
+    if (m_map)
+        m_file.unmap(const_cast<uchar*>(m_map));
+}
+
+bool MinidumpProvider::fetch(uint64_t offset, void* buf, uint64_t len) const
+{
+    if (offset > m_fileSize || len > m_fileSize - offset) return false;
+    if (m_map) {
+        std::memcpy(buf, m_map + offset, len);
+        return true;
+    }
+    QMutexLocker lock(&m_fileLock);
+    if (!m_file.seek(static_cast<qint64>(offset))) return false;
+    return m_file.read(static_cast<char*>(buf), static_cast<qint64>(len))
+        == static_cast<qint64>(len);
+}
+
+bool MinidumpProvider::parse()
+{
+    char hdr[32];
+    if (!fetch(0, hdr, sizeof(hdr)) || rd<uint32_t>(hdr) != kSignature) {
+        m_error = QStringLiteral("Not a minidump file");
+        return false;
+    }
+    uint32_t numStreams = rd<uint32_t>(hdr + 8);
+    uint32_t dirRva     = rd<uint32_t>(hdr + 12);
+    if (numStreams == 0 || numStreams > kMaxStreams) {
+        m_error = QStringLiteral("Bad stream directory");
+        return false;
+    }
+
+    QByteArray dir(static_cast<int>(numStreams * 12), Qt::Uninitialized);
+    if (!fetch(dirRva, dir.data(), static_cast<uint64_t>(dir.size()))) {
+        m_error = QStringLiteral("Truncated stream directory");
+        return false;
+    }
+
+    for (uint32_t i = 0; i < numStreams; i++) {
+        const char* d = dir.constData() + i * 12;
+        uint32_t type = rd<uint32_t>(d);
+        uint32_t size = rd<uint32_t>(d + 4);
+        uint32_t rva  = rd<uint32_t>(d + 8);
+        switch (type) {
+        case kMemoryListStream:     parseMemoryList(rva, size);     break;
+        case kMemory64ListStream:   parseMemory64List(rva, size);   break;
+        case kModuleListStream:     parseModuleList(rva, size);     break;
+        case kMemoryInfoListStream: parseMemoryInfoList(rva, size); break;
+        default: break;
+        }
+    }
+
+    if (m_ranges.isEmpty()) {
+        m_error = QStringLiteral("Dump contains no memory");
+        return false;
+    }
+
+    // A dump may carry both lists, and writers occasionally emit the same
+    // range twice; sort and trim so each address maps to one range.
+    std::stable_sort(m_ranges.begin(), m_ranges.end(),
+        [](const Range& a, const Range& b) { return a.va < b.va; });
+    QVector<Range> merged;
+    merged.reserve(m_ranges.size());
+    for (Range r : m_ranges) {
+        if (!merged.isEmpty()) {
+            uint64_t prevEnd = merged.last().va + merged.last().size;
+            if (r.va + r.size <= prevEnd) continue;
+            if (r.va < prevEnd) {
+                uint64_t cut = prevEnd - r.va;
+                r.va   += cut;
+                r.rva  += cut;
+                r.size -= cut;
+            }
+        }
+        merged.append(r);
+    }
+    m_ranges = std::move(merged);
+
+    buildRegions();
+    return true;
+}
+
+void MinidumpProvider::parseMemoryList(uint64_t rva, uint64_t size)
+{
+    char cnt[4];
+    if (size < 4 || !fetch(rva, cnt, 4)) return;
+    uint64_t count = qMin<uint64_t>(rd<uint32_t>(cnt), (size - 4) / 16);
+    QByteArray descs(static_cast<int>(count * 16), Qt::Uninitialized);
+    if (!fetch(rva + 4, descs.data(), static_cast<uint64_t>(descs.size()))) return;
+
+    for (uint64_t i = 0; i < count; i++) {
+        const char* d = descs.constData() + i * 16;
+        uint64_t va      = rd<uint64_t>(d);
+        uint32_t dataLen = rd<uint32_t>(d + 8);
+        uint32_t dataRva = rd<uint32_t>(d + 12);
+        if (dataLen == 0 || va + dataLen < va) continue;
+        if (dataRva >= m_fileSize || dataLen > m_fileSize - dataRva) continue;
+        m_ranges.append({va, dataLen, dataRva});
+    }
+}
+
+void MinidumpProvider::parseMemory64List(uint64_t rva, uint64_t size)
+{
+    // Descriptors carry no RVA: the data for range i follows range i-1,
+    // starting at BaseRva.
+    char hdr[16];
+    if (size < 16 || !fetch(rva, hdr, 16)) return;
+    uint64_t count   = qMin<uint64_t>(rd<uint64_t>(hdr), (size - 16) / 16);
+    uint64_t dataRva = rd<uint64_t>(hdr + 8);
+    QByteArray descs(static_cast<int>(count * 16), Qt::Uninitialized);
+    if (!fetch(rva + 16, descs.data(), static_cast<uint64_t>(descs.size()))) return;
+
+    m_ranges.reserve(m_ranges.size() + static_cast<int>(count));
+    for (uint64_t i = 0; i < count; i++) {
+        const char* d = descs.constData() + i * 16;
+        uint64_t va      = rd<uint64_t>(d);
+        uint64_t dataLen = rd<uint64_t>(d + 8);
+        if (dataRva >= m_fileSize || dataLen > m_fileSize - dataRva)
+            break;   // truncated dump: everything after this is missing
+        if (dataLen && va + dataLen > va)
+            m_ranges.append({va, dataLen, dataRva});
+        dataRva += dataLen;
+    }
+}
+
+void MinidumpProvider::parseModuleList(uint64_t rva, uint64_t size)
+{
+    char cnt[4];
+    if (size < 4 || !fetch(rva, cnt, 4)) return;
+    uint64_t count = qMin<uint64_t>(rd<uint32_t>(cnt), (size - 4) / kModuleEntrySize);
+    QByteArray mods(static_cast<int>(count * kModuleEntrySize), Qt::Uninitialized);
+    if (!fetch(rva + 4, mods.data(), static_cast<uint64_t>(mods.size()))) return;
+
+    m_modules.reserve(static_cast<int>(count));
+    for (uint64_t i = 0; i < count; i++) {
+        const char* m = mods.constData() + i * kModuleEntrySize;
+        Module mod;
+        mod.base = rd<uint64_t>(m);
+        mod.size = rd<uint32_t>(m + 8);
+        mod.path = readString(rd<uint32_t>(m + 20));
+        int slash = qMax(mod.path.lastIndexOf('\\'), mod.path.lastIndexOf('/'));
+        mod.name = mod.path.mid(slash + 1);
+        if (mod.size == 0 || mod.name.isEmpty()) continue;
+        if (m_modules.isEmpty())
+            m_base = mod.base;   // the process image is always listed first
+        m_modules.append(mod);
+    }
+    std::sort(m_modules.begin(), m_modules.end(),
+        [](const Module& a, const Module& b) { return a.base < b.base; });
+}
+
+void MinidumpProvider::parseMemoryInfoList(uint64_t rva, uint64_t size)
+{
+    char hdr[16];
+    if (size < 16 || !fetch(rva, hdr, 16)) return;
+    uint32_t headerSize = rd<uint32_t>(hdr);
+    uint32_t entrySize  = rd<uint32_t>(hdr + 4);
+    if (entrySize < kMemInfoMinEntry || headerSize < 16 || headerSize > size) return;
+    uint64_t count = qMin<uint64_t>(rd<uint64_t>(hdr + 8), (size - headerSize) / entrySize);
+    QByteArray infos(static_cast<int>(count * entrySize), Qt::Uninitialized);
+    if (!fetch(rva + headerSize, infos.data(), static_cast<uint64_t>(infos.size()))) return;
+
+    m_protInfo.reserve(static_cast<int>(count));
+    for (uint64_t i = 0; i < count; i++) {
+        const char* e = infos.constData() + i * entrySize;
+        if (rd<uint32_t>(e + 32) != kMemCommit) continue;
+        rcx::MemoryRegion r;
+        r.base = rd<uint64_t>(e);
+        r.size = rd<uint64_t>(e + 24);
+        r.prot = protFromPage(rd<uint32_t>(e + 36));
+        m_protInfo.append(r);
+    }
+    std::sort(m_protInfo.begin(), m_protInfo.end(),
+        [](const rcx::MemoryRegion& a, const rcx::MemoryRegion& b) { return a.base < b.base; });
+}
+
+QString MinidumpProvider::readString(uint64_t rva) const
+{
+    // MINIDUMP_STRING: byte length, then UTF-16 without the terminator
+    char len[4];
+    if (!rva || !fetch(rva, len, 4)) return {};
+    uint64_t bytes = rd<uint32_t>(len) & ~1u;
+    if (bytes == 0 || bytes > kMaxNameBytes) return {};
+    QVector<char16_t> buf(static_cast<int>(bytes / 2));
+    if (!fetch(rva + 4, buf.data(), bytes)) return {};
+    return QString::fromUtf16(buf.constData(), buf.size());
+}
+
+void MinidumpProvider::buildRegions()
+{
+    // Each dumped range is readable by definition; write/exec come from
+    // MemoryInfoList when the dump has one.
+    m_regions.reserve(m_ranges.size());
+    for (const auto& r : m_ranges) {
+        rcx::MemoryRegion reg;
+        reg.base = r.va;
+        reg.size = r.size;
+        reg.prot = rcx::RP_Read;
+        auto it = std::upper_bound(m_protInfo.cbegin(), m_protInfo.cend(), r.va,
+            [](uint64_t a, const rcx::MemoryRegion& p) { return a < p.base; });
+        if (it != m_protInfo.cbegin() && r.va < (it - 1)->end())
+            reg.prot |= (it - 1)->prot;
+        auto mod = std::upper_bound(m_modules.cbegin(), m_modules.cend(), r.va,
+            [](uint64_t a, const Module& m) { return a < m.base; });
+        if (mod != m_modules.cbegin() && r.va - (mod - 1)->base < (mod - 1)->size)
+            reg.name = (mod - 1)->path;
+        m_regions.append(reg);
+    }
+}
+
+const MinidumpProvider::Range* MinidumpProvider::rangeFor(uint64_t addr) const
+{
+    auto it = std::upper_bound(m_ranges.cbegin(), m_ranges.cend(), addr,
+        [](uint64_t a, const Range& r) { return a < r.va; });
+    if (it == m_ranges.cbegin()) return nullptr;
+    --it;
+    return (addr - it->va < it->size) ? &*it : nullptr;
+}
+
+bool MinidumpProvider::read(uint64_t addr, void* buf, int len) const
+{
+    if (len <= 0) return false;
+    char* out = static_cast<char*>(buf);
+    uint64_t cur = addr;
+    uint64_t remaining = static_cast<uint64_t>(len);
+    while (remaining > 0) {
+        const Range* r = rangeFor(cur);
+        if (!r) return false;
+        uint64_t off = cur - r->va;
+        uint64_t chunk = qMin(remaining, r->size - off);
+        if (!fetch(r->rva + off, out, chunk)) return false;
+        out += chunk;
+        cur += chunk;
+        remaining -= chunk;
+    }
+    return true;
+}
+
+bool MinidumpProvider::isReadable(uint64_t addr, int len) const
+{
+    if (len <= 0) return (len == 0);
+    return rcx::regionsCover(m_regions, addr, static_cast<uint64_t>(len));
+}
+
+uint64_t MinidumpProvider::size64() const
+{
+    if (m_ranges.isEmpty()) return 0;
+    return m_ranges.last().va + m_ranges.last().size;
+}
+
+int MinidumpProvider::size() const
+{
+    return static_cast<int>(qMin<uint64_t>(size64(), INT_MAX));
+}
+
+QString MinidumpProvider::getSymbol(uint64_t addr) const
+{
+    auto it = std::upper_bound(m_modules.cbegin(), m_modules.cend(), addr,
+        [](uint64_t a, const Module& m) { return a < m.base; });
+    if (it == m_modules.cbegin()) return {};
+    --it;
+    if (addr - it->base >= it->size) return {};
+    return QStringLiteral("%1+0x%2")
+        .arg(it->name)
+        .arg(addr - it->base, 0, 16, QChar('0'));
+}
+
+uint64_t MinidumpProvider::symbolToAddress(const QString& name) const
+{
+    for (const auto& mod : m_modules) {
+        if (mod.name.compare(name, Qt::CaseInsensitive) == 0)
+            return mod.base;
+    }
+    return 0;
+}
+
+// ──────────────────────────────────────────────────────────────────────────
+// MinidumpPlugin implementation
+// ──────────────────────────────────────────────────────────────────────────
+
+QIcon MinidumpPlugin::Icon() const
+{
+    return qApp->style()->standardIcon(QStyle::SP_FileIcon);
+}
+
+bool MinidumpPlugin::canHandle(const QString& target) const
+{
+    return target.startsWith("minidump:", Qt::CaseInsensitive);
+}
+
+std::unique_ptr<rcx::Provider> MinidumpPlugin::createProvider(const QString& target, QString* errorMsg)
+{
+    QString path = target.mid(9);
+    auto provider = std::make_unique<MinidumpProvider>(path);
+    if (!provider->isValid())
+    {
+        if (errorMsg)
+            *errorMsg = QString("Failed to open minidump.\n\n"
+                               "Target: %1\n\n%2")
+                        .arg(path, provider->errorString());
+        return nullptr;
+    }
+    return provider;
+}
+
+uint64_t MinidumpPlugin::getInitialBaseAddress(const QString& target) const
+{
+    MinidumpProvider provider(target.mid(9));
+    return provider.base();
+}
+
+bool MinidumpPlugin::selectTarget(QWidget* parent, QString* target)
+{
+    QString path = QFileDialog::getOpenFileName(parent, "Open Minidump", {},
+        "Minidumps (*.dmp *.mdmp);;All files (*)");
+    if (path.isEmpty()) return false;
+    *target = QStringLiteral("minidump:") + path;
+    return true;
+}
+
+// ──────────────────────────────────────────────────────────────────────────
+// Plugin factory
+// ──────────────────────────────────────────────────────────────────────────
+
+extern "C" RCX_PLUGIN_EXPORT IPlugin* CreatePlugin()
+{
+    return new MinidumpPlugin();
+}
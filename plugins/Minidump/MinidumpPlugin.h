@@ -0,0 +1,116 @@
+#pragma once
+#include "../../src/iplugin.h"
+#include "../../src/core.h"
+
+#include <cstdint>
+#include <QFile>
+#include <QMutex>
+#include <QVector>
+
+/**
+ * Minidump (.dmp) file provider
+ *
+ * Native parser for Windows minidumps; no DbgEng, works on any host.
+ *
+ *   - The file is memory-mapped read-only and reads are a memcpy straight
+ *     out of the mapping.  Nothing is marshalled to another thread.
+ *   - Memory64ListStream (full dumps) and MemoryListStream (mini dumps) are
+ *     merged into one table of dumped ranges sorted by address, so address
+ *     translation is a binary search.
+ *   - MemoryInfoListStream, when present, supplies page protections for
+ *     regions().
+ *   - ModuleListStream supplies the module list for getSymbol() and
+ *     symbolToAddress().  The first module (the process image) is base().
+ *
+ * Target string format:
+ *   "minidump:C:/path/to/file.dmp"
+ */
+class MinidumpProvider : public rcx::Provider
+{
+public:
+    explicit MinidumpProvider(const QString& path);
+    ~MinidumpProvider() override;
+
+    MinidumpProvider(const MinidumpProvider&) = delete;
+    MinidumpProvider& operator=(const MinidumpProvider&) = delete;
+
+    // Required overrides
+    bool read(uint64_t addr, void* buf, int len) const override;
+    int size() const override;
+
+    // Optional overrides
+    uint64_t size64() const override;
+    bool isReadable(uint64_t addr, int len) const override;
+    QVector<rcx::MemoryRegion> regions() const override { return m_regions; }
+    QString name() const override { return m_name; }
+    QString kind() const override { return QStringLiteral("Minidump"); }
+    QString getSymbol(uint64_t addr) const override;
+    uint64_t symbolToAddress(const QString& name) const override;
+    uint64_t base() const override { return m_base; }
+    // Mapped dumps are plain memcpy and page faults, safe from any thread;
+    // the unmapped fallback serialises on m_fileLock anyway
+    int maxConcurrentReads() const override { return m_map ? 4 : 1; }
+
+    // Empty on success, otherwise why the file was rejected
+    QString errorString() const { return m_error; }
+
+    struct Range {
+        uint64_t va;
+        uint64_t size;
+        uint64_t rva;      // file offset of va
+    };
+    struct Module {
+        QString  name;     // file name only ("ntdll.dll")
+        QString  path;     // as recorded in the dump
+        uint64_t base;
+        uint64_t size;
+    };
+    const QVector<Range>& ranges() const { return m_ranges; }
+    const QVector<Module>& modules() const { return m_modules; }
+
+private:
+    bool parse();
+    void parseMemoryList(uint64_t rva, uint64_t size);
+    void parseMemory64List(uint64_t rva, uint64_t size);
+    void parseModuleList(uint64_t rva, uint64_t size);
+    void parseMemoryInfoList(uint64_t rva, uint64_t size);
+    void buildRegions();
+    QString readString(uint64_t rva) const;
+    bool fetch(uint64_t offset, void* buf, uint64_t len) const;
+    const Range* rangeFor(uint64_t addr) const;
+
+    mutable QFile    m_file;
+    mutable QMutex   m_fileLock;    // guards m_file seek+read when unmapped
+    const uchar*     m_map = nullptr;
+    uint64_t         m_fileSize = 0;
+    uint64_t         m_base = 0;
+    QString          m_name;
+    QString          m_error;
+
+    QVector<Range>              m_ranges;     // sorted by va, non-overlapping
+    QVector<Module>             m_modules;    // sorted by base
+    QVector<rcx::MemoryRegion>  m_regions;
+    QVector<rcx::MemoryRegion>  m_protInfo;   // MemoryInfoList, sorted by base
+};
+
+/**
+ * Plugin that provides MinidumpProvider
+ */
+class MinidumpPlugin : public IProviderPlugin
+{
+public:
+    std::string Name() const override { return "Minidump"; }
+    std::string Version() const override { return "1.0.0"; }
+    std::string Author() const override { return "Reclass"; }
+    std::string Description() const override { return "Open Windows minidump (.dmp) files on any platform"; }
+    k_ELoadType LoadType() const override { return k_ELoadTypeAuto; }
+    QIcon Icon() const override;
+
+    bool canHandle(const QString& target) const override;
+    std::unique_ptr<rcx::Provider> createProvider(const QString& target, QString* errorMsg) override;
+    uint64_t getInitialBaseAddress(const QString& target) const override;
+    bool selectTarget(QWidget* parent, QString* target) override;
+};
+
+// Plugin export
+extern "C" RCX_PLUGIN_EXPORT IPlugin* CreatePlugin();
@@ -20,12 +20,15 @@
 #include <psapi.h>
 #include <shellapi.h>
 #elif defined(__linux__)
+#include <algorithm>
 #include <climits>
 #include <sys/types.h>
 #include <dirent.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/uio.h>
+#include <sys/mman.h>
+#include <cerrno>
 #include <fstream>
 #include <sstream>
 #include <cstring>
@@ -81,21 +84,6 @@ bool ProcessMemoryProvider::write(uint64_t addr, const void* buf, int len)
     return false;
 }
 
-QString ProcessMemoryProvider::getSymbol(uint64_t addr) const
-{
-    for (const auto& mod : m_modules)
-    {
-        if (addr >= mod.base && addr < mod.base + mod.size)
-        {
-            uint64_t offset = addr - mod.base;
-            return QStringLiteral("%1+0x%2")
-                .arg(mod.name)
-                .arg(offset, 0, 16, QChar('0'));
-        }
-    }
-    return {};
-}
-
 void ProcessMemoryProvider::cacheModules()
 {
     HMODULE mods[1024];
@@ -122,6 +110,7 @@ void ProcessMemoryProvider::cacheModules()
             });
         }
     }
+    indexModules();
 }
 
 #elif defined(__linux__)
@@ -147,8 +136,10 @@ ProcessMemoryProvider::ProcessMemoryProvider(uint32_t pid, const QString& proces
         m_writable = false;
     }
 
-    if (m_fd >= 0)
+    if (m_fd >= 0) {
         cacheModules();
+        m_dirty = SoftDirtyTracker::forPid(pid);
+    }
 
 }
 
@@ -156,6 +147,10 @@ bool ProcessMemoryProvider::read(uint64_t addr, void* buf, int len) const
 {
     if (m_fd < 0 || len <= 0) return false;
 
+    if (m_vmReadvDenied.load(std::memory_order_relaxed))
+        return ::pread(m_fd, buf, static_cast<size_t>(len), static_cast<off_t>(addr))
+            == static_cast<ssize_t>(len);
+
     // Try process_vm_readv first (faster, no fd seek contention)
     struct iovec local;
     local.iov_base = buf;
@@ -174,6 +169,79 @@ bool ProcessMemoryProvider::read(uint64_t addr, void* buf, int len) const
     return nread == static_cast<ssize_t>(len);
 }
 
+void ProcessMemoryProvider::readBatch(rcx::ReadRequest* reqs, int count) const
+{
+    if (m_fd < 0) {
+        rcx::Provider::readBatch(reqs, count);
+        return;
+    }
+    if (m_vmReadvDenied.load(std::memory_order_relaxed)) {
+        readProcMem(reqs, count);
+        return;
+    }
+
+    // Pack up to IOV_MAX ranges into one process_vm_readv.  The kernel stops
+    // at the first remote range it cannot read, so the returned byte count
+    // tells us how many leading ranges completed.  The range it stopped in
+    // goes through read() (pread fallback) and the next call resumes after it.
+    struct iovec local[IOV_MAX];
+    struct iovec remote[IOV_MAX];
+    int idx[IOV_MAX];
+
+    int i = 0;
+    while (i < count) {
+        int n = 0;
+        for (int j = i; j < count && n < IOV_MAX; j++) {
+            rcx::ReadRequest& r = reqs[j];
+            r.ok = false;
+            if (r.len <= 0) continue;
+            local[n].iov_base  = r.buf;
+            local[n].iov_len   = static_cast<size_t>(r.len);
+            remote[n].iov_base = reinterpret_cast<void*>(r.addr);
+            remote[n].iov_len  = static_cast<size_t>(r.len);
+            idx[n++] = j;
+        }
+        if (n == 0) return;
+
+        ssize_t nread = process_vm_readv(m_pid, local, n, remote, n, 0);
+        if (nread < 0 && errno != EFAULT) {
+            // Syscall unavailable or denied: serve the rest from
+            // /proc/<pid>/mem, and go straight there from now on
+            m_vmReadvDenied.store(true, std::memory_order_relaxed);
+            readProcMem(reqs + i, count - i);
+            return;
+        }
+
+        size_t done = nread > 0 ? static_cast<size_t>(nread) : 0;
+        int k = 0;
+        for (; k < n && done >= local[k].iov_len; k++) {
+            reqs[idx[k]].ok = true;
+            done -= local[k].iov_len;
+        }
+        if (k == n) {
+            i = idx[n - 1] + 1;
+            continue;
+        }
+
+        rcx::ReadRequest& failed = reqs[idx[k]];
+        failed.ok = read(failed.addr, failed.buf, failed.len);
+        if (!failed.ok) memset(failed.buf, 0, failed.len);
+        i = idx[k] + 1;
+    }
+}
+
+void ProcessMemoryProvider::readProcMem(rcx::ReadRequest* reqs, int count) const
+{
+    if (m_uring.readBatch(m_fd, reqs, count))
+        return;
+    for (int i = 0; i < count; i++) {
+        rcx::ReadRequest& r = reqs[i];
+        r.ok = r.len > 0 && ::pread(m_fd, r.buf, static_cast<size_t>(r.len),
+                                    static_cast<off_t>(r.addr)) == static_cast<ssize_t>(r.len);
+        if (!r.ok && r.len > 0) memset(r.buf, 0, r.len);
+    }
+}
+
 bool ProcessMemoryProvider::write(uint64_t addr, const void* buf, int len)
 {
     if (m_fd < 0 || !m_writable || len <= 0) return false;
@@ -188,27 +256,284 @@ bool ProcessMemoryProvider::write(uint64_t addr, const void* buf, int len)
     remote.iov_len = static_cast<size_t>(len);
 
     ssize_t nwritten = process_vm_writev(m_pid, &local, 1, &remote, 1, 0);
-    if (nwritten == static_cast<ssize_t>(len))
-        return true;
+    if (nwritten != static_cast<ssize_t>(len))
+    {
+        // Fallback: pwrite on /proc/<pid>/mem
+        nwritten = ::pwrite(m_fd, buf, static_cast<size_t>(len), static_cast<off_t>(addr));
+        if (nwritten != static_cast<ssize_t>(len))
+            return false;
+    }
 
-    // Fallback: pwrite on /proc/<pid>/mem
-    nwritten = ::pwrite(m_fd, buf, static_cast<size_t>(len), static_cast<off_t>(addr));
-    return nwritten == static_cast<ssize_t>(len);
+    // Our own writes must not be mistaken for clean pages by dirtyPages()
+    if (m_dirty)
+        m_dirty->noteWritten(addr, len);
+    return true;
 }
 
-QString ProcessMemoryProvider::getSymbol(uint64_t addr) const
+bool ProcessMemoryProvider::softDirtySupported()
 {
-    for (const auto& mod : m_modules)
-    {
-        if (addr >= mod.base && addr < mod.base + mod.size)
-        {
-            uint64_t offset = addr - mod.base;
-            return QStringLiteral("%1+0x%2")
-                .arg(mod.name)
-                .arg(offset, 0, 16, QChar('0'));
+    // Kernels without CONFIG_MEM_SOFT_DIRTY accept clear_refs but never set
+    // bit 55, which would make every page look clean forever.  Probe once on
+    // a scratch page of our own: clear, check the bit is off, write, check
+    // it came on.
+    static const bool supported = [] {
+        const long pageSize = sysconf(_SC_PAGESIZE);
+        void* mem = mmap(nullptr, static_cast<size_t>(pageSize), PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED) return false;
+        volatile char* page = static_cast<volatile char*>(mem);
+        page[0] = 1;
+
+        bool ok = false;
+        int clearFd = ::open("/proc/self/clear_refs", O_WRONLY);
+        int mapFd = ::open("/proc/self/pagemap", O_RDONLY);
+        if (clearFd >= 0 && mapFd >= 0 && ::write(clearFd, "4", 1) == 1) {
+            off_t off = static_cast<off_t>(reinterpret_cast<uintptr_t>(mem) / pageSize * 8);
+            uint64_t before = 0, after = 0;
+            if (::pread(mapFd, &before, 8, off) == 8 && !((before >> 55) & 1)) {
+                page[0] = 2;
+                ok = ::pread(mapFd, &after, 8, off) == 8 && ((after >> 55) & 1);
+            }
+        }
+        if (clearFd >= 0) ::close(clearFd);
+        if (mapFd >= 0) ::close(mapFd);
+        munmap(mem, static_cast<size_t>(pageSize));
+        return ok;
+    }();
+    return supported;
+}
+
+bool ProcessMemoryProvider::dirtyPages(const uint64_t* pages, int count, bool* dirty) const
+{
+    if (m_fd < 0 || !m_dirty || !softDirtySupported()) return false;
+    return m_dirty->query(this, pages, count, dirty);
+}
+
+std::shared_ptr<SoftDirtyTracker> SoftDirtyTracker::forPid(uint32_t pid)
+{
+    static QMutex lock;
+    static QHash<uint32_t, std::weak_ptr<SoftDirtyTracker>> registry;
+    QMutexLocker guard(&lock);
+    for (auto it = registry.begin(); it != registry.end(); ) {
+        if (it.value().expired()) it = registry.erase(it);
+        else ++it;
+    }
+    if (auto existing = registry.value(pid).lock())
+        return existing;
+    auto tracker = std::make_shared<SoftDirtyTracker>(pid);
+    registry.insert(pid, tracker);
+    return tracker;
+}
+
+SoftDirtyTracker::~SoftDirtyTracker()
+{
+    if (m_pagemapFd >= 0)
+        ::close(m_pagemapFd);
+    if (m_clearRefsFd >= 0)
+        ::close(m_clearRefsFd);
+}
+
+void SoftDirtyTracker::unsubscribe(const void* who)
+{
+    QMutexLocker lock(&m_lock);
+    m_subs.remove(who);
+}
+
+void SoftDirtyTracker::noteWritten(uint64_t addr, int len)
+{
+    QMutexLocker lock(&m_lock);
+    for (auto& sub : m_subs)
+        for (uint64_t p = addr & ~0xFFFULL; p < addr + static_cast<uint64_t>(len); p += 0x1000)
+            sub.pending.insert(p);
+}
+
+// Pagemap entries for ascending page addresses, one pread per run of
+// adjacent pages
+bool SoftDirtyTracker::readEntries(const QVector<uint64_t>& pages, QVector<uint64_t>& entries)
+{
+    static const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    entries.resize(pages.size());
+    int i = 0;
+    while (i < pages.size()) {
+        uint64_t firstIdx = pages[i] / pageSize;
+        uint64_t lastIdx = firstIdx;
+        int j = i + 1;
+        for (; j < pages.size(); j++) {
+            uint64_t idx = pages[j] / pageSize;
+            if (idx != lastIdx && idx != lastIdx + 1) break;
+            lastIdx = idx;
+        }
+        QVector<uint64_t> run(static_cast<int>(lastIdx - firstIdx + 1));
+        ssize_t want = static_cast<ssize_t>(run.size()) * 8;
+        if (::pread(m_pagemapFd, run.data(), static_cast<size_t>(want),
+                    static_cast<off_t>(firstIdx * 8)) != want)
+            return false;
+        for (int k = i; k < j; k++)
+            entries[k] = run[static_cast<int>(pages[k] / pageSize - firstIdx)];
+        i = j;
+    }
+    return true;
+}
+
+bool SoftDirtyTracker::query(const void* who, const uint64_t* pages, int count, bool* dirty)
+{
+    QMutexLocker lock(&m_lock);
+    if (m_pagemapFd < 0)
+        m_pagemapFd = ::open(QStringLiteral("/proc/%1/pagemap").arg(m_pid).toUtf8().constData(), O_RDONLY);
+    if (m_clearRefsFd < 0)
+        m_clearRefsFd = ::open(QStringLiteral("/proc/%1/clear_refs").arg(m_pid).toUtf8().constData(), O_WRONLY);
+    if (m_pagemapFd < 0 || m_clearRefsFd < 0) return false;
+
+    constexpr uint64_t kSoftDirty = 1ULL << 55;
+    constexpr uint64_t kSwapped   = 1ULL << 62;
+    constexpr uint64_t kPresent   = 1ULL << 63;
+
+    // The clear below wipes the bits of every page, so read ours together
+    // with the pages the other subscribers are waiting on
+    QSet<uint64_t> wanted;
+    for (int i = 0; i < count; i++)
+        wanted.insert(pages[i] & ~0xFFFULL);
+    for (auto it = m_subs.constBegin(); it != m_subs.constEnd(); ++it)
+        if (it.key() != who)
+            wanted.unite(it.value().watched);
+    QVector<uint64_t> sorted(wanted.begin(), wanted.end());
+    std::sort(sorted.begin(), sorted.end());
+    QVector<uint64_t> entries;
+    if (!readEntries(sorted, entries)) return false;
+
+    // Re-arm.  A write landing between the pagemap read above and this
+    // clear is lost; callers are expected to do a periodic full re-read.
+    if (::write(m_clearRefsFd, "4", 1) != 1) return false;
+
+    // Not present and not swapped: discarded or never touched.  The
+    // soft-dirty bit went with the PTE, so re-read to be safe.
+    QSet<uint64_t> hot;
+    for (int i = 0; i < sorted.size(); i++) {
+        uint64_t e = entries[i];
+        if ((e & kSoftDirty) || !(e & (kPresent | kSwapped)))
+            hot.insert(sorted[i]);
+    }
+
+    for (auto it = m_subs.begin(); it != m_subs.end(); ++it) {
+        if (it.key() == who) continue;
+        Subscriber& other = it.value();
+        for (uint64_t p : other.watched)
+            if (hot.contains(p)) other.pending.insert(p);
+        other.blind = true;
+    }
+
+    // A first query has nothing to compare against, and a page left out
+    // of our last query may have lost its bit to another subscriber
+    Subscriber& me = m_subs[who];
+    for (int i = 0; i < count; i++) {
+        uint64_t p = pages[i] & ~0xFFFULL;
+        dirty[i] = !me.armed || hot.contains(p) || me.pending.contains(p)
+                || (me.blind && !me.watched.contains(p));
+    }
+    me.watched.clear();
+    for (int i = 0; i < count; i++)
+        me.watched.insert(pages[i] & ~0xFFFULL);
+    me.pending.clear();
+    me.armed = true;
+    me.blind = false;
+    return true;
+}
+
+bool ProcessMemoryProvider::isReadable(uint64_t addr, int len) const
+{
+    if (m_fd < 0 || len < 0) return false;
+    if (len == 0) return true;
+
+    QMutexLocker lock(&m_regionLock);
+    refreshRegionsLocked();
+    // No region map (maps unreadable): defer to read(), as before
+    if (m_regions.isEmpty()) return true;
+    return rcx::regionsCover(m_regions, addr, static_cast<uint64_t>(len));
+}
+
+QVector<rcx::MemoryRegion> ProcessMemoryProvider::regions() const
+{
+    QMutexLocker lock(&m_regionLock);
+    refreshRegionsLocked();
+    return m_regions;
+}
+
+static bool parseHexField(const char*& p, const char* end, uint64_t* out)
+{
+    uint64_t v = 0;
+    const char* start = p;
+    for (; p < end; ++p) {
+        char c = *p;
+        int d;
+        if (c >= '0' && c <= '9')      d = c - '0';
+        else if (c >= 'a' && c <= 'f') d = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') d = c - 'A' + 10;
+        else break;
+        v = (v << 4) | static_cast<uint64_t>(d);
+    }
+    *out = v;
+    return p > start;
+}
+
+static void skipField(const char*& p, const char* end)
+{
+    while (p < end && *p == ' ') ++p;
+    while (p < end && *p != ' ') ++p;
+}
+
+void ProcessMemoryProvider::refreshRegionsLocked() const
+{
+    if (m_regionAge.isValid() && m_regionAge.elapsed() < kRegionTtlMs)
+        return;
+    m_regionAge.start();
+
+    QByteArray path = QStringLiteral("/proc/%1/maps").arg(m_pid).toUtf8();
+    int fd = ::open(path.constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+    QByteArray raw;
+    raw.reserve(m_mapsRaw.size() + 4096);
+    char chunk[16384];
+    ssize_t n;
+    while ((n = ::read(fd, chunk, sizeof(chunk))) > 0)
+        raw.append(chunk, static_cast<int>(n));
+    ::close(fd);
+
+    // Mappings unchanged since the last parse: keep the current table
+    if (raw == m_mapsRaw) return;
+    m_mapsRaw = raw;
+
+    // Format: start-end perms offset dev inode [pathname]
+    // Lines are already sorted by start address.
+    QVector<rcx::MemoryRegion> regs;
+    const char* p = raw.constData();
+    const char* end = p + raw.size();
+    while (p < end) {
+        const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+        if (!eol) eol = end;
+
+        const char* q = p;
+        uint64_t lo = 0, hi = 0;
+        if (parseHexField(q, eol, &lo) && q < eol && *q == '-'
+            && parseHexField(++q, eol, &hi) && hi > lo && eol - q >= 5) {
+            rcx::MemoryRegion r;
+            r.base = lo;
+            r.size = hi - lo;
+            ++q;  // space before perms
+            if (q[0] == 'r') r.prot |= rcx::RP_Read;
+            if (q[1] == 'w') r.prot |= rcx::RP_Write;
+            if (q[2] == 'x') r.prot |= rcx::RP_Exec;
+            q += 4;
+            skipField(q, eol);  // offset
+            skipField(q, eol);  // dev
+            skipField(q, eol);  // inode
+            while (q < eol && *q == ' ') ++q;
+            if (q < eol)
+                r.name = QString::fromUtf8(q, static_cast<int>(eol - q));
+            regs.append(r);
         }
+        p = eol + 1;
     }
-    return {};
+    m_regions = std::move(regs);
 }
 
 void ProcessMemoryProvider::cacheModules()
@@ -277,20 +602,32 @@ void ProcessMemoryProvider::cacheModules()
         m_modules.append({
             fi.fileName(),
             it->base,
-            it->end - it->base
+            it->end - it->base,
+            it.key()
         });
     }
+    indexModules();
 }
 
 #endif // platform
 
+void ProcessMemoryProvider::indexModules()
+{
+    QVector<rcx::ModuleSymbolizer::Module> mods;
+    mods.reserve(m_modules.size());
+    for (const auto& mod : m_modules)
+        mods.append({mod.name, mod.path, mod.base, mod.size});
+    m_symbols.setModules(std::move(mods));
+}
+
+QString ProcessMemoryProvider::getSymbol(uint64_t addr) const
+{
+    return m_symbols.symbolize(addr);
+}
+
 uint64_t ProcessMemoryProvider::symbolToAddress(const QString& name) const
 {
-    for (const auto& mod : m_modules) {
-        if (mod.name.compare(name, Qt::CaseInsensitive) == 0)
-            return mod.base;
-    }
-    return 0;
+    return m_symbols.addressOf(name);
 }
 
 ProcessMemoryProvider::~ProcessMemoryProvider()
@@ -301,6 +638,8 @@ ProcessMemoryProvider::~ProcessMemoryProvider()
 #elif defined(__linux__)
     if (m_fd >= 0)
         ::close(m_fd);
+    if (m_dirty)
+        m_dirty->unsubscribe(this);
 #endif
 }
 
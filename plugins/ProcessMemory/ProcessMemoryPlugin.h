@@ -1,8 +1,65 @@
 #pragma once
 #include "../../src/iplugin.h"
 #include "../../src/core.h"
+#include "../../src/providers/elf_symbols.h"
+#ifdef __linux__
+#include "../../src/providers/uring_reader.h"
+#include <atomic>
+#include <memory>
+#endif
 
 #include <cstdint>
+#include <QHash>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QSet>
+
+#ifdef __linux__
+/**
+ * Soft-dirty tracking of one process (/proc/<pid>/pagemap bit 55 +
+ * clear_refs), shared by every provider attached to it.
+ *
+ * Writing clear_refs resets the bits of the whole process, so a provider
+ * re-arming tracking on its own would hide writes from any other tab on
+ * the same pid.  Before each clear the tracker reads the pages every other
+ * subscriber watched in its last query and keeps the dirty ones for it.
+ */
+class SoftDirtyTracker
+{
+public:
+    // The tracker for `pid`, shared for as long as someone holds it
+    static std::shared_ptr<SoftDirtyTracker> forPid(uint32_t pid);
+
+    explicit SoftDirtyTracker(uint32_t pid) : m_pid(pid) {}
+    ~SoftDirtyTracker();
+    SoftDirtyTracker(const SoftDirtyTracker&) = delete;
+    SoftDirtyTracker& operator=(const SoftDirtyTracker&) = delete;
+
+    // Provider::dirtyPages() on behalf of `who`: dirty[i] is set if the
+    // page may have been written since `who` last asked
+    bool query(const void* who, const uint64_t* pages, int count, bool* dirty);
+    void unsubscribe(const void* who);
+    // Writes through process_vm_writev or /proc/<pid>/mem may not set the
+    // soft-dirty bit; every subscriber sees these pages dirty once
+    void noteWritten(uint64_t addr, int len);
+
+private:
+    struct Subscriber {
+        QSet<uint64_t> watched;           // pages of its last query
+        QSet<uint64_t> pending;           // dirty pages seen on its behalf
+        bool           armed = false;     // has queried before
+        bool           blind = false;     // bits were cleared for pages it did not watch
+    };
+
+    bool readEntries(const QVector<uint64_t>& pages, QVector<uint64_t>& entries);
+
+    uint32_t                         m_pid;
+    QMutex                           m_lock;
+    int                              m_pagemapFd = -1;
+    int                              m_clearRefsFd = -1;
+    QHash<const void*, Subscriber>   m_subs;
+};
+#endif
 
 /**
  * Process memory provider
@@ -19,6 +76,10 @@ public:
     int size() const override;
 
     // Optional overrides
+#ifdef __linux__
+    void readBatch(rcx::ReadRequest* reqs, int count) const override;
+    bool dirtyPages(const uint64_t* pages, int count, bool* dirty) const override;
+#endif
     bool write(uint64_t addr, const void* buf, int len) override;
     bool isWritable() const override { return m_writable; }
     QString name() const override { return m_processName; }
@@ -28,13 +89,17 @@ public:
 
     bool isLive() const override { return true; }
     uint64_t base() const override { return m_base; }
-    bool isReadable(uint64_t, int len) const override {
+    // ReadProcessMemory, process_vm_readv and pread are all safe to call
+    // concurrently; pages the target has swapped out stall only their chunk
+    int maxConcurrentReads() const override { return 4; }
 #ifdef _WIN32
+    bool isReadable(uint64_t, int len) const override {
         return m_handle && len >= 0;
+    }
 #elif defined(__linux__)
-        return m_fd >= 0 && len >= 0;
+    bool isReadable(uint64_t addr, int len) const override;
+    QVector<rcx::MemoryRegion> regions() const override;
 #endif
-    }
 
     // Process-specific helpers
     uint32_t pid() const { return m_pid; }
@@ -42,6 +107,12 @@ public:
 
 private:
     void cacheModules();
+    void indexModules();
+#ifdef __linux__
+    void refreshRegionsLocked() const;
+    static bool softDirtySupported();
+    void readProcMem(rcx::ReadRequest* reqs, int count) const;
+#endif
 
 private:
 #ifdef _WIN32
@@ -58,8 +129,29 @@ private:
         QString  name;
         uint64_t base;
         uint64_t size;
+        QString  path;      // image on disk (Linux), for symbol lookup
     };
     QVector<ModuleInfo> m_modules;
+    rcx::ModuleSymbolizer m_symbols;   // interval index + ELF symbols + LRU
+
+#ifdef __linux__
+    // /proc/<pid>/maps cache.  The file is re-read at most every
+    // kRegionTtlMs and only re-parsed when its contents changed.
+    static constexpr int kRegionTtlMs = 250;
+    mutable QMutex                     m_regionLock;
+    mutable QVector<rcx::MemoryRegion> m_regions;
+    mutable QByteArray                 m_mapsRaw;
+    mutable QElapsedTimer              m_regionAge;
+
+    // Soft-dirty tracking, shared with other providers on the same pid
+    std::shared_ptr<SoftDirtyTracker>  m_dirty;
+
+    // /proc/<pid>/mem path, used once process_vm_readv has been refused
+    // (seccomp, Yama): batches go through one io_uring instead of a pread
+    // per page.
+    mutable std::atomic<bool>          m_vmReadvDenied{false};
+    mutable rcx::UringReader           m_uring;
+#endif
 };
 
 /**
@@ -0,0 +1,613 @@
+#include "RemoteMemoryPlugin.h"
+#include "RemoteProtocol.h"
+
+#include <QStyle>
+#include <QApplication>
+#include <QInputDialog>
+#include <QSettings>
+#include <QMutexLocker>
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <unistd.h>
+#endif
+
+using namespace rcx::remote;
+
+// ──────────────────────────────────────────────────────────────────────────
+// Socket helpers
+// ──────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+#ifdef _WIN32
+using SockHandle = SOCKET;
+constexpr int kShutBoth = SD_BOTH;
+void closeSocket(intptr_t s) { closesocket(static_cast<SOCKET>(s)); }
+bool ensureWinsock() {
+    static const bool ok = [] {
+        WSADATA wsa;
+        return WSAStartup(MAKEWORD(2, 2), &wsa) == 0;
+    }();
+    return ok;
+}
+#else
+using SockHandle = int;
+constexpr int kShutBoth = SHUT_RDWR;
+void closeSocket(intptr_t s) { ::close(static_cast<int>(s)); }
+bool ensureWinsock() { return true; }
+#endif
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;   // a dropped agent must not SIGPIPE us
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+bool sendAll(intptr_t s, const char* p, size_t n) {
+    while (n > 0) {
+        int chunk = static_cast<int>(qMin<size_t>(n, 1u << 30));
+        auto sent = ::send(static_cast<SockHandle>(s), p, chunk, kSendFlags);
+        if (sent <= 0) return false;
+        p += sent;
+        n -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool recvAll(intptr_t s, char* p, size_t n) {
+    while (n > 0) {
+        int chunk = static_cast<int>(qMin<size_t>(n, 1u << 30));
+        auto got = ::recv(static_cast<SockHandle>(s), p, chunk, 0);
+        if (got <= 0) return false;
+        p += got;
+        n -= static_cast<size_t>(got);
+    }
+    return true;
+}
+
+} // namespace
+
+// ──────────────────────────────────────────────────────────────────────────
+// RemoteMemoryProvider implementation
+// ──────────────────────────────────────────────────────────────────────────
+
+RemoteMemoryProvider::RemoteMemoryProvider(const QString& endpoint, const QByteArray& token)
+    : m_endpoint(endpoint)
+    , m_token(token)
+    , m_name(endpoint)
+{
+    if (!connectTo(endpoint)) {
+        m_dead = true;
+        return;
+    }
+    m_reader = std::thread([this] { readerLoop(); });
+    handshake();
+}
+
+RemoteMemoryProvider::~RemoteMemoryProvider()
+{
+    m_dead = true;
+    if (m_sock >= 0)
+        ::shutdown(static_cast<SockHandle>(m_sock), kShutBoth);   // unblocks the reader
+    if (m_reader.joinable())
+        m_reader.join();
+    if (m_sock >= 0)
+        closeSocket(m_sock);
+}
+
+bool RemoteMemoryProvider::connectTo(const QString& endpoint)
+{
+    if (!ensureWinsock()) {
+        m_error = QStringLiteral("Winsock initialisation failed");
+        return false;
+    }
+
+    if (endpoint.startsWith(QStringLiteral("tcp:"))) {
+        QString rest = endpoint.mid(4);
+        int colon = rest.lastIndexOf(':');
+        if (colon <= 0) {
+            m_error = QStringLiteral("Expected tcp:host:port");
+            return false;
+        }
+        QString host = rest.left(colon);
+        if (host.startsWith('[') && host.endsWith(']'))   // [::1]:7777
+            host = host.mid(1, host.size() - 2);
+        QByteArray hostUtf8 = host.toUtf8();
+        QByteArray portUtf8 = rest.mid(colon + 1).toUtf8();
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* res = nullptr;
+        if (getaddrinfo(hostUtf8.constData(), portUtf8.constData(), &hints, &res) != 0 || !res) {
+            m_error = QStringLiteral("Cannot resolve %1").arg(host);
+            return false;
+        }
+        for (addrinfo* ai = res; ai; ai = ai->ai_next) {
+            SockHandle s = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+#ifdef _WIN32
+            if (s == INVALID_SOCKET) continue;
+#else
+            if (s < 0) continue;
+#endif
+            if (::connect(s, ai->ai_addr, static_cast<int>(ai->ai_addrlen)) == 0) {
+                // Requests are small and pipelined; don't let Nagle hold them back
+                int one = 1;
+                setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&one), sizeof(one));
+                m_sock = static_cast<intptr_t>(s);
+                break;
+            }
+            closeSocket(static_cast<intptr_t>(s));
+        }
+        freeaddrinfo(res);
+        if (m_sock < 0)
+            m_error = QStringLiteral("Cannot connect to %1").arg(rest);
+        return m_sock >= 0;
+    }
+
+    if (endpoint.startsWith(QStringLiteral("unix:"))) {
+#ifdef _WIN32
+        m_error = QStringLiteral("Unix sockets are not supported on this platform");
+        return false;
+#else
+        QByteArray path = endpoint.mid(5).toUtf8();
+        sockaddr_un sa{};
+        sa.sun_family = AF_UNIX;
+        if (path.isEmpty() || path.size() >= static_cast<int>(sizeof(sa.sun_path))) {
+            m_error = QStringLiteral("Invalid socket path");
+            return false;
+        }
+        std::memcpy(sa.sun_path, path.constData(), static_cast<size_t>(path.size()));
+        int s = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (s < 0) {
+            m_error = QStringLiteral("socket() failed");
+            return false;
+        }
+        if (::connect(s, reinterpret_cast<sockaddr*>(&sa), sizeof(sa)) != 0) {
+            ::close(s);
+            m_error = QStringLiteral("Cannot connect to %1").arg(QString::fromUtf8(path));
+            return false;
+        }
+        m_sock = s;
+        return true;
+#endif
+    }
+
+    m_error = QStringLiteral("Unknown endpoint '%1' (expected tcp:host:port or unix:/path)").arg(endpoint);
+    return false;
+}
+
+bool RemoteMemoryProvider::handshake()
+{
+    QByteArray req;
+    put(req, kProtocolVersion);
+    put(req, static_cast<uint32_t>(CAP_Zlib));
+    if (!m_token.isEmpty()) {
+        QByteArray token = m_token.left(static_cast<int>(kMaxTokenLen));
+        put(req, static_cast<uint16_t>(token.size()));
+        req.append(token);
+    }
+
+    QByteArray resp;
+    if (!call(OP_Hello, req, &resp)) {
+        if (resp.isEmpty()) {
+            fail(QStringLiteral("Agent handshake failed"));
+            return false;
+        }
+        // The agent's reason ("authentication failed"), which must win over
+        // the reader noticing the agent hang up right after it
+        {
+            QMutexLocker lock(&m_lock);
+            m_error = QStringLiteral("Agent refused the connection: %1").arg(QString::fromUtf8(resp));
+        }
+        fail(QString());
+        return false;
+    }
+
+    const char* p = resp.constData();
+    const char* end = p + resp.size();
+    uint32_t version = 0, caps = 0, pid = 0, reserved = 0;
+    uint64_t base = 0;
+    uint16_t nameLen = 0;
+    if (!take(p, end, &version) || !take(p, end, &caps) || !take(p, end, &pid)
+        || !take(p, end, &reserved) || !take(p, end, &base) || !take(p, end, &nameLen)
+        || end - p < nameLen) {
+        fail(QStringLiteral("Agent handshake failed"));
+        return false;
+    }
+    if (version != kProtocolVersion) {
+        fail(QStringLiteral("Agent speaks protocol version %1, expected %2")
+                 .arg(version).arg(kProtocolVersion));
+        return false;
+    }
+
+    m_caps = caps;
+    m_pid = pid;
+    m_base = base;
+    m_writable = (caps & CAP_Write) != 0;
+    QString procName = QString::fromUtf8(p, nameLen);
+    if (procName.isEmpty()) procName = QStringLiteral("PID %1").arg(pid);
+    m_name = QStringLiteral("%1@%2").arg(procName, m_endpoint);
+    return true;
+}
+
+void RemoteMemoryProvider::readerLoop()
+{
+    for (;;) {
+        MsgHeader h;
+        if (!recvAll(m_sock, reinterpret_cast<char*>(&h), sizeof(h))) break;
+        if (h.length > kMaxPayload) {
+            fail(QStringLiteral("Agent sent an oversized message"));
+            return;
+        }
+        QByteArray payload(static_cast<int>(h.length), Qt::Uninitialized);
+        if (h.length > 0 && !recvAll(m_sock, payload.data(), h.length)) break;
+        m_bytesReceived += sizeof(h) + h.length;
+
+        QMutexLocker lock(&m_lock);
+        auto it = m_pending.find(h.id);
+        if (it == m_pending.end()) continue;   // caller timed out and left
+        PendingPtr req = it.value();
+        m_pending.erase(it);
+        req->payload = std::move(payload);
+        req->flags = h.flags;
+        req->done = true;
+        m_arrived.wakeAll();
+    }
+    fail(m_dead ? QString() : QStringLiteral("Connection closed by agent"));
+}
+
+void RemoteMemoryProvider::fail(const QString& why) const
+{
+    QMutexLocker lock(&m_lock);
+    if (m_error.isEmpty() && !why.isEmpty())
+        m_error = why;
+    m_dead = true;
+    for (auto& req : m_pending) {
+        req->failed = true;
+        req->done = true;
+    }
+    m_pending.clear();
+    m_arrived.wakeAll();
+}
+
+QString RemoteMemoryProvider::errorString() const
+{
+    QMutexLocker lock(&m_lock);
+    return m_error;
+}
+
+RemoteMemoryProvider::PendingPtr RemoteMemoryProvider::send(uint8_t op, const QByteArray& payload) const
+{
+    if (m_sock < 0 || m_dead) return nullptr;
+
+    auto req = std::make_shared<Pending>();
+    req->id = m_nextId++;
+    if (req->id == 0) req->id = m_nextId++;   // 0 is never a valid id
+    {
+        // Registered before it hits the wire: the answer can beat us back
+        QMutexLocker lock(&m_lock);
+        m_pending.insert(req->id, req);
+    }
+
+    MsgHeader h;
+    h.length = static_cast<uint32_t>(payload.size());
+    h.id = req->id;
+    h.op = op;
+    bool ok;
+    {
+        QMutexLocker lock(&m_sendLock);
+        ok = sendAll(m_sock, reinterpret_cast<const char*>(&h), sizeof(h))
+          && sendAll(m_sock, payload.constData(), static_cast<size_t>(payload.size()));
+    }
+    if (!ok) {
+        fail(QStringLiteral("Send to agent failed"));
+        return nullptr;
+    }
+    m_requestsSent++;
+    return req;
+}
+
+bool RemoteMemoryProvider::wait(const PendingPtr& req, QByteArray* payload) const
+{
+    if (!req) return false;
+    QMutexLocker lock(&m_lock);
+    QElapsedTimer timer;
+    timer.start();
+    while (!req->done) {
+        qint64 left = kTimeoutMs - timer.elapsed();
+        if (left <= 0) {
+            m_pending.remove(req->id);
+            return false;
+        }
+        m_arrived.wait(&m_lock, static_cast<unsigned long>(left));
+    }
+    if (req->failed) return false;
+    *payload = std::move(req->payload);   // the message, on RF_Error
+    return !(req->flags & RF_Error);
+}
+
+bool RemoteMemoryProvider::call(uint8_t op, const QByteArray& payload, QByteArray* response) const
+{
+    return wait(send(op, payload), response);
+}
+
+bool RemoteMemoryProvider::read(uint64_t addr, void* buf, int len) const
+{
+    if (len <= 0) return false;
+    rcx::ReadRequest r;
+    r.addr = addr;
+    r.buf = buf;
+    r.len = len;
+    readBatch(&r, 1);
+    return r.ok;
+}
+
+void RemoteMemoryProvider::readBatch(rcx::ReadRequest* reqs, int count) const
+{
+    // Send every message first, then collect: the agent starts answering
+    // the first while the rest are still in flight.
+    struct Message {
+        PendingPtr   req;
+        QVector<int> indices;
+    };
+    QVector<Message> messages;
+
+    int i = 0;
+    while (i < count) {
+        Message msg;
+        QByteArray payload;
+        put(payload, uint32_t(0));   // count, patched below
+        qint64 bytes = 0;
+        for (; i < count && msg.indices.size() < kMaxRangesPerMsg; i++) {
+            rcx::ReadRequest& r = reqs[i];
+            r.ok = false;
+            if (r.len <= 0) continue;
+            if (static_cast<uint32_t>(r.len) > kMaxRangeLen) {
+                std::memset(r.buf, 0, static_cast<size_t>(r.len));
+                continue;
+            }
+            if (!msg.indices.isEmpty() && bytes + r.len > kMaxBytesPerMsg) break;
+            put(payload, r.addr);
+            put(payload, static_cast<uint32_t>(r.len));
+            msg.indices.append(i);
+            bytes += r.len;
+        }
+        if (msg.indices.isEmpty()) continue;
+        uint32_t n = static_cast<uint32_t>(msg.indices.size());
+        std::memcpy(payload.data(), &n, sizeof(n));
+        msg.req = send(OP_Read, payload);
+        messages.append(std::move(msg));
+    }
+
+    for (const Message& msg : messages) {
+        QByteArray resp;
+        bool good = wait(msg.req, &resp);
+        const char* p = resp.constData();
+        const char* end = p + resp.size();
+        for (int idx : msg.indices) {
+            rcx::ReadRequest& r = reqs[idx];
+            uint8_t status = RS_Fail;
+            if (good && !take(p, end, &status))
+                good = false;
+            if (good) {
+                switch (status) {
+                case RS_Raw:
+                    if (end - p < r.len) { good = false; break; }
+                    std::memcpy(r.buf, p, static_cast<size_t>(r.len));
+                    p += r.len;
+                    r.ok = true;
+                    break;
+                case RS_Zero:
+                    std::memset(r.buf, 0, static_cast<size_t>(r.len));
+                    r.ok = true;
+                    break;
+                case RS_Zlib: {
+                    uint32_t clen = 0;
+                    if (!take(p, end, &clen) || end - p < static_cast<qint64>(clen)) { good = false; break; }
+                    QByteArray plain = qUncompress(reinterpret_cast<const uchar*>(p), static_cast<int>(clen));
+                    p += clen;
+                    if (plain.size() == r.len) {
+                        std::memcpy(r.buf, plain.constData(), static_cast<size_t>(r.len));
+                        r.ok = true;
+                    }
+                    break;
+                }
+                default:
+                    break;
+                }
+            }
+            if (!r.ok)
+                std::memset(r.buf, 0, static_cast<size_t>(r.len));
+        }
+    }
+}
+
+bool RemoteMemoryProvider::write(uint64_t addr, const void* buf, int len)
+{
+    if (!m_writable || len <= 0 || static_cast<uint32_t>(len) > kMaxRangeLen) return false;
+    QByteArray req;
+    put(req, addr);
+    req.append(static_cast<const char*>(buf), len);
+    QByteArray resp;
+    return call(OP_Write, req, &resp) && !resp.isEmpty() && resp[0] != 0;
+}
+
+int RemoteMemoryProvider::size() const
+{
+    return isConnected() ? 0x10000 : 0;
+}
+
+bool RemoteMemoryProvider::isReadable(uint64_t addr, int len) const
+{
+    if (!isConnected() || len < 0) return false;
+    if (len == 0) return true;
+
+    QMutexLocker lock(&m_regionLock);
+    refreshRegionsLocked();
+    // Agent without a region map: defer to read()
+    if (m_regions.isEmpty()) return true;
+    return rcx::regionsCover(m_regions, addr, static_cast<uint64_t>(len));
+}
+
+QVector<rcx::MemoryRegion> RemoteMemoryProvider::regions() const
+{
+    QMutexLocker lock(&m_regionLock);
+    refreshRegionsLocked();
+    return m_regions;
+}
+
+void RemoteMemoryProvider::refreshRegionsLocked() const
+{
+    if (m_regionAge.isValid() && m_regionAge.elapsed() < kRegionTtlMs)
+        return;
+    m_regionAge.start();
+
+    QByteArray resp;
+    if (!call(OP_Regions, {}, &resp)) return;
+
+    const char* p = resp.constData();
+    const char* end = p + resp.size();
+    uint32_t count = 0;
+    if (!take(p, end, &count)) return;
+
+    QVector<rcx::MemoryRegion> regs;
+    regs.reserve(static_cast<int>(qMin<uint32_t>(count, 1u << 16)));
+    for (uint32_t i = 0; i < count; i++) {
+        rcx::MemoryRegion r;
+        uint16_t nameLen = 0;
+        if (!take(p, end, &r.base) || !take(p, end, &r.size) || !take(p, end, &r.prot)
+            || !take(p, end, &nameLen) || end - p < nameLen)
+            return;
+        r.name = QString::fromUtf8(p, nameLen);
+        p += nameLen;
+        regs.append(r);
+    }
+    m_regions = std::move(regs);
+
+    // Modules: consecutive mappings of the same file, like /proc/<pid>/maps
+    m_modules.clear();
+    for (const auto& r : m_regions) {
+        if (r.name.isEmpty() || r.name.startsWith('[')) continue;
+        if (!m_modules.isEmpty()) {
+            ModuleInfo& last = m_modules.last();
+            int slash = r.name.lastIndexOf('/');
+            if (last.name == r.name.mid(slash + 1) && r.base >= last.base) {
+                last.size = r.end() - last.base;
+                continue;
+            }
+        }
+        m_modules.append({r.name.mid(r.name.lastIndexOf('/') + 1), r.base, r.size});
+    }
+}
+
+QString RemoteMemoryProvider::getSymbol(uint64_t addr) const
+{
+    QMutexLocker lock(&m_regionLock);
+    refreshRegionsLocked();
+    for (const auto& mod : m_modules) {
+        if (addr >= mod.base && addr < mod.base + mod.size) {
+            return QStringLiteral("%1+0x%2")
+                .arg(mod.name)
+                .arg(addr - mod.base, 0, 16, QChar('0'));
+        }
+    }
+    return {};
+}
+
+uint64_t RemoteMemoryProvider::symbolToAddress(const QString& name) const
+{
+    QMutexLocker lock(&m_regionLock);
+    refreshRegionsLocked();
+    for (const auto& mod : m_modules) {
+        if (mod.name.compare(name, Qt::CaseInsensitive) == 0)
+            return mod.base;
+    }
+    return 0;
+}
+
+// ──────────────────────────────────────────────────────────────────────────
+// RemoteMemoryPlugin implementation
+// ──────────────────────────────────────────────────────────────────────────
+
+QIcon RemoteMemoryPlugin::Icon() const
+{
+    return qApp->style()->standardIcon(QStyle::SP_DriveNetIcon);
+}
+
+bool RemoteMemoryPlugin::canHandle(const QString& target) const
+{
+    return target.startsWith(QStringLiteral("remote:"));
+}
+
+std::unique_ptr<rcx::Provider> RemoteMemoryPlugin::createProvider(const QString& target, QString* errorMsg)
+{
+    if (!canHandle(target)) {
+        if (errorMsg) *errorMsg = QStringLiteral("Invalid target: ") + target;
+        return nullptr;
+    }
+    QString endpoint = target.mid(7);
+    auto provider = std::make_unique<RemoteMemoryProvider>(endpoint, agentToken());
+    if (!provider->isConnected()) {
+        if (errorMsg)
+            *errorMsg = QStringLiteral("Failed to connect to agent at %1\n%2")
+                            .arg(endpoint, provider->errorString());
+        return nullptr;
+    }
+    return provider;
+}
+
+uint64_t RemoteMemoryPlugin::getInitialBaseAddress(const QString& target) const
+{
+    if (!canHandle(target)) return 0;
+    RemoteMemoryProvider provider(target.mid(7), agentToken());
+    return provider.isConnected() ? provider.base() : 0;
+}
+
+bool RemoteMemoryPlugin::selectTarget(QWidget* parent, QString* target)
+{
+    QSettings settings("Reclass", "Reclass");
+    QString last = settings.value("remoteAgentEndpoint", "tcp:127.0.0.1:7777").toString();
+    bool ok = false;
+    QString endpoint = QInputDialog::getText(parent, "Connect to Remote Agent",
+        "Agent address (tcp:host:port or unix:/path/to/socket):",
+        QLineEdit::Normal, last, &ok).trimmed();
+    if (!ok || endpoint.isEmpty()) return false;
+    QString token = settings.value("remoteAgentToken").toString();
+    if (qEnvironmentVariableIsEmpty("RCX_AGENT_TOKEN")) {
+        token = QInputDialog::getText(parent, "Connect to Remote Agent",
+            "Agent token (printed by rcx-agent; empty for a Unix socket):",
+            QLineEdit::Password, token, &ok).trimmed();
+        if (!ok) return false;
+    }
+    settings.setValue("remoteAgentEndpoint", endpoint);
+    settings.setValue("remoteAgentToken", token);
+    *target = QStringLiteral("remote:") + endpoint;
+    return true;
+}
+
+QByteArray RemoteMemoryPlugin::agentToken()
+{
+    QByteArray env = qgetenv("RCX_AGENT_TOKEN");
+    if (!env.isEmpty()) return env;
+    return QSettings("Reclass", "Reclass").value("remoteAgentToken").toString().toUtf8();
+}
+
+// ──────────────────────────────────────────────────────────────────────────
+// Plugin factory
+// ──────────────────────────────────────────────────────────────────────────
+
+extern "C" RCX_PLUGIN_EXPORT IPlugin* CreatePlugin()
+{
+    return new RemoteMemoryPlugin();
+}
@@ -0,0 +1,165 @@
+#pragma once
+#include "../../src/iplugin.h"
+#include "../../src/core.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+#include <QWaitCondition>
+
+/**
+ * Remote memory provider
+ *
+ * Reads a process on another machine or in a container through a small
+ * agent (see agent/ and RemoteProtocol.h for the wire format).
+ *
+ *   - One socket per provider, TCP or Unix domain.
+ *   - Requests are pipelined.  readBatch() splits a refresh into Read
+ *     messages of bounded size, sends all of them, and only then waits, so
+ *     a refresh costs about one round trip however many pages it spans.
+ *   - A reader thread matches responses to waiting callers by request id,
+ *     so any number of threads can have requests in flight at once.
+ *   - Page payloads come back zlib-compressed when that is smaller, and
+ *     all-zero ranges are sent as a status byte.
+ *
+ * Target string format:
+ *   "remote:tcp:host:port"
+ *   "remote:unix:/path/to/agent.sock"      (not on Windows)
+ *
+ * The agent's token is not part of the target (targets are saved with the
+ * project); it comes from RCX_AGENT_TOKEN or the one entered in
+ * selectTarget().
+ */
+class RemoteMemoryProvider : public rcx::Provider
+{
+public:
+    // token: sent in Hello; agents listening on TCP require it
+    explicit RemoteMemoryProvider(const QString& endpoint, const QByteArray& token = {});
+    ~RemoteMemoryProvider() override;
+
+    RemoteMemoryProvider(const RemoteMemoryProvider&) = delete;
+    RemoteMemoryProvider& operator=(const RemoteMemoryProvider&) = delete;
+
+    // Required overrides
+    bool read(uint64_t addr, void* buf, int len) const override;
+    int size() const override;
+
+    // Optional overrides
+    void readBatch(rcx::ReadRequest* reqs, int count) const override;
+    bool write(uint64_t addr, const void* buf, int len) override;
+    bool isWritable() const override { return m_writable; }
+    bool isReadable(uint64_t addr, int len) const override;
+    QVector<rcx::MemoryRegion> regions() const override;
+    QString name() const override { return m_name; }
+    QString kind() const override { return QStringLiteral("Remote"); }
+    QString getSymbol(uint64_t addr) const override;
+    uint64_t symbolToAddress(const QString& name) const override;
+    bool isLive() const override { return true; }
+    uint64_t base() const override { return m_base; }
+    // Requests are matched to replies by id, so several batches can be in
+    // flight on the one connection
+    int maxConcurrentReads() const override { return 4; }
+
+    // Empty while connected, otherwise why the connection failed or dropped
+    QString errorString() const;
+    bool isConnected() const { return m_sock >= 0 && !m_dead.load(); }
+    uint32_t remotePid() const { return m_pid; }
+
+    // Wire statistics, for tuning and tests
+    uint64_t requestsSent() const { return m_requestsSent.load(); }
+    uint64_t bytesReceived() const { return m_bytesReceived.load(); }
+
+    // Responses slower than this fail the request (but keep the connection)
+    static constexpr int kTimeoutMs = 5000;
+    // Per Read message; larger batches are split and pipelined
+    static constexpr int kMaxRangesPerMsg = 256;
+    static constexpr int kMaxBytesPerMsg  = 1 << 20;
+
+private:
+    struct Pending {
+        uint32_t   id = 0;
+        QByteArray payload;
+        uint8_t    flags = 0;
+        bool       done  = false;
+        bool       failed = false;
+    };
+    using PendingPtr = std::shared_ptr<Pending>;
+
+    bool connectTo(const QString& endpoint);
+    bool handshake();
+    void readerLoop();
+    void fail(const QString& why) const;
+
+    // Register a request and put it on the wire; null on failure
+    PendingPtr send(uint8_t op, const QByteArray& payload) const;
+    // Block until the response arrives; false on error or timeout
+    bool wait(const PendingPtr& req, QByteArray* payload) const;
+    bool call(uint8_t op, const QByteArray& payload, QByteArray* response) const;
+
+    void refreshRegionsLocked() const;
+
+    intptr_t           m_sock = -1;
+    std::thread        m_reader;
+    mutable std::atomic<bool> m_dead{false};
+
+    mutable QMutex                            m_sendLock;
+    mutable QMutex                            m_lock;        // guards m_pending, m_error
+    mutable QWaitCondition                    m_arrived;
+    mutable QHash<uint32_t, PendingPtr>       m_pending;
+    mutable std::atomic<uint32_t>             m_nextId{1};
+    mutable std::atomic<uint64_t>             m_requestsSent{0};
+    mutable std::atomic<uint64_t>             m_bytesReceived{0};
+    mutable QString                           m_error;
+
+    QString    m_endpoint;
+    QByteArray m_token;
+    QString    m_name;
+    uint32_t   m_pid = 0;
+    uint32_t   m_caps = 0;
+    uint64_t   m_base = 0;
+    bool       m_writable = false;
+
+    struct ModuleInfo {
+        QString  name;
+        uint64_t base;
+        uint64_t size;
+    };
+
+    // Region map cache, re-fetched at most every kRegionTtlMs
+    static constexpr int kRegionTtlMs = 1000;
+    mutable QMutex                     m_regionLock;
+    mutable QVector<rcx::MemoryRegion> m_regions;
+    mutable QVector<ModuleInfo>        m_modules;
+    mutable QElapsedTimer              m_regionAge;
+};
+
+/**
+ * Plugin that provides RemoteMemoryProvider
+ */
+class RemoteMemoryPlugin : public IProviderPlugin
+{
+public:
+    std::string Name() const override { return "Remote Memory"; }
+    std::string Version() const override { return "1.0.0"; }
+    std::string Author() const override { return "Reclass"; }
+    std::string Description() const override { return "Read process memory on another host through rcx-agent"; }
+    k_ELoadType LoadType() const override { return k_ELoadTypeAuto; }
+    QIcon Icon() const override;
+
+    bool canHandle(const QString& target) const override;
+    std::unique_ptr<rcx::Provider> createProvider(const QString& target, QString* errorMsg) override;
+    uint64_t getInitialBaseAddress(const QString& target) const override;
+    bool selectTarget(QWidget* parent, QString* target) override;
+
+    // RCX_AGENT_TOKEN, else the token last entered in selectTarget()
+    static QByteArray agentToken();
+};
+
+// Plugin export
+extern "C" RCX_PLUGIN_EXPORT IPlugin* CreatePlugin();
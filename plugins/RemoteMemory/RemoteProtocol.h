@@ -0,0 +1,118 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// ──────────────────────────────────────────────────────────────────────────
+// Reclass remote memory protocol, version 1
+//
+// Shared by RemoteMemoryProvider and the reference agent (rcx-agent), so it
+// depends on nothing but the standard library.
+//
+// Every message in either direction is a 12-byte MsgHeader followed by
+// `length` payload bytes.  All integers are little-endian.
+//
+// Requests are pipelined: a client may send many requests before reading
+// any response.  The agent answers each request exactly once; the client
+// matches responses to requests by id, so answers may arrive in any order
+// (the reference agent answers in order).
+//
+//   Hello    req   u32 version, u32 caps [, u16 tokenLen, token]
+//            resp  u32 version, u32 caps, u32 pid, u32 reserved, u64 base,
+//                  u16 nameLen, name (UTF-8)
+//   Read     req   u32 count, count x { u64 addr, u32 len }
+//            resp  count x { u8 status, body }
+//                    RS_Fail   no body   (range unreadable)
+//                    RS_Raw    len bytes
+//                    RS_Zero   no body   (range is all zero bytes)
+//                    RS_Zlib   u32 clen, clen bytes: u32 big-endian len +
+//                              zlib stream (the qCompress() layout)
+//   Write    req   u64 addr, data
+//            resp  u8 ok
+//   Regions  req   empty
+//            resp  u32 count, count x { u64 base, u64 size, u32 prot,
+//                  u16 nameLen, name (UTF-8) }
+//
+// A response with RF_Error set carries a UTF-8 message instead of its body.
+// Caps are negotiated in Hello: the agent only sends RS_Zlib to clients
+// that offered CAP_Zlib.
+//
+// Hello must come first.  An agent configured with a token refuses any
+// other request until a Hello carrying that token, and drops the
+// connection on a wrong one.
+// ──────────────────────────────────────────────────────────────────────────
+
+namespace rcx {
+namespace remote {
+
+constexpr uint32_t kProtocolVersion = 1;
+constexpr uint32_t kMaxPayload      = 64u << 20;   // either direction
+constexpr uint32_t kMaxRangeLen     = 16u << 20;
+constexpr uint32_t kMaxReadRanges   = 4096;
+constexpr uint32_t kMinCompressLen  = 256;         // smaller ranges go raw
+constexpr uint32_t kMaxTokenLen     = 256;
+
+enum Op : uint8_t {
+    OP_Hello   = 1,
+    OP_Read    = 2,
+    OP_Write   = 3,
+    OP_Regions = 4,
+};
+
+enum Caps : uint32_t {
+    CAP_Zlib  = 1u << 0,
+    CAP_Write = 1u << 1,
+};
+
+enum ResponseFlags : uint8_t {
+    RF_Error = 1u << 0,
+};
+
+enum ReadStatus : uint8_t {
+    RS_Fail = 0,
+    RS_Raw  = 1,
+    RS_Zero = 2,
+    RS_Zlib = 3,
+};
+
+// Matches rcx::RegionProt
+enum RegionProtBits : uint32_t {
+    RPB_Read  = 1u << 0,
+    RPB_Write = 1u << 1,
+    RPB_Exec  = 1u << 2,
+};
+
+#pragma pack(push, 1)
+struct MsgHeader {
+    uint32_t length   = 0;   // payload bytes after the header
+    uint32_t id       = 0;
+    uint8_t  op       = 0;
+    uint8_t  flags    = 0;
+    uint16_t reserved = 0;
+};
+#pragma pack(pop)
+static_assert(sizeof(MsgHeader) == 12, "wire header is 12 bytes");
+
+// Append a little-endian scalar to a QByteArray or std::string
+template<typename Buf, typename T>
+inline void put(Buf& out, T v) {
+    out.append(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+// Consume a scalar from [p, end); false if the payload is truncated
+template<typename T>
+inline bool take(const char*& p, const char* end, T* v) {
+    if (end - p < static_cast<std::ptrdiff_t>(sizeof(T))) return false;
+    std::memcpy(v, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+}
+
+inline bool isAllZero(const char* p, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        if (p[i]) return false;
+    return true;
+}
+
+} // namespace remote
+} // namespace rcx
@@ -0,0 +1,143 @@
+// rcx-agent: serve one process's memory to Reclass over the network.
+//
+//   rcx-agent --pid 1234 [--listen tcp:127.0.0.1:7777 | --listen unix:/run/rcx.sock]
+//             [--token-file PATH] [--allow-write] [--no-compress]
+//
+// Listens on localhost by default and serves reads only; --allow-write
+// lets clients patch the target, code pages included.  Connect from
+// Reclass with the Remote Memory source ("remote:<address>").
+//
+// TCP clients must present a token.  It is read from --token-file or
+// RCX_AGENT_TOKEN (not a flag: arguments are visible to every user); with
+// neither, a loopback listener makes one up and prints it.  Listening on
+// any other address needs a configured token.  Unix socket clients must
+// run as the agent's user.
+
+#include "rcx_agent.h"
+#include "../RemoteProtocol.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+// Each connection is served on its own thread; more are closed on accept
+static constexpr int kMaxConnections = 16;
+
+static void usage(const char* argv0) {
+    std::fprintf(stderr,
+        "usage: %s --pid PID [--listen tcp:HOST:PORT|unix:PATH] [--token-file PATH]\n"
+        "          [--allow-write] [--no-compress]\n",
+        argv0);
+}
+
+// First line of path, or "" if it cannot be read
+static std::string readToken(const char* path) {
+    std::string token;
+    if (FILE* f = std::fopen(path, "r")) {
+        int c;
+        while ((c = std::fgetc(f)) != EOF && c != '\n' && c != '\r')
+            token += static_cast<char>(c);
+        std::fclose(f);
+    }
+    return token;
+}
+
+// 32 hex digits from /dev/urandom, or "" if it cannot be read
+static std::string randomToken() {
+    unsigned char raw[16];
+    int fd = ::open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return {};
+    bool ok = ::read(fd, raw, sizeof(raw)) == static_cast<ssize_t>(sizeof(raw));
+    ::close(fd);
+    if (!ok) return {};
+    std::string token;
+    char hex[3];
+    for (unsigned char b : raw) {
+        std::snprintf(hex, sizeof(hex), "%02x", b);
+        token += hex;
+    }
+    return token;
+}
+
+int main(int argc, char** argv) {
+    int pid = 0;
+    std::string endpoint = "tcp:127.0.0.1:7777";
+    rcx::remote::AgentOptions opts;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--pid") && i + 1 < argc)          pid = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--listen") && i + 1 < argc)  endpoint = argv[++i];
+        else if (!std::strcmp(argv[i], "--token-file") && i + 1 < argc) {
+            opts.token = readToken(argv[++i]);
+            if (opts.token.empty()) {
+                std::fprintf(stderr, "rcx-agent: no token in %s\n", argv[i]);
+                return 2;
+            }
+        }
+        else if (!std::strcmp(argv[i], "--allow-write"))             opts.allowWrite = true;
+        else if (!std::strcmp(argv[i], "--no-compress"))             opts.zlibLevel = 0;
+        else { usage(argv[0]); return 2; }
+    }
+    if (pid <= 0) { usage(argv[0]); return 2; }
+    if (opts.token.empty())
+        if (const char* env = std::getenv("RCX_AGENT_TOKEN")) opts.token = env;
+    if (opts.token.size() > rcx::remote::kMaxTokenLen) {
+        std::fprintf(stderr, "rcx-agent: token longer than %u bytes\n", rcx::remote::kMaxTokenLen);
+        return 2;
+    }
+
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::string error;
+    int listenFd = rcx::remote::listenOn(endpoint, &error);
+    if (listenFd < 0) {
+        std::fprintf(stderr, "rcx-agent: %s\n", error.c_str());
+        return 1;
+    }
+    bool isTcp = endpoint.compare(0, 4, "tcp:") == 0;
+    if (!rcx::remote::isLocalListener(listenFd) && opts.token.empty()) {
+        std::fprintf(stderr, "rcx-agent: refusing to listen on %s without a token "
+                             "(--token-file or RCX_AGENT_TOKEN)\n", endpoint.c_str());
+        return 1;
+    }
+    if (isTcp && opts.token.empty()) {
+        opts.token = randomToken();
+        if (opts.token.empty()) {
+            std::fprintf(stderr, "rcx-agent: cannot generate a token\n");
+            return 1;
+        }
+        std::fprintf(stderr, "rcx-agent: token %s\n", opts.token.c_str());
+    }
+    std::fprintf(stderr, "rcx-agent: serving pid %d on %s (%s)\n", pid, endpoint.c_str(),
+                 opts.allowWrite ? "read-write" : "read-only");
+
+    static std::atomic<int> active{0};
+    for (;;) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            // Out of descriptors or buffers: retrying at once would spin,
+            // so give open connections a moment to finish
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+        if (active.load() >= kMaxConnections) {
+            ::close(fd);
+            continue;
+        }
+        active++;
+        std::thread([fd, pid, opts] {
+            rcx::remote::serveConnection(fd, pid, opts);
+            active--;
+        }).detach();
+    }
+}
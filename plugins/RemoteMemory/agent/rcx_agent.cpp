@@ -0,0 +1,460 @@
+#include "rcx_agent.h"
+#include "../RemoteProtocol.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <arpa/inet.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+#ifdef RCX_AGENT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace rcx {
+namespace remote {
+
+namespace {
+
+// ── Socket I/O ──
+
+bool sendAll(int fd, const void* buf, size_t n) {
+    const char* p = static_cast<const char*>(buf);
+    while (n > 0) {
+        ssize_t sent = ::send(fd, p, n, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        p += sent;
+        n -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool recvAll(int fd, void* buf, size_t n) {
+    char* p = static_cast<char*>(buf);
+    while (n > 0) {
+        ssize_t got = ::recv(fd, p, n, 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        p += got;
+        n -= static_cast<size_t>(got);
+    }
+    return true;
+}
+
+bool reply(int fd, const MsgHeader& req, const std::string& body, uint8_t flags = 0) {
+    MsgHeader h;
+    h.length = static_cast<uint32_t>(body.size());
+    h.id = req.id;
+    h.op = req.op;
+    h.flags = flags;
+    return sendAll(fd, &h, sizeof(h)) && sendAll(fd, body.data(), body.size());
+}
+
+bool replyError(int fd, const MsgHeader& req, const char* message) {
+    return reply(fd, req, message, RF_Error);
+}
+
+// ── /proc helpers ──
+
+struct MapEntry {
+    uint64_t    lo = 0, hi = 0;
+    uint32_t    prot = 0;
+    std::string name;
+};
+
+std::string readFile(const std::string& path) {
+    std::string out;
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return out;
+    char chunk[16384];
+    ssize_t n;
+    while ((n = ::read(fd, chunk, sizeof(chunk))) > 0)
+        out.append(chunk, static_cast<size_t>(n));
+    ::close(fd);
+    return out;
+}
+
+// Format: start-end perms offset dev inode [pathname]
+std::vector<MapEntry> readMaps(int pid) {
+    std::vector<MapEntry> maps;
+    std::string raw = readFile("/proc/" + std::to_string(pid) + "/maps");
+    size_t pos = 0;
+    while (pos < raw.size()) {
+        size_t eol = raw.find('\n', pos);
+        if (eol == std::string::npos) eol = raw.size();
+        std::string line = raw.substr(pos, eol - pos);
+        pos = eol + 1;
+
+        MapEntry e;
+        char perms[5] = {};
+        int nameAt = 0;
+        unsigned long long lo = 0, hi = 0;
+        if (std::sscanf(line.c_str(), "%llx-%llx %4s %*s %*s %*s %n", &lo, &hi, perms, &nameAt) < 3)
+            continue;
+        e.lo = lo;
+        e.hi = hi;
+        if (perms[0] == 'r') e.prot |= RPB_Read;
+        if (perms[1] == 'w') e.prot |= RPB_Write;
+        if (perms[2] == 'x') e.prot |= RPB_Exec;
+        if (nameAt > 0 && static_cast<size_t>(nameAt) < line.size())
+            e.name = line.substr(static_cast<size_t>(nameAt));
+        if (e.hi > e.lo) maps.push_back(std::move(e));
+    }
+    return maps;
+}
+
+std::string processName(int pid) {
+    std::string comm = readFile("/proc/" + std::to_string(pid) + "/comm");
+    while (!comm.empty() && (comm.back() == '\n' || comm.back() == '\r'))
+        comm.pop_back();
+    return comm;
+}
+
+// First mapping of the main executable, else the first executable mapping
+uint64_t imageBase(int pid, const std::vector<MapEntry>& maps) {
+    char exe[PATH_MAX];
+    std::string link = "/proc/" + std::to_string(pid) + "/exe";
+    ssize_t n = ::readlink(link.c_str(), exe, sizeof(exe) - 1);
+    if (n > 0) {
+        exe[n] = '\0';
+        for (const auto& m : maps)
+            if (m.name == exe) return m.lo;
+    }
+    for (const auto& m : maps)
+        if (m.prot & RPB_Exec) return m.lo;
+    return 0;
+}
+
+// ── Range encoding ──
+
+void encodeRange(std::string& out, const char* data, uint32_t len, bool ok, int zlibLevel) {
+    if (!ok) {
+        put(out, uint8_t(RS_Fail));
+        return;
+    }
+    if (isAllZero(data, len)) {
+        put(out, uint8_t(RS_Zero));
+        return;
+    }
+#ifdef RCX_AGENT_HAVE_ZLIB
+    if (zlibLevel > 0 && len >= kMinCompressLen) {
+        uLongf clen = compressBound(len);
+        std::string z(4 + clen, '\0');
+        // qCompress layout: big-endian plain length, then the zlib stream
+        z[0] = char(len >> 24); z[1] = char(len >> 16); z[2] = char(len >> 8); z[3] = char(len);
+        if (compress2(reinterpret_cast<Bytef*>(&z[4]), &clen,
+                      reinterpret_cast<const Bytef*>(data), len, zlibLevel) == Z_OK
+            && 4 + clen < len - len / 8) {
+            put(out, uint8_t(RS_Zlib));
+            put(out, uint32_t(4 + clen));
+            out.append(z.data(), 4 + clen);
+            return;
+        }
+    }
+#else
+    (void)zlibLevel;
+#endif
+    put(out, uint8_t(RS_Raw));
+    out.append(data, len);
+}
+
+// ── Request handlers ──
+
+struct Session {
+    int          fd;
+    int          pid;
+    AgentOptions opts;
+    bool         zlib = false;   // negotiated in Hello
+    bool         authed = false;
+};
+
+// Compares every byte whatever the mismatch, so timing leaks no prefix
+bool tokensEqual(const std::string& a, const std::string& b) {
+    if (a.size() != b.size()) return false;
+    unsigned char diff = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        diff |= static_cast<unsigned char>(a[i] ^ b[i]);
+    return diff == 0;
+}
+
+// Unix peers must be our own user or root.  TCP peers carry no identity,
+// so they are only served when a token is configured.
+bool peerAllowed(int fd, const AgentOptions& opts) {
+    sockaddr_storage sa{};
+    socklen_t len = sizeof(sa);
+    if (getsockname(fd, reinterpret_cast<sockaddr*>(&sa), &len) != 0) return false;
+    if (sa.ss_family == AF_UNIX) {
+        ucred cred{};
+        socklen_t credLen = sizeof(cred);
+        if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &credLen) != 0) return false;
+        return cred.uid == ::geteuid() || cred.uid == 0;
+    }
+    return !opts.token.empty();
+}
+
+bool handleHello(Session& s, const MsgHeader& h, const std::string& payload) {
+    const char* p = payload.data();
+    const char* end = p + payload.size();
+    uint32_t version = 0, caps = 0;
+    if (!take(p, end, &version) || !take(p, end, &caps))
+        return replyError(s.fd, h, "malformed hello");
+
+    std::string token;
+    uint16_t tokenLen = 0;
+    if (take(p, end, &tokenLen)) {
+        if (tokenLen > kMaxTokenLen || end - p < tokenLen)
+            return replyError(s.fd, h, "malformed hello");
+        token.assign(p, tokenLen);
+    }
+    if (!s.opts.token.empty() && !tokensEqual(token, s.opts.token)) {
+        replyError(s.fd, h, "authentication failed");
+        return false;   // drop the connection
+    }
+    s.authed = true;
+
+    uint32_t ours = s.opts.allowWrite ? uint32_t(CAP_Write) : 0;
+#ifdef RCX_AGENT_HAVE_ZLIB
+    if (s.opts.zlibLevel > 0) ours |= CAP_Zlib;
+#endif
+    s.zlib = (caps & CAP_Zlib) && (ours & CAP_Zlib);
+
+    std::vector<MapEntry> maps = readMaps(s.pid);
+    std::string name = processName(s.pid).substr(0, 0xFFFF);
+    std::string body;
+    put(body, kProtocolVersion);
+    put(body, ours);
+    put(body, uint32_t(s.pid));
+    put(body, uint32_t(0));
+    put(body, imageBase(s.pid, maps));
+    put(body, uint16_t(name.size()));
+    body += name;
+    return reply(s.fd, h, body);
+}
+
+bool handleRead(Session& s, const MsgHeader& h, const std::string& payload) {
+    const char* p = payload.data();
+    const char* end = p + payload.size();
+    uint32_t count = 0;
+    if (!take(p, end, &count) || count > kMaxReadRanges)
+        return replyError(s.fd, h, "malformed read");
+
+    std::vector<uint64_t> addrs(count);
+    std::vector<uint32_t> lens(count);
+    std::vector<size_t>   offsets(count);
+    size_t total = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (!take(p, end, &addrs[i]) || !take(p, end, &lens[i]) || lens[i] > kMaxRangeLen)
+            return replyError(s.fd, h, "malformed read");
+        offsets[i] = total;
+        total += lens[i];
+    }
+    if (total > kMaxPayload)
+        return replyError(s.fd, h, "read too large");
+
+    // Vectored read.  process_vm_readv stops at the first remote range it
+    // cannot read, so each call covers as many ranges as succeed; the range
+    // it stopped in is failed and the next call resumes after it.
+    std::vector<char> data(total);
+    std::vector<char> ok(count, 0);
+    constexpr uint32_t kIovMax = 1024;
+    std::vector<iovec> local(kIovMax), remote(kIovMax);
+    uint32_t i = 0;
+    while (i < count) {
+        uint32_t n = std::min(count - i, kIovMax);
+        for (uint32_t k = 0; k < n; k++) {
+            local[k].iov_base = data.data() + offsets[i + k];
+            local[k].iov_len = lens[i + k];
+            remote[k].iov_base = reinterpret_cast<void*>(static_cast<uintptr_t>(addrs[i + k]));
+            remote[k].iov_len = lens[i + k];
+        }
+        ssize_t got = process_vm_readv(s.pid, local.data(), n, remote.data(), n, 0);
+        if (got < 0) {
+            i++;    // first range unreadable
+            continue;
+        }
+        size_t left = static_cast<size_t>(got);
+        uint32_t k = 0;
+        for (; k < n && left >= lens[i + k]; k++) {
+            ok[i + k] = 1;
+            left -= lens[i + k];
+        }
+        i += (k < n) ? k + 1 : k;   // skip the range the read stopped in
+    }
+
+    std::string body;
+    body.reserve(total + count);
+    for (uint32_t r = 0; r < count; r++)
+        encodeRange(body, data.data() + offsets[r], lens[r], ok[r] != 0,
+                    s.zlib ? s.opts.zlibLevel : 0);
+    return reply(s.fd, h, body);
+}
+
+bool handleWrite(Session& s, const MsgHeader& h, const std::string& payload) {
+    const char* p = payload.data();
+    const char* end = p + payload.size();
+    uint64_t addr = 0;
+    if (!take(p, end, &addr))
+        return replyError(s.fd, h, "malformed write");
+    if (!s.opts.allowWrite)
+        return replyError(s.fd, h, "agent is read-only");
+
+    size_t len = static_cast<size_t>(end - p);
+    iovec local{const_cast<char*>(p), len};
+    iovec remote{reinterpret_cast<void*>(static_cast<uintptr_t>(addr)), len};
+    bool ok = process_vm_writev(s.pid, &local, 1, &remote, 1, 0) == static_cast<ssize_t>(len);
+    if (!ok) {
+        // Read-only pages (code, constants) are writable through /proc/<pid>/mem
+        std::string path = "/proc/" + std::to_string(s.pid) + "/mem";
+        int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd >= 0) {
+            ok = ::pwrite(fd, p, len, static_cast<off_t>(addr)) == static_cast<ssize_t>(len);
+            ::close(fd);
+        }
+    }
+    std::string body;
+    put(body, uint8_t(ok ? 1 : 0));
+    return reply(s.fd, h, body);
+}
+
+bool handleRegions(Session& s, const MsgHeader& h) {
+    std::vector<MapEntry> maps = readMaps(s.pid);
+    std::string body;
+    put(body, uint32_t(maps.size()));
+    for (const auto& m : maps) {
+        std::string name = m.name.substr(0, 0xFFFF);
+        put(body, m.lo);
+        put(body, m.hi - m.lo);
+        put(body, m.prot);
+        put(body, uint16_t(name.size()));
+        body += name;
+    }
+    return reply(s.fd, h, body);
+}
+
+} // namespace
+
+bool isLocalListener(int fd) {
+    sockaddr_storage sa{};
+    socklen_t len = sizeof(sa);
+    if (getsockname(fd, reinterpret_cast<sockaddr*>(&sa), &len) != 0) return false;
+    if (sa.ss_family == AF_UNIX) return true;
+    if (sa.ss_family == AF_INET) {
+        const auto* in = reinterpret_cast<const sockaddr_in*>(&sa);
+        return (ntohl(in->sin_addr.s_addr) >> 24) == 127;
+    }
+    if (sa.ss_family == AF_INET6) {
+        const auto* in6 = reinterpret_cast<const sockaddr_in6*>(&sa);
+        if (IN6_IS_ADDR_LOOPBACK(&in6->sin6_addr)) return true;
+        // ::ffff:127.x.x.x
+        return IN6_IS_ADDR_V4MAPPED(&in6->sin6_addr) && in6->sin6_addr.s6_addr[12] == 127;
+    }
+    return false;
+}
+
+int listenOn(const std::string& endpoint, std::string* error) {
+    auto setError = [&](const std::string& e) { if (error) *error = e; return -1; };
+
+    if (endpoint.compare(0, 4, "tcp:") == 0) {
+        std::string rest = endpoint.substr(4);
+        size_t colon = rest.rfind(':');
+        if (colon == std::string::npos) return setError("expected tcp:host:port");
+        std::string host = rest.substr(0, colon);
+        std::string port = rest.substr(colon + 1);
+        if (host.size() >= 2 && host.front() == '[' && host.back() == ']')
+            host = host.substr(1, host.size() - 2);
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_PASSIVE;
+        addrinfo* res = nullptr;
+        if (getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &res) != 0 || !res)
+            return setError("cannot resolve " + host);
+        int fd = -1;
+        for (addrinfo* ai = res; ai && fd < 0; ai = ai->ai_next) {
+            fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+            if (fd < 0) continue;
+            int one = 1;
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            if (::bind(fd, ai->ai_addr, ai->ai_addrlen) != 0 || ::listen(fd, 16) != 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+        freeaddrinfo(res);
+        if (fd < 0) return setError("cannot listen on " + rest + ": " + std::strerror(errno));
+        return fd;
+    }
+
+    if (endpoint.compare(0, 5, "unix:") == 0) {
+        std::string path = endpoint.substr(5);
+        sockaddr_un sa{};
+        sa.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(sa.sun_path)) return setError("invalid socket path");
+        std::memcpy(sa.sun_path, path.data(), path.size());
+        ::unlink(path.c_str());
+        int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) return setError("socket() failed");
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&sa), sizeof(sa)) != 0 || ::listen(fd, 16) != 0) {
+            ::close(fd);
+            return setError("cannot listen on " + path + ": " + std::strerror(errno));
+        }
+        return fd;
+    }
+
+    return setError("unknown endpoint '" + endpoint + "' (expected tcp:host:port or unix:/path)");
+}
+
+bool serveConnection(int fd, int pid, const AgentOptions& opts) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));   // fails harmlessly on unix sockets
+
+    if (!peerAllowed(fd, opts)) {
+        ::close(fd);
+        return false;
+    }
+
+    Session s{fd, pid, opts};
+    bool clean = true;
+    std::string payload;
+    for (;;) {
+        MsgHeader h;
+        if (!recvAll(fd, &h, sizeof(h))) break;        // peer closed
+        if (h.length > kMaxPayload) { clean = false; break; }
+        payload.resize(h.length);
+        if (h.length > 0 && !recvAll(fd, &payload[0], h.length)) break;
+
+        if (h.op != OP_Hello && !s.authed) {
+            replyError(fd, h, "hello first");
+            clean = false;
+            break;
+        }
+
+        bool sent;
+        switch (h.op) {
+        case OP_Hello:   sent = handleHello(s, h, payload); break;
+        case OP_Read:    sent = handleRead(s, h, payload); break;
+        case OP_Write:   sent = handleWrite(s, h, payload); break;
+        case OP_Regions: sent = handleRegions(s, h); break;
+        default:         sent = replyError(fd, h, "unknown op"); break;
+        }
+        if (!sent) break;
+    }
+    ::close(fd);
+    return clean;
+}
+
+} // namespace remote
+} // namespace rcx
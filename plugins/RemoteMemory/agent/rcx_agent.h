@@ -0,0 +1,38 @@
+#pragma once
+#include <string>
+
+// ──────────────────────────────────────────────────────────────────────────
+// rcx-agent: reference server for the remote memory protocol
+//
+// Serves one Linux process over RemoteProtocol.h using process_vm_readv /
+// process_vm_writev and /proc/<pid>/maps.  Deliberately free of Qt so it
+// can be dropped into a container next to the target; zlib is optional
+// (RCX_AGENT_HAVE_ZLIB) and only used for Read payloads.
+//
+// Whoever can talk to the agent can read the target's memory, so peers are
+// authenticated: Unix socket peers must run as the agent's own user (or
+// root), and TCP peers must present the token in Hello.
+// ──────────────────────────────────────────────────────────────────────────
+
+namespace rcx {
+namespace remote {
+
+struct AgentOptions {
+    bool        allowWrite = false;
+    int         zlibLevel  = 1;     // 0 never compresses
+    std::string token;              // required in Hello; TCP peers are refused without one
+};
+
+// Open a listening socket for "tcp:host:port" or "unix:/path" (an existing
+// socket file at path is replaced).  Returns the fd, or -1 with *error set.
+int listenOn(const std::string& endpoint, std::string* error);
+
+// True for Unix sockets and TCP sockets bound to a loopback address
+bool isLocalListener(int fd);
+
+// Serve one accepted connection until the peer disconnects.  Blocking; run
+// one per thread.  Closes fd.  Returns false if the peer broke the protocol.
+bool serveConnection(int fd, int pid, const AgentOptions& opts = {});
+
+} // namespace remote
+} // namespace rcx
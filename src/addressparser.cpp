@@ -8,6 +8,7 @@ namespace rcx {
 //   "7FF66CCE0000"                    → plain hex address
 //   "0x100 + 0x200"                   → arithmetic on hex values
 //   "<Program.exe> + 0xDE"            → module base + offset
+//   "<libgame.so>!g_World + 0x10"     → symbol address + offset
 //   "[<Program.exe> + 0xDE] - AB"     → dereference pointer, then subtract
 //   "7ff6`6cce0000"                   → WinDbg-style backtick separator (stripped before parsing)
 //
@@ -18,11 +19,13 @@ namespace rcx {
 //   unary  = '-' unary | atom
 //   atom   = '[' expr ']'             -- read pointer at address (dereference)
 //          | '<' moduleName '>'       -- resolve module base address
+//          | '<' moduleName '>' '!' symbol  -- resolve a symbol in that module
 //          | '(' expr ')'             -- grouping
 //          | hexLiteral               -- hex number, optional 0x prefix
 //
 // All numeric literals are hexadecimal (base 16).
-// Module names and pointer reads are resolved via optional callbacks.
+// Module names and pointer reads are resolved via optional callbacks; a
+// symbol reaches resolveModule as "moduleName!symbol".
 // Without callbacks, modules and dereferences evaluate to 0 (syntax-check mode).
 
 class ExpressionParser {
@@ -191,7 +194,15 @@ private:
         return true;
     }
 
-    // '<' moduleName '>' — resolve a module's base address (e.g. <Program.exe>)
+    // Characters that end a symbol name after '!'
+    static bool isSymbolChar(QChar ch) {
+        return !ch.isSpace() && ch != '+' && ch != '-' && ch != '*' && ch != '/'
+            && ch != '[' && ch != ']' && ch != '(' && ch != ')'
+            && ch != '<' && ch != '>';
+    }
+
+    // '<' moduleName '>' ['!' symbol] — resolve a module's base address
+    // (e.g. <Program.exe>) or a symbol inside it (<libgame.so>!g_World)
     bool parseModuleName(uint64_t& result) {
         advance(); // skip '<'
 
@@ -207,6 +218,18 @@ private:
         if (name.isEmpty())
             return fail("empty module name");
 
+        bool isSymbol = false;
+        if (peek() == '!') {
+            advance(); // skip '!'
+            int symStart = m_pos;
+            while (!atEnd() && isSymbolChar(peek()))
+                advance();
+            if (m_pos == symStart)
+                return fail("expected symbol name");
+            name += QChar('!') + m_input.mid(symStart, m_pos - symStart);
+            isSymbol = true;
+        }
+
         // Without a callback, just return 0 (syntax-check mode)
         if (!m_callbacks || !m_callbacks->resolveModule) {
             result = 0;
@@ -216,7 +239,8 @@ private:
         bool ok = false;
         result = m_callbacks->resolveModule(name, &ok);
         if (!ok)
-            return fail(QStringLiteral("module '%1' not found").arg(name));
+            return fail((isSymbol ? QStringLiteral("symbol '%1' not found")
+                                  : QStringLiteral("module '%1' not found")).arg(name));
         return true;
     }
 
@@ -32,6 +32,15 @@ struct ComposeState {
     QHash<uint64_t, int> scopeTypeW;
     QHash<uint64_t, int> scopeNameW;
 
+    const ArrayWindows* windows = nullptr;
+    CancelToken         cancel;   // a newer compose superseded this one
+
+    // Incremental compose (null for a full one): blocks reused or rendered
+    // by this compose, and a hash of every line emitted
+    ComposeCache*                                 cache = nullptr;
+    QHash<ComposeCache::Key, ComposeCache::Block> keptBlocks;
+    QVector<uint>                                 lineHashes;
+
     int effectiveTypeW(uint64_t scopeId) const {
         return scopeTypeW.value(scopeId, typeW);
     }
@@ -39,7 +48,51 @@ struct ComposeState {
         return scopeNameW.value(scopeId, nameW);
     }
 
-    void emitLine(const QString& lineText, LineMeta lm) {
+    static uint lineHash(const QString& lineText, const LineMeta& lm) {
+        uint h = ::qHash(lineText) ^ (::qHash(lm.offsetText) * 31u);
+        return h ^ (lm.markerMask * 0x9E3779B9u) ^ uint(lm.foldLevel << 2)
+                 ^ (uint(lm.foldHead) << 30) ^ (uint(lm.foldCollapsed) << 31);
+    }
+
+    // Emit a block rendered earlier from the same bytes, if there is one
+    bool reuseBlock(const ComposeCache::Key& key, const QByteArray& bytes) {
+        if (bytes.isEmpty()) return false;
+        auto it = cache->blocks.find(key);
+        bool fromLast = it != cache->blocks.end();
+        if (!fromLast) {
+            // The same block can appear twice in one view (two pointers to
+            // one object); the first use already moved it over
+            it = keptBlocks.find(key);
+            if (it == keptBlocks.end()) return false;
+        }
+        if (it->bytes != bytes) return false;
+        for (int i = 0; i < it->lines.size(); i++)
+            emitLine(it->lines[i], it->meta[i], &it->hashes[i]);
+        if (fromLast) {
+            keptBlocks.insert(key, std::move(*it));
+            cache->blocks.erase(it);
+        }
+        return true;
+    }
+
+    // First element of an array's window
+    int windowStart(const Node& node, int window) const {
+        if (node.arrayLen <= window) return 0;
+        int start = windows ? windows->value(node.id, -1) : -1;
+        if (start < 0) start = node.viewIndex - window / 2;
+        return qBound(0, start, node.arrayLen - window);
+    }
+
+    // Record the line just emitted as part of a block being rendered
+    void appendToBlock(ComposeCache::Block& block, const QString& lineText) {
+        block.lines.append(lineText);
+        block.meta.append(meta.last());
+        block.hashes.append(lineHashes.last());
+    }
+
+    void emitLine(const QString& lineText, LineMeta lm, const uint* hash = nullptr) {
+        if (cache)
+            lineHashes.append(hash ? *hash : lineHash(lineText, lm));
         if (currentLine > 0) text += '\n';
         // 3-char fold indicator column: " - " expanded, " + " collapsed, "   " other
         // CommandRow has no fold prefix (flush left)
@@ -70,6 +123,36 @@ uint32_t computeMarkers(const Node& node, const Provider& /*prov*/,
     return mask;
 }
 
+// The bytes a cached block covers.  Empty, so the block is never cached,
+// when they cannot be read as a whole: a partial read can still show some
+// of the values.
+QByteArray blockBytes(const Provider& prov, uint64_t addr, int len) {
+    if (len <= 0) return {};
+    QByteArray b(len, Qt::Uninitialized);
+    if (!prov.read(addr, b.data(), len)) return {};
+    return b;
+}
+
+// One line standing for `count` elements of a windowed array, from `first`
+void emitElided(ComposeState& state, int nodeIdx, const Node& node, int depth,
+                int first, int count, uint64_t addr) {
+    LineMeta lm;
+    lm.nodeIdx     = nodeIdx;
+    lm.nodeId      = node.id;
+    lm.depth       = depth;
+    lm.lineKind    = LineKind::ArrayElementSeparator;
+    lm.nodeKind    = node.elementKind;
+    lm.offsetText  = fmt::fmtOffsetMargin(addr, false, state.offsetHexDigits);
+    lm.offsetAddr  = addr;
+    lm.ptrBase     = state.currentPtrBase;
+    lm.foldLevel   = computeFoldLevel(depth, false);
+    lm.markerMask  = 0;
+    lm.arrayElementIdx = first;
+    lm.arrayElided = count;
+    state.emitLine(fmt::indent(depth) + QStringLiteral("[%1..%2] \u2026 %3 more")
+                       .arg(first).arg(first + count - 1).arg(count), lm);
+}
+
 static QString resolvePointerTarget(const NodeTree& tree, uint64_t refId) {
     if (refId == 0) return {};
     int refIdx = tree.indexOfId(refId);
@@ -132,6 +215,19 @@ void composeLeaf(ComposeState& state, const NodeTree& tree,
         }
     }
 
+    // Pointer values may show the pointee (char*), so only plain fields
+    // are cached
+    bool cacheable = state.cache && node.kind != NodeKind::Pointer32
+                  && node.kind != NodeKind::Pointer64;
+    ComposeCache::Key key{};
+    ComposeCache::Block block;
+    if (cacheable) {
+        key = {node.id, -1, absAddr, state.currentPtrBase, depth, typeW, nameW,
+               state.offsetHexDigits};
+        block.bytes = blockBytes(prov, absAddr, node.byteSize());
+        if (state.reuseBlock(key, block.bytes)) return;
+    }
+
     for (int sub = 0; sub < numLines; sub++) {
         bool isCont = (sub > 0);
 
@@ -160,7 +256,10 @@ void composeLeaf(ComposeState& state, const NodeTree& tree,
         QString lineText = fmt::fmtNodeLine(node, prov, absAddr, depth, sub,
                                             /*comment=*/{}, typeW, nameW, ptrTypeOverride);
         state.emitLine(lineText, lm);
+        if (cacheable) state.appendToBlock(block, lineText);
     }
+    if (cacheable && !block.bytes.isEmpty())
+        state.keptBlocks.insert(key, std::move(block));
 }
 
 // Forward declarations (base/rootId default to 0 = use precomputed offsets)
@@ -180,6 +279,7 @@ void composeParent(ComposeState& state, const NodeTree& tree,
                    uint64_t base, uint64_t rootId, bool isArrayChild,
                    uint64_t scopeId, int arrayElementIdx,
                    uint64_t arrayContainerAddr) {
+    if (state.cancel.isCancelled()) return;
     const Node& node = tree.nodes[nodeIdx];
     uint64_t absAddr = resolveAddr(state, tree, nodeIdx, base, rootId);
 
@@ -282,8 +382,21 @@ void composeParent(ComposeState& state, const NodeTree& tree,
             int elemSize = sizeForKind(node.elementKind);
             int eTW = state.effectiveTypeW(node.id);
             int eNW = state.effectiveNameW(node.id);
-            for (int i = 0; i < node.arrayLen; i++) {
-                uint64_t elemAddr = absAddr + i * elemSize;
+            int first = state.windowStart(node, kArrayWindow);
+            int last = qMin(node.arrayLen, first + kArrayWindow);
+            if (first > 0)
+                emitElided(state, nodeIdx, node, childDepth, 0, first, absAddr);
+            for (int i = first; i < last; i++) {
+                uint64_t elemAddr = absAddr + uint64_t(i) * elemSize;
+
+                ComposeCache::Key key{};
+                ComposeCache::Block block;
+                if (state.cache) {
+                    key = {node.id, i, elemAddr, state.currentPtrBase, childDepth,
+                           eTW, eNW, state.offsetHexDigits};
+                    block.bytes = blockBytes(prov, elemAddr, elemSize);
+                    if (state.reuseBlock(key, block.bytes)) continue;
+                }
 
                 // Type override: "float[0]", "uint32_t[1]", etc.
                 QString elemTypeStr = fmt::typeNameRaw(node.elementKind)
@@ -303,6 +416,7 @@ void composeParent(ComposeState& state, const NodeTree& tree,
                 lm.lineKind   = LineKind::Field;
                 lm.nodeKind   = node.elementKind;
                 lm.isArrayElement = true;
+                lm.arrayElementIdx = i;
                 lm.offsetText = fmt::fmtOffsetMargin(elemAddr, false, state.offsetHexDigits);
                 lm.offsetAddr = elemAddr;
                 lm.ptrBase    = state.currentPtrBase;
@@ -311,9 +425,17 @@ void composeParent(ComposeState& state, const NodeTree& tree,
                 lm.effectiveTypeW = eTW;
                 lm.effectiveNameW = eNW;
 
-                state.emitLine(fmt::fmtNodeLine(elem, prov, elemAddr, childDepth, 0,
-                                                {}, eTW, eNW, elemTypeStr), lm);
+                QString lineText = fmt::fmtNodeLine(elem, prov, elemAddr, childDepth, 0,
+                                                    {}, eTW, eNW, elemTypeStr);
+                state.emitLine(lineText, lm);
+                if (state.cache && !block.bytes.isEmpty()) {
+                    state.appendToBlock(block, lineText);
+                    state.keptBlocks.insert(key, std::move(block));
+                }
             }
+            if (last < node.arrayLen)
+                emitElided(state, nodeIdx, node, childDepth, last, node.arrayLen - last,
+                           absAddr + uint64_t(last) * elemSize);
         }
 
         // Struct arrays with refId but no child nodes: synthesize by expanding the
@@ -322,14 +444,21 @@ void composeParent(ComposeState& state, const NodeTree& tree,
             && node.elementKind == NodeKind::Struct && node.refId != 0) {
             int refIdx = tree.indexOfId(node.refId);
             if (refIdx >= 0) {
-                int elemSize = tree.structSpan(node.refId, &state.childMap);
+                int elemSize = tree.structSpan(node.refId);
                 if (elemSize <= 0) elemSize = 1;
-                for (int i = 0; i < node.arrayLen; i++) {
+                int first = state.windowStart(node, kStructArrayWindow);
+                int last = qMin(node.arrayLen, first + kStructArrayWindow);
+                if (first > 0)
+                    emitElided(state, nodeIdx, node, childDepth, 0, first, absAddr);
+                for (int i = first; i < last; i++) {
                     uint64_t elemBase = absAddr + (uint64_t)i * elemSize;
                     // Use base offset that maps refStruct's children to the right provider address
                     composeParent(state, tree, prov, refIdx, childDepth, elemBase, node.refId,
                                   /*isArrayChild=*/true, node.id, i, absAddr);
                 }
+                if (last < node.arrayLen)
+                    emitElided(state, nodeIdx, node, childDepth, last, node.arrayLen - last,
+                               absAddr + (uint64_t)last * elemSize);
             }
         }
 
@@ -401,7 +530,7 @@ void composeParent(ComposeState& state, const NodeTree& tree,
         lm.isRootHeader = isRootHeader;  // root footer: flush left (no fold prefix)
         lm.foldLevel  = computeFoldLevel(depth, false);
         lm.markerMask = 0;
-        int sz = tree.structSpan(node.id, &state.childMap);
+        int sz = tree.structSpan(node.id);
         lm.offsetText = fmt::fmtOffsetMargin(absAddr + sz, false, state.offsetHexDigits);
         lm.offsetAddr = absAddr + sz;
         lm.ptrBase    = state.currentPtrBase;
@@ -557,12 +686,16 @@ void composeNode(ComposeState& state, const NodeTree& tree,
 
 } // anonymous namespace
 
-ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewRootId) {
+static ComposeResult composeTree(const NodeTree& tree, const Provider& prov,
+                                 uint64_t viewRootId, ComposeCache* cache,
+                                 const ArrayWindows& windows, const CancelToken& cancel) {
     ComposeState state;
+    state.cache = cache;
+    state.windows = &windows;
+    state.cancel = cancel;
 
-    // Precompute parent→children map
-    for (int i = 0; i < tree.nodes.size(); i++)
-        state.childMap[tree.nodes[i].parentId].append(i);
+    // Parent→children map, shared with the tree's layout index
+    state.childMap = tree.layoutIndex().children;
 
     // Precompute absolute offsets (baseAddress + structure-relative offset)
     state.absOffsets.resize(tree.nodes.size());
@@ -698,8 +831,41 @@ ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewR
             continue;
         composeNode(state, tree, prov, idx, 0);
     }
+    // Partial text; the cache still describes the last finished compose
+    if (state.cancel.isCancelled()) return {};
+
+    ComposeResult result{ state.text, state.meta,
+                          LayoutInfo{state.typeW, state.nameW, state.offsetHexDigits,
+                                     tree.baseAddress}, {}, false };
+    if (cache) {
+        // Same line count: report the lines that differ.  Otherwise lines
+        // moved and there is nothing cheaper than a full redraw.
+        result.linesStable = !cache->lineHashes.isEmpty()
+            && cache->lineHashes.size() == state.lineHashes.size();
+        if (result.linesStable) {
+            for (int i = 0; i < state.lineHashes.size(); i++) {
+                if (state.lineHashes[i] == cache->lineHashes[i]) continue;
+                if (!result.changedLines.isEmpty() && result.changedLines.last().second == i - 1)
+                    result.changedLines.last().second = i;
+                else
+                    result.changedLines.append({i, i});
+            }
+        }
+        cache->lineHashes = std::move(state.lineHashes);
+        cache->blocks = std::move(state.keptBlocks);
+    }
+    return result;
+}
+
+ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewRootId,
+                      const ArrayWindows& windows) {
+    return composeTree(tree, prov, viewRootId, nullptr, windows, {});
+}
 
-    return { state.text, state.meta, LayoutInfo{state.typeW, state.nameW, state.offsetHexDigits, tree.baseAddress} };
+ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewRootId,
+                      ComposeCache& cache, const ArrayWindows& windows,
+                      const CancelToken& cancel) {
+    return composeTree(tree, prov, viewRootId, &cache, windows, cancel);
 }
 
 QSet<uint64_t> NodeTree::normalizePreferAncestors(const QSet<uint64_t>& ids) const {
@@ -2,6 +2,8 @@
 #include "addressparser.h"
 #include "typeselectorpopup.h"
 #include "providerregistry.h"
+#include "pointer_chase.h"
+#include "providers/parallel_read.h"
 #include "themes/thememanager.h"
 #include <Qsci/qsciscintilla.h>
 #include <QSplitter>
@@ -17,15 +19,22 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QSettings>
+#include <QDateTime>
 #include <QtConcurrent/QtConcurrentRun>
 #include <limits>
 
 namespace rcx {
 
-static thread_local const RcxDocument* s_composeDoc = nullptr;
+// Type aliases of the document being composed.  Thread-local so a worker
+// can compose against its own copy while the UI thread edits the original.
+static thread_local const QHash<NodeKind, QString>* s_composeAliases = nullptr;
 
 static QString docTypeNameProvider(NodeKind k) {
-    if (s_composeDoc) return s_composeDoc->resolveTypeName(k);
+    if (s_composeAliases) {
+        auto it = s_composeAliases->constFind(k);
+        if (it != s_composeAliases->constEnd() && !it.value().isEmpty())
+            return it.value();
+    }
     auto* m = kindMeta(k);
     return m ? QString::fromLatin1(m->typeName) : QStringLiteral("???");
 }
@@ -72,8 +81,18 @@ RcxDocument::RcxDocument(QObject* parent)
     });
 }
 
-ComposeResult RcxDocument::compose(uint64_t viewRootId) const {
-    return rcx::compose(tree, *provider, viewRootId);
+ComposeResult RcxDocument::compose(uint64_t viewRootId, const ArrayWindows& windows) const {
+    return rcx::compose(tree, *provider, viewRootId, windows);
+}
+
+std::shared_ptr<Provider> RcxDocument::cachedProvider() {
+    // m_cache keeps the previous source alive, so the pointer compare
+    // cannot be fooled by a new provider reusing a freed address.
+    if (m_cacheSource != provider.get()) {
+        m_cache = CachingProvider::shared(provider);
+        m_cacheSource = provider.get();
+    }
+    return m_cache;
 }
 
 bool RcxDocument::save(const QString& path) {
@@ -123,15 +142,27 @@ bool RcxDocument::load(const QString& path) {
     return true;
 }
 
-void RcxDocument::loadData(const QString& binaryPath) {
+void RcxDocument::loadData(const QString& binaryPath, bool asImage) {
     QFile file(binaryPath);
     if (!file.open(QIODevice::ReadOnly))
         return;
     undoStack.clear();
-    provider = std::make_shared<BufferProvider>(
-        file.readAll(), QFileInfo(binaryPath).fileName());
+    // Executables get their loaded layout (virtual addresses, zero-filled
+    // bss) unless opened as a raw file.  Other files are mapped flat instead
+    // of copied; sources that cannot be mapped (pipes, character devices)
+    // fall back to a buffer.
+    auto image = asImage ? std::make_shared<ImageProvider>(binaryPath) : nullptr;
+    bool isImage = image && image->isImage();
+    auto mapped = isImage ? nullptr : std::make_shared<MappedFileProvider>(binaryPath);
+    if (isImage)
+        provider = std::move(image);
+    else if (mapped->isMapped())
+        provider = std::move(mapped);
+    else
+        provider = std::make_shared<BufferProvider>(
+            file.readAll(), QFileInfo(binaryPath).fileName());
     dataPath = binaryPath;
-    tree.baseAddress = 0;
+    tree.baseAddress = provider->base();
     emit documentChanged();
 }
 
@@ -156,15 +187,25 @@ RcxController::RcxController(RcxDocument* doc, QWidget* parent)
     : QObject(parent), m_doc(doc)
 {
     fmt::setTypeNameProvider(docTypeNameProvider);
-    connect(m_doc, &RcxDocument::documentChanged, this, &RcxController::refresh);
+    connect(m_doc, &RcxDocument::documentChanged, this, [this]() {
+        m_planStale = true;
+        dropComposeCache();
+        refresh();
+    });
     setupAutoRefresh();
 }
 
 RcxController::~RcxController() {
+    s_historyOwners.removeOne(this);
+    rebalanceHistory();
     if (m_refreshWatcher) {
         m_refreshWatcher->cancel();
         m_refreshWatcher->waitForFinished();
     }
+    if (m_composeWatcher) {
+        ++m_composeGen;
+        m_composeWatcher->waitForFinished();
+    }
 }
 
 RcxEditor* RcxController::primaryEditor() const {
@@ -211,6 +252,8 @@ void RcxController::connectEditor(RcxEditor* editor) {
             this, [this, editor](int line, uint64_t nodeId, Qt::KeyboardModifiers mods) {
         handleNodeClick(editor, line, nodeId, mods);
     });
+    connect(editor, &RcxEditor::viewportScrolled,
+            this, &RcxController::onViewportScrolled);
 
     // Type selector popup (command row chevron)
     connect(editor, &RcxEditor::typeSelectorRequested,
@@ -240,7 +283,7 @@ void RcxController::connectEditor(RcxEditor* editor) {
 
     // Inline editing signals
     connect(editor, &RcxEditor::inlineEditCommitted,
-            this, [this](int nodeIdx, int subLine, EditTarget target, const QString& text,
+            this, [this, editor](int nodeIdx, int subLine, EditTarget target, const QString& text,
                          uint64_t resolvedAddr) {
         // CommandRow BaseAddress/Source/RootClass edit has nodeIdx=-1
         if (nodeIdx < 0 && target != EditTarget::BaseAddress && target != EditTarget::Source
@@ -454,9 +497,15 @@ void RcxController::connectEditor(RcxEditor* editor) {
             }
             break;
         }
-        case EditTarget::ArrayIndex:
+        case EditTarget::ArrayIndex: {
+            // Index typed over a windowed array's placeholder
+            bool ok;
+            int index = text.trimmed().toInt(&ok, 0);
+            if (ok && jumpToArrayElement(editor, nodeIdx, index)) return;
+            break;
+        }
         case EditTarget::ArrayCount:
-            // Array navigation removed - these cases are unreachable
+            // Array navigation removed - unreachable
             break;
         }
         // Always refresh to restore canonical text (handles parse failures, no-ops, etc.)
@@ -469,6 +518,15 @@ void RcxController::connectEditor(RcxEditor* editor) {
 void RcxController::setViewRootId(uint64_t id) {
     if (m_viewRootId == id) return;
     m_viewRootId = id;
+    dropComposeCache();
+    refresh();
+}
+
+void RcxController::setTypeAliases(const QHash<NodeKind, QString>& aliases) {
+    if (m_doc->typeAliases == aliases) return;
+    m_doc->typeAliases = aliases;
+    m_doc->modified = true;
+    dropComposeCache();
     refresh();
 }
 
@@ -487,85 +545,144 @@ void RcxController::setTrackValues(bool on) {
     }
 }
 
-void RcxController::refresh() {
-    // Bracket compose with thread-local doc pointer for type name resolution
-    s_composeDoc = m_doc;
-
-    // Compose against snapshot provider if active, otherwise real provider
-    if (m_snapshotProv)
-        m_lastResult = rcx::compose(m_doc->tree, *m_snapshotProv, m_viewRootId);
-    else
-        m_lastResult = m_doc->compose(m_viewRootId);
-
-    s_composeDoc = nullptr;
-
-    // Mark lines whose node data changed since last refresh
-    if (!m_changedOffsets.isEmpty()) {
-        for (auto& lm : m_lastResult.meta) {
-            if (lm.nodeIdx < 0 || lm.nodeIdx >= m_doc->tree.nodes.size()) continue;
-            int64_t offset = m_doc->tree.computeOffset(lm.nodeIdx);
-            const Node& node = m_doc->tree.nodes[lm.nodeIdx];
+// Lines whose node data changed since the last snapshot.  Page maps are
+// keyed by absolute address, so query with the line's address.
+static void markChangedLines(ComposeResult& result, const NodeTree& tree,
+                             const PageChanges& changes) {
+    if (changes.isEmpty()) return;
+    for (auto& lm : result.meta) {
+        if (lm.nodeIdx < 0 || lm.nodeIdx >= tree.nodes.size()) continue;
+        const Node& node = tree.nodes[lm.nodeIdx];
+
+        if (isHexPreview(node.kind)) {
+            // Per-byte tracking for hex preview nodes
+            changes.changedIndices(lm.offsetAddr, lm.lineByteCount, lm.changedByteIndices);
+            lm.dataChanged = !lm.changedByteIndices.isEmpty();
+        } else {
+            // Use structSpan for containers (byteSize returns 0 for Array-of-Struct)
+            int sz = (node.kind == NodeKind::Struct || node.kind == NodeKind::Array)
+                ? tree.structSpan(node.id) : node.byteSize();
+            if (sz > 0 && changes.anyChanged(lm.offsetAddr, uint64_t(sz)))
+                lm.dataChanged = true;
+        }
+    }
+}
 
-            if (isHexPreview(node.kind)) {
-                // Per-byte tracking for hex preview nodes
-                int lineOff = 0;
-                int byteCount = lm.lineByteCount;
-                for (int b = 0; b < byteCount; b++) {
-                    if (m_changedOffsets.contains(offset + lineOff + b)) {
-                        lm.changedByteIndices.append(b);
-                        lm.dataChanged = true;
-                    }
-                }
-            } else {
-                // Use structSpan for containers (byteSize returns 0 for Array-of-Struct)
-                int sz = (node.kind == NodeKind::Struct || node.kind == NodeKind::Array)
-                    ? m_doc->tree.structSpan(node.id) : node.byteSize();
-                for (int64_t b = offset; b < offset + sz; b++) {
-                    if (m_changedOffsets.contains(b)) {
-                        lm.dataChanged = true;
-                        break;
-                    }
-                }
+// Current values of the field lines the heatmap tracks.  Reads only `prov`
+// and the given copies, so it runs on a compose worker as well.
+static QVector<ComposeOutput::Sample> sampleValues(
+        const ComposeResult& result, const NodeTree& tree, const Provider& prov,
+        const PageChanges& changes, bool changesCoverTick,
+        const QHash<uint64_t, ValueHistory>& history) {
+    QVector<ComposeOutput::Sample> samples;
+    for (int i = 0; i < result.meta.size(); i++) {
+        const LineMeta& lm = result.meta[i];
+        if (lm.nodeIdx < 0 || lm.nodeIdx >= tree.nodes.size()) continue;
+        if (isSyntheticLine(lm) || lm.isContinuation) continue;
+        if (lm.lineKind != LineKind::Field) continue;
+
+        const Node& node = tree.nodes[lm.nodeIdx];
+        // Skip containers — they don't have scalar values
+        if (node.kind == NodeKind::Struct || node.kind == NodeKind::Array) continue;
+        // Skip FuncPtr nodes — vtable entries don't change; tracking them
+        // causes false heatmap and popup fighting with the disasm popup.
+        if (isFuncPtr(node.kind)) continue;
+
+        // Use the absolute address from compose (correct for pointer-expanded nodes)
+        uint64_t addr = lm.offsetAddr;
+        int sz = node.byteSize();
+        if (sz <= 0) continue;
+
+        // Bytes the tick's diff saw unchanged format to the value
+        // already recorded; skip re-reading and re-formatting them
+        if (changesCoverTick && !changes.anyChanged(addr, uint64_t(sz))
+            && changes.covers(addr, uint64_t(sz))) {
+            auto hist = history.constFind(lm.nodeId);
+            if (hist != history.constEnd() && hist->count > 0) {
+                samples.append({i, sz, QString()});
+                continue;
             }
         }
+        if (!prov.isReadable(addr, sz)) continue;
+
+        QString val = fmt::readValue(node, prov, addr, lm.subLine);
+        if (!val.isEmpty())
+            samples.append({i, sz, val});
     }
+    return samples;
+}
+
+void RcxController::refresh() {
+    // A compose still running on a worker is older than this one
+    cancelCompose();
+
+    // Bracket compose with thread-local type aliases for type name resolution
+    s_composeAliases = &m_doc->typeAliases;
+
+    // Compose against the scrubbed history frame, else the snapshot provider
+    // if active, otherwise the real provider
+    // A live source with no snapshot yet (just attached or switched) is not
+    // read here: compose against an empty page table and fetch the first
+    // snapshot now, so a slow source never stalls the UI thread.
+    bool awaitingSnapshot = !m_scrubProv && !m_snapshotProv && m_refreshWatcher
+        && m_doc->provider && m_doc->provider->isLive();
+    if (m_scrubProv)
+        m_lastResult = rcx::compose(m_doc->tree, *m_scrubProv, m_viewRootId,
+                                    *m_composeCache, m_arrayWindows);
+    else if (m_snapshotProv)
+        m_lastResult = rcx::compose(m_doc->tree, *m_snapshotProv, m_viewRootId,
+                                    *m_composeCache, m_arrayWindows);
+    else if (awaitingSnapshot) {
+        SnapshotProvider empty(m_doc->provider, {}, refreshPlan().rootExtent);
+        m_lastResult = rcx::compose(m_doc->tree, empty, m_viewRootId, m_arrayWindows);
+        QTimer::singleShot(0, this, &RcxController::onRefreshTick);
+    } else
+        m_lastResult = m_doc->compose(m_viewRootId, m_arrayWindows);
+
+    s_composeAliases = nullptr;
+
+    markChangedLines(m_lastResult, m_doc->tree, m_changes);
 
     // Update value history and compute heat levels
     // Only run when a live provider is attached (not for static file/buffer sources)
-    {
+    // and the view is live (scrubbing past frames must not feed the heatmap)
+    if (!m_scrubProv && !awaitingSnapshot) {
         const Provider* prov = nullptr;
         if (m_snapshotProv && m_snapshotProv->isLive())
             prov = m_snapshotProv.get();
         else if (m_doc->provider && m_doc->provider->isValid() && m_doc->provider->isLive())
             prov = m_doc->provider.get();
 
-        if (m_trackValues && prov) {
-            for (auto& lm : m_lastResult.meta) {
-                if (lm.nodeIdx < 0 || lm.nodeIdx >= m_doc->tree.nodes.size()) continue;
-                if (isSyntheticLine(lm) || lm.isContinuation) continue;
-                if (lm.lineKind != LineKind::Field) continue;
-
-                const Node& node = m_doc->tree.nodes[lm.nodeIdx];
-                // Skip containers — they don't have scalar values
-                if (node.kind == NodeKind::Struct || node.kind == NodeKind::Array) continue;
-                // Skip FuncPtr nodes — vtable entries don't change; tracking them
-                // causes false heatmap and popup fighting with the disasm popup.
-                if (isFuncPtr(node.kind)) continue;
-
-                // Use the absolute address from compose (correct for pointer-expanded nodes)
-                uint64_t addr = lm.offsetAddr;
-                int sz = node.byteSize();
-                if (sz <= 0 || !prov->isReadable(addr, sz)) continue;
-
-                QString val = fmt::readValue(node, *prov, addr, lm.subLine);
-                if (!val.isEmpty()) {
-                    m_valueHistory[lm.nodeId].record(val);
-                    lm.heatLevel = m_valueHistory[lm.nodeId].heatLevel();
-                }
-            }
+        if (m_trackValues && prov)
+            applyHeat(sampleValues(m_lastResult, m_doc->tree, *prov, m_changes,
+                                   m_changesCoverTick, m_valueHistory));
+    }
+
+    presentResult();
+}
+
+// Record sampled values and set each line's heat.  The history belongs to
+// the UI thread; workers only sample against a copy of it.
+void RcxController::applyHeat(const QVector<ComposeOutput::Sample>& samples) {
+    m_scheduler.beginHeat();
+    for (const auto& sample : samples) {
+        LineMeta& lm = m_lastResult.meta[sample.line];
+        if (sample.value.isNull()) {
+            auto hist = m_valueHistory.constFind(lm.nodeId);
+            if (hist == m_valueHistory.constEnd()) continue;
+            lm.heatLevel = hist->heatLevel();
+        } else {
+            ValueHistory& hist = m_valueHistory[lm.nodeId];
+            hist.record(sample.value);
+            lm.heatLevel = hist.heatLevel();
         }
+        m_scheduler.noteHeat(lm.offsetAddr, uint64_t(sample.size), lm.heatLevel);
     }
+}
 
+// Push m_lastResult to the editors, along with the selection, type names
+// and providers derived from the tree
+void RcxController::presentResult() {
     // Prune stale selections (nodes removed by undo/redo/delete)
     QSet<uint64_t> valid;
     for (uint64_t id : m_selIds) {
@@ -578,7 +695,8 @@ void RcxController::refresh() {
     // Collect unique struct type names for the type picker
     QStringList customTypes;
     QSet<QString> seen;
-    for (const auto& node : m_doc->tree.nodes) {
+    const NodeTree& tree = m_doc->tree;
+    for (const auto& node : tree.nodes) {
         if (node.kind == NodeKind::Struct && !node.structTypeName.isEmpty()) {
             if (!seen.contains(node.structTypeName)) {
                 seen.insert(node.structTypeName);
@@ -590,17 +708,56 @@ void RcxController::refresh() {
     // Resolve providers for disasm popup:
     // - snapProv: snapshot or real — for reading pointer values within the tree
     // - realProv: always the real process provider — for reading code at arbitrary addresses
-    const Provider* snapProv = m_snapshotProv
+    //   (through the document's shared page cache, so repeated hovers don't re-read)
+    std::shared_ptr<Provider> realProv = m_doc->provider ? m_doc->cachedProvider() : nullptr;
+    const Provider* snapProv = m_scrubProv
+        ? static_cast<const Provider*>(m_scrubProv.get())
+        : m_snapshotProv
         ? static_cast<const Provider*>(m_snapshotProv.get())
-        : (m_doc->provider ? m_doc->provider.get() : nullptr);
-    const Provider* realProv = m_doc->provider ? m_doc->provider.get() : nullptr;
+        : realProv.get();
+
+    // A window slide moves element lines; keep the line at the top of the
+    // view, and the one under the cursor, on the same rows
+    auto findLine = [this](const LineMeta& was) {
+        for (int i = 0; i < m_lastResult.meta.size(); i++) {
+            const LineMeta& lm = m_lastResult.meta[i];
+            if (lm.nodeId == was.nodeId && lm.lineKind == was.lineKind
+                && lm.subLine == was.subLine && lm.offsetAddr == was.offsetAddr
+                && lm.arrayElided == 0)
+                return i;
+        }
+        return -1;
+    };
 
     for (auto* editor : m_editors) {
         editor->setCustomTypeNames(customTypes);
         editor->setValueHistoryRef(&m_valueHistory);
         editor->setProviderRef(snapProv, realProv, &m_doc->tree);
         ViewState vs = editor->saveViewState();
-        editor->applyDocument(m_lastResult);
+        // Anchor on a real line, not a placeholder whose range changes
+        LineMeta topWas, cursorWas;
+        int topRow = -1;
+        if (m_slidingWindows) {
+            QPair<int,int> vis = editor->visibleLineRange();
+            for (int line = vis.first; line <= vis.second && topRow < 0; line++) {
+                const LineMeta* lm = editor->metaForLine(line);
+                if (lm && lm->arrayElided == 0) {
+                    topWas = *lm;
+                    topRow = line - vs.scrollLine;
+                }
+            }
+            if (const LineMeta* lm = editor->metaForLine(vs.cursorLine))
+                cursorWas = *lm;
+        }
+        // Patched in place: scroll and cursor never moved
+        if (editor->applyDocument(m_lastResult))
+            continue;
+        if (topRow >= 0) {
+            int line = findLine(topWas);
+            if (line >= 0) vs.scrollLine = qMax(0, line - topRow);
+            line = cursorWas.arrayElided == 0 ? findLine(cursorWas) : -1;
+            if (line >= 0) vs.cursorLine = line;
+        }
         editor->restoreViewState(vs);
     }
     // Text-modifying passes first (command row replaces line 0 text),
@@ -866,6 +1023,11 @@ void RcxController::materializeRefChildren(int nodeIdx) {
 
 void RcxController::applyCommand(const Command& command, bool isUndo) {
     auto& tree = m_doc->tree;
+    m_planStale = true;
+    // A compose in flight indexes the tree as it was; a macro may hold the
+    // refresh that would otherwise cancel it
+    cancelCompose();
+    dropComposeCache();
 
     // Clear value history for nodes whose effective offset changed.
     // When offsets shift (insert/delete/resize), old recorded values came from
@@ -968,7 +1130,7 @@ void RcxController::applyCommand(const Command& command, bool isUndo) {
             // real unchanged value — no optimistic visual leak.
             bool ok = m_snapshotProv
                 ? m_snapshotProv->write(c.addr, bytes.constData(), bytes.size())
-                : m_doc->provider->writeBytes(c.addr, bytes);
+                : m_doc->cachedProvider()->writeBytes(c.addr, bytes);
             if (!ok)
                 qWarning() << "WriteBytes failed at address" << QString::number(c.addr, 16);
         } else if constexpr (std::is_same_v<T, cmd::ChangeArrayMeta>) {
@@ -1006,6 +1168,9 @@ void RcxController::applyCommand(const Command& command, bool isUndo) {
         }
     }, command);
 
+    // Commands edit offsets, kinds and sizes in place
+    tree.invalidateLayout();
+
     if (!m_suppressRefresh)
         refresh();
 }
@@ -1015,6 +1180,9 @@ void RcxController::setNodeValue(int nodeIdx, int subLine, const QString& text,
     if (nodeIdx < 0 || nodeIdx >= m_doc->tree.nodes.size()) return;
     if (!m_doc->provider->isWritable()) return;
 
+    // Edits go to the live target; don't leave the user looking at the past
+    if (m_scrubProv) scrubTo(-1);
+
     const Node& node = m_doc->tree.nodes[nodeIdx];
 
     // Use the compose-resolved address when available (correct for pointer children).
@@ -1067,13 +1235,13 @@ void RcxController::setNodeValue(int nodeIdx, int subLine, const QString& text,
     if (!m_doc->provider->isReadable(addr, writeSize)) return;
 
     // Read old bytes before writing (for undo)
-    QByteArray oldBytes = m_doc->provider->readBytes(addr, writeSize);
+    QByteArray oldBytes = m_doc->cachedProvider()->readBytes(addr, writeSize);
 
     // Test the write first — don't push a command that will silently fail.
     // This prevents optimistic visual updates for read-only providers.
     bool writeOk = m_snapshotProv
         ? m_snapshotProv->write(addr, newBytes.constData(), newBytes.size())
-        : m_doc->provider->writeBytes(addr, newBytes);
+        : m_doc->cachedProvider()->writeBytes(addr, newBytes);
     if (!writeOk) {
         qWarning() << "Write failed at address" << QString::number(addr, 16);
         refresh();  // refresh to show the real unchanged value
@@ -1769,10 +1937,11 @@ void RcxController::updateCommandRow() {
 
     // Build row 2: root class type + name (uses current view root)
     QString row2;
+    const NodeTree& tree = m_doc->tree;
     if (m_viewRootId != 0) {
-        int vi = m_doc->tree.indexOfId(m_viewRootId);
+        int vi = tree.indexOfId(m_viewRootId);
         if (vi >= 0) {
-            const auto& n = m_doc->tree.nodes[vi];
+            const auto& n = tree.nodes[vi];
             QString keyword = n.resolvedClassKeyword();
             QString className = n.structTypeName.isEmpty() ? n.name : n.structTypeName;
             row2 = QStringLiteral("%1 %2 {")
@@ -1781,8 +1950,8 @@ void RcxController::updateCommandRow() {
     }
     if (row2.isEmpty()) {
         // Fallback: find first root struct
-        for (int i = 0; i < m_doc->tree.nodes.size(); i++) {
-            const auto& n = m_doc->tree.nodes[i];
+        for (int i = 0; i < tree.nodes.size(); i++) {
+            const auto& n = tree.nodes[i];
             if (n.parentId == 0 && n.kind == NodeKind::Struct) {
                 QString keyword = n.resolvedClassKeyword();
                 QString className = n.structTypeName.isEmpty() ? n.name : n.structTypeName;
@@ -2342,8 +2511,8 @@ void RcxController::switchToSavedSource(int idx) {
     m_activeSourceIdx = idx;
     const auto& entry = m_savedSources[idx];
 
-    if (entry.kind == QStringLiteral("File")) {
-        m_doc->loadData(entry.filePath);
+    if (entry.kind == QStringLiteral("File") || entry.kind == QStringLiteral("Raw File")) {
+        m_doc->loadData(entry.filePath, entry.kind == QStringLiteral("File"));
         m_doc->tree.baseAddress = entry.baseAddress;
         m_doc->tree.baseAddressFormula = entry.baseAddressFormula;
         refresh();
@@ -2361,18 +2530,19 @@ void RcxController::selectSource(const QString& text) {
     } else if (text.startsWith(QStringLiteral("#saved:"))) {
         int idx = text.mid(7).toInt();
         switchToSavedSource(idx);
-    } else if (text == QStringLiteral("File")) {
+    } else if (text == QStringLiteral("File") || text == QStringLiteral("Raw File")) {
+        // "Raw File" skips the executable layout: file offsets, writable
         auto* w = qobject_cast<QWidget*>(parent());
         QString path = QFileDialog::getOpenFileName(w, "Load Binary Data", {}, "All Files (*)");
         if (!path.isEmpty()) {
             if (m_activeSourceIdx >= 0 && m_activeSourceIdx < m_savedSources.size())
                 m_savedSources[m_activeSourceIdx].baseAddress = m_doc->tree.baseAddress;
 
-            m_doc->loadData(path);
+            m_doc->loadData(path, text == QStringLiteral("File"));
 
             int existingIdx = -1;
             for (int i = 0; i < m_savedSources.size(); i++) {
-                if (m_savedSources[i].kind == QStringLiteral("File")
+                if (m_savedSources[i].kind == text
                     && m_savedSources[i].filePath == path) {
                     existingIdx = i;
                     break;
@@ -2383,7 +2553,7 @@ void RcxController::selectSource(const QString& text) {
                 m_doc->tree.baseAddress = m_savedSources[existingIdx].baseAddress;
             } else {
                 SavedSourceEntry entry;
-                entry.kind = QStringLiteral("File");
+                entry.kind = text;
                 entry.displayName = QFileInfo(path).fileName();
                 entry.filePath = path;
                 entry.baseAddress = m_doc->tree.baseAddress;
@@ -2483,118 +2653,372 @@ void RcxController::pushSavedSourcesToEditors() {
 // ── Auto-refresh ──
 
 void RcxController::setRefreshInterval(int ms) {
-    if (m_refreshTimer)
-        m_refreshTimer->setInterval(qMax(1, ms));
+    m_refreshMs = qMax(1, ms);
+    applyRefreshIntervals();
+}
+
+void RcxController::setAdaptiveRefresh(bool on) {
+    m_adaptiveRefresh = on;
+    applyRefreshIntervals();
+}
+
+// The timer sleeps until the first page worth reading is due (see
+// armRefreshTimer), so backed-off pages cost no ticks.  Dirty tracking
+// already skips clean pages, and its dirty-bit reset is process-wide: a page
+// left out of a tick would lose the bit that says it changed, so every page
+// stays due.
+void RcxController::applyRefreshIntervals() {
+    static constexpr int kFastRefreshMs = 16;
+    bool adaptive = m_adaptiveRefresh && !m_dirtyTracking;
+    m_scheduler.setIntervals(adaptive ? kFastRefreshMs : m_refreshMs, m_refreshMs);
+    armRefreshTimer();
+}
+
+void RcxController::setDirtyTracking(bool on) {
+    m_dirtyTracking = on;
+    m_dirtyBaseline = false;
+    applyRefreshIntervals();
 }
 
 void RcxController::setupAutoRefresh() {
-    int ms = QSettings("Reclass", "Reclass").value("refreshMs", 660).toInt();
+    m_refreshMs = qMax(1, QSettings("Reclass", "Reclass").value("refreshMs", 660).toInt());
+    m_dirtyTracking = QSettings("Reclass", "Reclass").value("softDirtyRefresh", false).toBool();
+    m_adaptiveRefresh = QSettings("Reclass", "Reclass").value("adaptiveRefresh", false).toBool();
+    m_prefetchLines = qMax(0, QSettings("Reclass", "Reclass").value("refreshPrefetchLines", 256).toInt());
+    s_historyOwners.append(this);
+    rebalanceHistory();
+    m_refreshClock.start();
     m_refreshTimer = new QTimer(this);
-    m_refreshTimer->setInterval(qMax(1, ms));
+    m_refreshTimer->setSingleShot(true);
     connect(m_refreshTimer, &QTimer::timeout, this, &RcxController::onRefreshTick);
-    m_refreshTimer->start();
 
     m_refreshWatcher = new QFutureWatcher<PageMap>(this);
     connect(m_refreshWatcher, &QFutureWatcher<PageMap>::finished,
             this, &RcxController::onReadComplete);
+    // After onReadComplete, so the wait counts from the pages just observed
+    connect(m_refreshWatcher, &QFutureWatcher<PageMap>::finished,
+            this, &RcxController::armRefreshTimer);
+    applyRefreshIntervals();
+
+    m_composeWatcher = new QFutureWatcher<ComposeOutput>(this);
+    connect(m_composeWatcher, &QFutureWatcher<ComposeOutput>::finished,
+            this, &RcxController::onComposeDone);
 }
 
-// Recursively collect memory ranges for a struct and its pointer targets.
-// memBase is the absolute address where this struct's data lives.
-void RcxController::collectPointerRanges(
-        uint64_t structId, uint64_t memBase,
-        int depth, int maxDepth,
-        QSet<QPair<uint64_t,uint64_t>>& visited,
-        QVector<QPair<uint64_t,int>>& ranges) const
-{
-    if (depth >= maxDepth) return;
-    QPair<uint64_t,uint64_t> key{structId, memBase};
-    if (visited.contains(key)) return;
-    visited.insert(key);
-
-    int span = m_doc->tree.structSpan(structId);
-    if (span <= 0) return;
-    ranges.append({memBase, span});
-
-    if (!m_snapshotProv) return;
-
-    // Walk children looking for non-collapsed pointers
-    QVector<int> children = m_doc->tree.childrenOf(structId);
-    for (int ci : children) {
-        const Node& child = m_doc->tree.nodes[ci];
-        if (child.kind != NodeKind::Pointer32 && child.kind != NodeKind::Pointer64)
-            continue;
-        if (child.collapsed || child.refId == 0) continue;
+// Scrolling exposes lines whose pages may have been held for a while; fetch
+// them now instead of on the next timer tick.
+void RcxController::onViewportScrolled() {
+    // Restoring the view after a slide scrolls too; one slide per scroll
+    if (!m_slidingWindows && slideArrayWindows()) {
+        m_slidingWindows = true;
+        refresh();
+        m_slidingWindows = false;
+    }
 
-        uint64_t ptrAddr = memBase + child.offset;
-        int ptrSize = child.byteSize();
-        if (!m_snapshotProv->isReadable(ptrAddr, ptrSize)) continue;
+    if (!m_refreshTimer) return;
+    if (m_readInFlight)
+        m_viewportPending = true;
+    else
+        onRefreshTick();
+}
 
-        uint64_t ptrVal = (child.kind == NodeKind::Pointer32)
-            ? (uint64_t)m_snapshotProv->readU32(ptrAddr)
-            : m_snapshotProv->readU64(ptrAddr);
-        if (ptrVal == 0 || ptrVal == UINT64_MAX) continue;
+// Move a long array's window onto `index` and bring that element to the
+// middle of `editor`.  Sliding only follows placeholders as they scroll on
+// screen; this reaches any element of a large array in one step.
+bool RcxController::jumpToArrayElement(RcxEditor* editor, int nodeIdx, int index) {
+    const NodeTree& tree = m_doc->tree;
+    if (nodeIdx < 0 || nodeIdx >= tree.nodes.size()) return false;
+    const Node& node = tree.nodes[nodeIdx];
+    if (node.kind != NodeKind::Array || index < 0 || index >= node.arrayLen) return false;
+    uint64_t arrayId = node.id;
+    int window = arrayWindowSize(node);
+    m_arrayWindows[arrayId] = qBound(0, index - window / 2, qMax(0, node.arrayLen - window));
+    refresh();
 
-        uint64_t pBase = ptrVal;
-        collectPointerRanges(child.refId, pBase, depth + 1, maxDepth,
-                             visited, ranges);
+    // The element's line (primitive element or struct element separator)
+    // sits one level below the array header
+    const QVector<LineMeta>& meta = m_lastResult.meta;
+    int header = -1;
+    for (int i = 0; i < meta.size(); i++) {
+        const LineMeta& lm = meta[i];
+        if (header < 0) {
+            if (lm.nodeId == arrayId && lm.isArrayHeader) header = i;
+            continue;
+        }
+        if (lm.depth <= meta[header].depth) break;
+        if (lm.depth != meta[header].depth + 1 || lm.arrayElided != 0
+            || lm.arrayElementIdx != index) continue;
+        QPair<int,int> vis = editor->visibleLineRange();
+        ViewState vs = editor->saveViewState();
+        vs.cursorLine = i;
+        vs.cursorCol = 0;
+        vs.scrollLine = qMax(0, i - (vis.second - vis.first) / 2);
+        editor->restoreViewState(vs);
+        break;
     }
+    return true;
+}
+
+// Slide the window of each long array whose placeholder line is on screen
+// so the elements it stands for nearest the rendered ones are composed.
+// Returns true if any window moved.
+bool RcxController::slideArrayWindows() {
+    const NodeTree& tree = m_doc->tree;
+    bool moved = false;
+    for (auto* editor : m_editors) {
+        if (!editor->isVisible()) continue;
+        const QPair<int,int> vis = editor->visibleLineRange();
+        for (int line = vis.first; line <= vis.second; line++) {
+            const LineMeta* lm = editor->metaForLine(line);
+            if (!lm) break;
+            if (lm->arrayElided <= 0 || lm->nodeIdx < 0
+                || lm->nodeIdx >= tree.nodes.size()) continue;
+            const Node& node = tree.nodes[lm->nodeIdx];
+            int window = arrayWindowSize(node);
+            // The placeholder before the window ends at the element just
+            // above it; the one after starts just below it.  With both on
+            // screen the later one wins, so scrolling down keeps going.
+            int edge = lm->arrayElementIdx == 0 ? lm->arrayElided - 1 : lm->arrayElementIdx;
+            int start = qBound(0, edge - window / 2, qMax(0, node.arrayLen - window));
+            if (m_arrayWindows.value(node.id, -1) != start) {
+                m_arrayWindows[node.id] = start;
+                moved = true;
+            }
+        }
+    }
+    return moved;
+}
 
-    // Embedded struct references (struct node with refId but no own children)
-    int idx = m_doc->tree.indexOfId(structId);
-    if (idx >= 0) {
-        const Node& sn = m_doc->tree.nodes[idx];
-        if (sn.kind == NodeKind::Struct && sn.refId != 0 && children.isEmpty())
-            collectPointerRanges(sn.refId, memBase, depth, maxDepth,
-                                 visited, ranges);
+// Pages under the lines each visible editor shows, plus m_prefetchLines on
+// either side.  Returns false when no editor is on screen (hidden tab,
+// headless use), in which case the whole plan is refreshed.
+bool RcxController::collectViewportPages(QSet<uint64_t>& pages) const {
+    static constexpr uint64_t kPageMask = ~uint64_t(4095);
+    const NodeTree& tree = m_doc->tree;
+    bool any = false;
+    for (auto* editor : m_editors) {
+        if (!editor->isVisible()) continue;
+        any = true;
+        QPair<int, int> vis = editor->visibleLineRange();
+        int first = qMax(0, vis.first - m_prefetchLines);
+        int last = vis.second + m_prefetchLines;
+        for (int line = first; line <= last; line++) {
+            const LineMeta* lm = editor->metaForLine(line);
+            if (!lm) break;
+            if (isSyntheticLine(*lm) || lm->nodeIdx < 0
+                || lm->nodeIdx >= tree.nodes.size()) continue;
+            const Node& node = tree.nodes[lm->nodeIdx];
+            // Container headers show no bytes of their own; their fields
+            // have lines of their own
+            int len = lm->lineByteCount;
+            if (len <= 0)
+                len = lm->isArrayElement ? sizeForKind(lm->elementKind)
+                    : (node.kind == NodeKind::Struct || node.kind == NodeKind::Array)
+                        ? 1 : node.byteSize();
+            uint64_t end = lm->offsetAddr + uint64_t(qMax(len, 1));
+            for (uint64_t p = lm->offsetAddr & kPageMask; p < end; p += 4096)
+                pages.insert(p);
+        }
     }
+    return any;
+}
+
+// Extent and pointer layout behind every refresh tick.  Building them walks
+// the whole tree, so the plan is kept until the tree is edited
+// (applyCommand, document reload), the source changes or the view moves to
+// another root; the base address is patched in on each call.
+const ChasePlan& RcxController::refreshPlan() {
+    const NodeTree& tree = m_doc->tree;
+    uint64_t rootId = m_viewRootId;
+    if (rootId == 0 && !tree.nodes.isEmpty())
+        rootId = tree.nodes[0].id;
+    if (m_planStale || m_plan.rootId != rootId) {
+        m_plan = ChasePlan::build(tree, rootId, 0, computeDataExtent());
+        m_planStale = false;
+        m_predictStale = true;
+    }
+    m_plan.rootBase = tree.baseAddress;
+    return m_plan;
 }
 
 void RcxController::onRefreshTick() {
+    startRefreshRead();
+    armRefreshTimer();
+}
+
+// Sleep until the first page a tick would read is due.  With adaptive
+// polling off every page is due each interval; with it on, quiet pages
+// back off and the timer wakes only when there is something to read.
+// While a read is in flight the timer stays off; its completion re-arms it.
+void RcxController::armRefreshTimer() {
+    if (!m_refreshTimer || m_readInFlight) return;
+    int wait = m_pollPages.isEmpty()
+        ? m_scheduler.slowMs()
+        : m_scheduler.msUntilDue(m_pollPages, m_refreshClock.elapsed());
+    m_refreshTimer->start(qBound(m_scheduler.fastMs(), wait, m_scheduler.slowMs()));
+}
+
+void RcxController::startRefreshRead() {
     if (m_readInFlight) return;
     if (!m_doc->provider || !m_doc->provider->isLive()) return;
     if (m_suppressRefresh) return;
     for (auto* editor : m_editors)
         if (editor->isEditing()) return;
 
-    int extent = computeDataExtent();
-    if (extent <= 0) return;
-
-    // Collect all needed ranges: main struct + pointer targets (absolute addresses)
-    QVector<QPair<uint64_t,int>> ranges;
-    ranges.append({m_doc->tree.baseAddress, extent});
-
-    if (m_snapshotProv) {
-        QSet<QPair<uint64_t,uint64_t>> visited;
-        uint64_t rootId = m_viewRootId;
-        if (rootId == 0 && !m_doc->tree.nodes.isEmpty())
-            rootId = m_doc->tree.nodes[0].id;
-        collectPointerRanges(rootId, m_doc->tree.baseAddress, 0, 99, visited, ranges);
+    const ChasePlan& chase = refreshPlan();
+    if (chase.rootExtent <= 0) return;
+
+    // Predict the pages this tick needs (main struct + pointer targets,
+    // absolute addresses) by walking the plan through the last snapshot.
+    // The prediction only decides what is due; the worker follows the
+    // pointers again through the pages it reads.  Of those, only the pages
+    // the scheduler says are due are read; the rest are carried over from
+    // the last snapshot.  A page with nothing to carry (first seen, or
+    // dropped by a failed read) is read.
+    static constexpr uint64_t kPageSize = ChasePlan::kPageSize;
+    // The prediction only moves with the plan, its base or the snapshot
+    if (m_predictStale || m_predictBase != chase.rootBase) {
+        m_predicted = chase.predict(m_prevPages);
+        m_predictBase = chase.rootBase;
+        m_predictStale = false;
+    }
+    const QVector<uint64_t>& planned = m_predicted;
+    // Pages off screen are held as last read; pages that just scrolled into
+    // the band are read now whatever the scheduler says.
+    const QVector<uint64_t> due = m_scheduler.due(planned, m_refreshClock.elapsed());
+    QSet<uint64_t> band;
+    const bool banded = collectViewportPages(band);
+    QVector<uint64_t> pageAddrs;
+    PageMap carried;
+    bool exposed = false;
+    int di = 0;
+    m_pollPages.clear();
+    for (uint64_t p : planned) {
+        bool isDue = di < due.size() && due[di] == p;
+        if (isDue) di++;
+        auto it = m_prevPages.constFind(p);
+        bool read = true;
+        bool held = false;
+        if (it != m_prevPages.constEnd()) {
+            held = banded && !band.contains(p);
+            if (held)
+                read = false;
+            else if (banded && !m_viewportBand.contains(p))
+                exposed = true;
+            else
+                read = isDue;
+        }
+        if (!held)
+            m_pollPages.append(p);
+        if (read)
+            pageAddrs.append(p);
+        else
+            carried.insert(p, it.value());
     }
+    if (banded)
+        m_viewportBand = std::move(band);
+    else
+        m_viewportBand.clear();
+    if (pageAddrs.isEmpty()) return;
+    m_tickPages = pageAddrs;
 
     m_readInFlight = true;
     m_readGen = m_refreshGen;
 
+    // Dirty-page mode: reuse clean pages from the previous snapshot.  A
+    // full re-read every kDirtyFullRefreshMs picks up any write that slipped
+    // between the provider's dirty query and its reset.
+    static constexpr qint64 kDirtyFullRefreshMs = 2000;
+    PageMap prevPages;
+    if (m_dirtyTracking) {
+        // Pages held off screen missed the dirty-bit resets while away
+        bool full = !m_dirtyBaseline || exposed || !m_fullRefreshAge.isValid()
+                 || m_fullRefreshAge.elapsed() >= kDirtyFullRefreshMs;
+        if (full)
+            m_fullRefreshAge.start();
+        else
+            prevPages = m_prevPages;
+    }
+
     auto prov = m_doc->provider;
-    m_refreshWatcher->setFuture(QtConcurrent::run([prov, ranges]() -> PageMap {
-        constexpr uint64_t kPageSize = 4096;
-        constexpr uint64_t kPageMask = ~(kPageSize - 1);
-        PageMap pages;
-        for (const auto& r : ranges) {
-            uint64_t pageStart = r.first & kPageMask;
-            uint64_t end = r.first + r.second;
-            uint64_t pageEnd = (end + kPageSize - 1) & kPageMask;
-            for (uint64_t p = pageStart; p < pageEnd; p += kPageSize) {
-                if (!pages.contains(p))
-                    pages[p] = prov->readBytes(p, static_cast<int>(kPageSize));
+    CancelToken token = m_refreshGen.token();
+    m_refreshWatcher->setFuture(QtConcurrent::run(
+            [prov, chase, pageAddrs, carried, prevPages, token]() mutable -> PageMap {
+        // The layout or source changed after this tick was queued; the
+        // result would be dropped anyway, so skip the I/O.
+        if (token.isCancelled()) return {};
+
+        // Pages outside the target's region map (garbage pointers) are
+        // dropped rather than costing a failed read; the snapshot reports
+        // them as unreadable.
+        const QVector<MemoryRegion> regs = prov->regions();
+        auto mapped = [&](uint64_t p) {
+            return regs.isEmpty() || regionsCover(regs, p, kPageSize);
+        };
+
+        // Pages that need no read: those carried over, plus in dirty-page
+        // mode the due pages the target has not written since the last
+        // tick.  The dirty query re-arms tracking, so it is asked once,
+        // for the whole predicted set, before the first round.
+        PageMap pool = std::move(carried);
+        if (!prevPages.isEmpty() && !pageAddrs.isEmpty()) {
+            pageAddrs.erase(std::remove_if(pageAddrs.begin(), pageAddrs.end(),
+                [&](uint64_t p) { return !mapped(p); }), pageAddrs.end());
+            QVector<bool> dirty(pageAddrs.size(), true);
+            if (prov->dirtyPages(pageAddrs.constData(), pageAddrs.size(), dirty.data())) {
+                for (int i = 0; i < pageAddrs.size(); i++) {
+                    auto it = prevPages.constFind(pageAddrs[i]);
+                    if (!dirty[i] && it != prevPages.constEnd())
+                        pool.insert(pageAddrs[i], it.value());
+                }
             }
         }
+
+        // Follow pointers through the pages as they arrive: the root range,
+        // then the targets found in it, and so on.  Each round is one batch,
+        // split across threads when the provider allows it.
+        PageMap pages = chase.run([&](const QVector<uint64_t>& want, PageMap& into) {
+            if (token.isCancelled()) return;
+            QVector<uint64_t> toRead;
+            toRead.reserve(want.size());
+            for (uint64_t p : want) {
+                auto it = pool.find(p);
+                if (it != pool.end()) {
+                    into.insert(p, it.value());
+                    pool.erase(it);
+                } else if (mapped(p)) {
+                    toRead.append(p);
+                }
+            }
+
+            QVector<QByteArray> bufs(toRead.size());
+            QVector<ReadRequest> reqs(toRead.size());
+            for (int i = 0; i < toRead.size(); i++) {
+                bufs[i] = QByteArray(static_cast<int>(kPageSize), Qt::Uninitialized);
+                reqs[i].addr = toRead[i];
+                reqs[i].buf  = bufs[i].data();
+                reqs[i].len  = static_cast<int>(kPageSize);
+            }
+            readBatchParallel(*prov, reqs.data(), reqs.size(), token);
+            for (int i = 0; i < toRead.size(); i++)
+                into.insert(toRead[i], bufs[i]);
+        });
+
+        if (token.isCancelled()) return {};
         return pages;
     }));
 }
 
 void RcxController::onReadComplete() {
     m_readInFlight = false;
+    if (m_viewportPending) {
+        m_viewportPending = false;
+        QTimer::singleShot(0, this, &RcxController::onRefreshTick);
+    }
+
+    // Any result we drop breaks the chain of dirty-bit resets, so the next
+    // dirty-tracked tick must start over with a full read.
+    m_dirtyBaseline = false;
 
     if (m_readGen != m_refreshGen) return;
 
@@ -2622,51 +3046,216 @@ void RcxController::onReadComplete() {
         }
     }
 
-    // Fast path: no changes at all
-    if (newPages == m_prevPages)
+    m_dirtyBaseline = true;
+    m_predictStale = true;
+
+    // Byte-level changes for highlighting.  Nothing to compare against on
+    // the first snapshot.
+    PageChanges changes;
+    bool identical = m_differ.diff(m_prevPages, newPages, changes);
+
+    // Pages read this tick speed up if they changed and back off if not.
+    // A page that failed to read backs off too; it is retried on every tick
+    // regardless, but does not wake the timer at the fast rate on its own.
+    qint64 now = m_refreshClock.elapsed();
+    for (uint64_t p : m_tickPages)
+        m_scheduler.observe(p, newPages.contains(p)
+                            && changes.anyChanged(p, PageChanges::kPageSize), now);
+
+    // Fast path: no changes at all.  Keep the new copy; its pages are the
+    // ones the differ remembered hashes for.
+    if (identical && !m_prevPages.isEmpty()) {
+        m_prevPages = std::move(newPages);
+        return;
+    }
+    if (newPages.isEmpty() && m_prevPages.isEmpty())
         return;
 
-    // Compute which byte offsets changed (for change highlighting).
-    // Skip on first snapshot — nothing to compare against.
-    m_changedOffsets.clear();
-    if (!m_prevPages.isEmpty()) {
-        for (auto it = newPages.constBegin(); it != newPages.constEnd(); ++it) {
-            uint64_t pageAddr = it.key();
-            const QByteArray& newPage = it.value();
-            auto oldIt = m_prevPages.constFind(pageAddr);
-            if (oldIt == m_prevPages.constEnd())
-                continue;   // new page, no previous data to diff against
-            const QByteArray& oldPage = oldIt.value();
-            int cmpLen = qMin(oldPage.size(), newPage.size());
-            for (int i = 0; i < cmpLen; ++i) {
-                if (oldPage[i] != newPage[i])
-                    m_changedOffsets.insert(static_cast<int64_t>(pageAddr) + i);
-            }
-        }
+    // Record the new state; frames dropped for budget shift the scrub index
+    if (m_history.budget() > 0) {
+        int dropped = m_history.push(newPages, QDateTime::currentMSecsSinceEpoch());
+        if (m_scrubFrame >= 0)
+            m_scrubFrame = qMax(0, m_scrubFrame - dropped);
+        emit historyChanged();
+    }
+
+    int mainExtent = refreshPlan().rootExtent;
+
+    // While scrubbing, keep tracking live memory but leave the view alone
+    if (m_scrubProv) {
+        m_prevPages = newPages;
+        if (m_snapshotProv)
+            m_snapshotProv->updatePages(std::move(newPages), mainExtent);
+        return;
     }
 
-    int mainExtent = computeDataExtent();
+    bool coverTick = !m_prevPages.isEmpty();
     m_prevPages = newPages;
 
     if (m_snapshotProv)
         m_snapshotProv->updatePages(std::move(newPages), mainExtent);
     else
         m_snapshotProv = std::make_unique<SnapshotProvider>(
-            m_doc->provider, std::move(newPages), mainExtent);
+            m_doc->cachedProvider(), std::move(newPages), mainExtent);
+
+    refreshAsync(std::move(changes), coverTick);
+}
+
+// Live ticks compose on a worker, so a large view never stalls typing or
+// scrolling.  The worker gets its own copy of the tree (implicitly shared
+// until the UI edits it) and of this tick's pages, frozen; the UI thread
+// only applies the result.  A tick arriving while a compose runs cancels it
+// and is composed as soon as the worker lets go.
+void RcxController::refreshAsync(PageChanges changes, bool coverTick) {
+    if (m_composeBusy) {
+        ++m_composeGen;
+        m_composePending = true;
+        m_pendingChanges = std::move(changes);
+        return;
+    }
+    m_composeBusy = true;
+
+    // Build the layout index here so the copy shares it instead of
+    // rebuilding it on the worker
+    m_doc->tree.layoutIndex();
+    NodeTree tree = m_doc->tree;
+    std::shared_ptr<Provider> real = m_doc->cachedProvider();
+    PageMap pages = m_snapshotProv->pages();
+    int extent = refreshPlan().rootExtent;
+    QHash<NodeKind, QString> aliases = m_doc->typeAliases;
+    QHash<uint64_t, ValueHistory> history = m_valueHistory;
+    bool track = m_trackValues && m_snapshotProv->isLive();
+    uint64_t viewRootId = m_viewRootId;
+    ArrayWindows windows = m_arrayWindows;
+    std::shared_ptr<ComposeCache> cache = m_composeCache;
+    m_composeIssued = m_composeGen;
+    CancelToken token = m_composeGen.token();
+
+    m_composeWatcher->setFuture(QtConcurrent::run(
+            [tree, real, pages, extent, aliases, history, track, viewRootId, windows,
+             cache, changes = std::move(changes), coverTick, token]() -> ComposeOutput {
+        ComposeOutput out;
+        SnapshotProvider snap(real, pages, extent);
+        snap.freeze();
+
+        s_composeAliases = &aliases;
+        out.result = rcx::compose(tree, snap, viewRootId, *cache, windows, token);
+        s_composeAliases = nullptr;
+        if (token.isCancelled()) return out;
+
+        markChangedLines(out.result, tree, changes);
+        if (track) {
+            out.samples = sampleValues(out.result, tree, snap, changes, coverTick, history);
+            out.sampled = true;
+        }
+        return out;
+    }));
+}
+
+void RcxController::onComposeDone() {
+    m_composeBusy = false;
+    if (m_composeIssued == m_composeGen) {
+        ComposeOutput out = m_composeWatcher->result();
+        m_lastResult = std::move(out.result);
+        if (out.sampled)
+            applyHeat(out.samples);
+        presentResult();
+    }
+    if (m_composePending) {
+        m_composePending = false;
+        // The tick before it was never shown, so its diff does not cover
+        // the values on record
+        PageChanges changes = std::move(m_pendingChanges);
+        m_pendingChanges.clear();
+        refreshAsync(std::move(changes), false);
+    }
+}
+
+// A compose in flight is older than whatever the caller shows next
+void RcxController::cancelCompose() {
+    if (!m_composeBusy) return;
+    ++m_composeGen;
+    m_composePending = false;
+    m_pendingChanges.clear();
+    // The worker may still be reading the cache
+    dropComposeCache();
+}
+
+// Start over with an empty cache.  The old one may still be in use by a
+// compose in flight, so it is let go rather than cleared.
+void RcxController::dropComposeCache() {
+    m_composeCache = std::make_shared<ComposeCache>();
+}
+
+QVector<RcxController*> RcxController::s_historyOwners;
+qint64 RcxController::s_historyBudget = -1;
+
+qint64 RcxController::historyBudget() {
+    if (s_historyBudget < 0)
+        s_historyBudget = qMax<qint64>(0, QSettings("Reclass", "Reclass")
+                              .value("historyBudgetMB", 256).toLongLong()) * 1024 * 1024;
+    return s_historyBudget;
+}
+
+void RcxController::setHistoryBudget(qint64 bytes) {
+    s_historyBudget = qMax<qint64>(0, bytes);
+    rebalanceHistory();
+}
+
+// Each open controller records up to an equal share of the global budget,
+// so opening more tabs does not multiply the memory history may hold.
+void RcxController::rebalanceHistory() {
+    if (s_historyOwners.isEmpty()) return;
+    const qint64 share = historyBudget() / s_historyOwners.size();
+    for (RcxController* c : s_historyOwners)
+        c->applyHistoryShare(share);
+}
+
+void RcxController::applyHistoryShare(qint64 bytes) {
+    if (bytes == m_history.budget()) return;
+    int dropped = m_history.setBudget(bytes);
+    if (bytes <= 0) {
+        m_history.clear();
+        if (m_scrubProv) scrubTo(-1);
+    } else if (m_scrubFrame >= 0) {
+        m_scrubFrame = qMax(0, m_scrubFrame - dropped);
+    }
+    emit historyChanged();
+}
+
+void RcxController::scrubTo(int frame) {
+    if (frame >= m_history.count()) frame = -1;
+    if (frame == m_scrubFrame) return;
+
+    m_scrubFrame = frame;
+    m_changes.clear();
+    if (frame < 0) {
+        m_scrubProv.reset();
+    } else {
+        PageMap pages = m_history.pagesAt(frame);
+        // Highlight what this frame changed relative to the one before it
+        if (frame > 0)
+            PageDiffer().diff(m_history.pagesAt(frame - 1), pages, m_changes);
+        m_scrubProv = std::make_unique<SnapshotProvider>(
+            m_doc->cachedProvider(), std::move(pages), refreshPlan().rootExtent);
+        m_scrubProv->freeze();
+    }
 
     refresh();
-    m_changedOffsets.clear();
+    m_changes.clear();
+    emit historyChanged();
 }
 
 int RcxController::computeDataExtent() const {
     static constexpr int64_t kMaxMainExtent = 16 * 1024 * 1024; // 16 MB cap
 
+    const NodeTree& tree = m_doc->tree;
     int64_t treeExtent = 0;
-    for (int i = 0; i < m_doc->tree.nodes.size(); i++) {
-        const Node& node = m_doc->tree.nodes[i];
-        int64_t off = m_doc->tree.computeOffset(i);
+    for (int i = 0; i < tree.nodes.size(); i++) {
+        const Node& node = tree.nodes[i];
+        int64_t off = tree.computeOffset(i);
         int sz = (node.kind == NodeKind::Struct || node.kind == NodeKind::Array)
-            ? m_doc->tree.structSpan(node.id) : node.byteSize();
+            ? tree.structSpan(node.id) : node.byteSize();
         int64_t end = off + sz;
         if (end > treeExtent) treeExtent = end;
     }
@@ -2682,8 +3271,21 @@ void RcxController::resetSnapshot() {
     m_readInFlight = false;
     m_snapshotProv.reset();
     m_prevPages.clear();
-    m_changedOffsets.clear();
+    m_predictStale = true;
+    m_pollPages.clear();
+    m_viewportBand.clear();
+    m_planStale = true;
+    cancelCompose();
+    dropComposeCache();
+    m_dirtyBaseline = false;
+    m_changes.clear();
+    m_differ.reset();
+    m_scheduler.reset();
     m_valueHistory.clear();
+    m_history.clear();
+    m_scrubProv.reset();
+    m_scrubFrame = -1;
+    emit historyChanged();
 }
 
 void RcxController::handleMarginClick(RcxEditor* editor, int margin,
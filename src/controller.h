@@ -1,13 +1,21 @@
 #pragma once
 #include "core.h"
 #include "editor.h"
+#include "pointer_chase.h"
 #include "providers/snapshot_provider.h"
+#include "providers/snapshot_history.h"
+#include "providers/mapped_file_provider.h"
+#include "providers/image_provider.h"
+#include "providers/caching_provider.h"
+#include "providers/page_diff.h"
+#include "providers/refresh_scheduler.h"
 #include <QObject>
 #include <QUndoStack>
 #include <QUndoCommand>
 #include <QTimer>
 #include <QFutureWatcher>
 #include <QPointer>
+#include <QElapsedTimer>
 #include <memory>
 
 namespace rcx {
@@ -17,6 +25,16 @@ class TypeSelectorPopup;
 struct TypeEntry;
 enum class TypePopupMode;
 
+// A live refresh's compose and the values sampled for the heatmap, built
+// together on a worker.  A null sample value means the bytes did not change
+// this tick: the heat comes from the recorded history instead.
+struct ComposeOutput {
+    struct Sample { int line; int size; QString value; };
+    ComposeResult   result;
+    QVector<Sample> samples;
+    bool            sampled = false;   // values tracked against a live source
+};
+
 // ── Document ──
 
 class RcxDocument : public QObject {
@@ -40,14 +58,25 @@ public:
         return m ? QString::fromLatin1(m->typeName) : QStringLiteral("???");
     }
 
-    ComposeResult compose(uint64_t viewRootId = 0) const;
+    ComposeResult compose(uint64_t viewRootId = 0, const ArrayWindows& windows = {}) const;
     bool save(const QString& path);
     bool load(const QString& path);
-    void loadData(const QString& binaryPath);
+    // asImage: lay ELF/PE files out at their virtual addresses (read-only).
+    // Off maps the file flat and writable, at its raw file offsets.
+    void loadData(const QString& binaryPath, bool asImage = true);
     void loadData(const QByteArray& data);
 
+    // Shared page cache over `provider` for point reads that bypass the
+    // refresh snapshot (hover disasm, struct preview, MCP, value edits).
+    // Same object as `provider` for non-live sources.
+    std::shared_ptr<Provider> cachedProvider();
+
 signals:
     void documentChanged();
+
+private:
+    std::shared_ptr<Provider> m_cache;
+    const Provider*           m_cacheSource = nullptr;
 };
 
 // ── Undo command ──
@@ -65,7 +94,7 @@ private:
 // ── Saved source entry ──
 
 struct SavedSourceEntry {
-    QString kind;          // "File" or provider identifier (e.g. "processmemory")
+    QString kind;          // "File", "Raw File" or provider identifier (e.g. "processmemory")
     QString displayName;   // filename or process name
     QString filePath;      // for File sources
     QString providerTarget; // for plugin providers (e.g. "pid:name")
@@ -120,8 +149,36 @@ public:
     void scrollToNodeId(uint64_t nodeId);
 
     RcxDocument* document() const { return m_doc; }
+    // Replaces the document's type aliases; cached lines carry the old names
+    void setTypeAliases(const QHash<NodeKind, QString>& aliases);
     void setEditorFont(const QString& fontName);
     void setRefreshInterval(int ms);
+    // Re-read only pages the target wrote since the last tick, when the
+    // provider can tell (Linux soft-dirty).  Off by default.
+    void setDirtyTracking(bool on);
+    bool dirtyTracking() const { return m_dirtyTracking; }
+    // Poll pages that change at up to 60 Hz and back static ones off to the
+    // refresh interval.  Off by default: every page is read every interval.
+    void setAdaptiveRefresh(bool on);
+    bool adaptiveRefresh() const { return m_adaptiveRefresh; }
+    const RefreshScheduler& refreshScheduler() const { return m_scheduler; }
+    // While an editor is on screen, only the pages under its visible lines
+    // and this many lines above and below are re-read; the rest of the
+    // snapshot is held until it scrolls into view.
+    void setRefreshPrefetch(int lines) { m_prefetchLines = qMax(0, lines); }
+    int  refreshPrefetch() const { return m_prefetchLines; }
+
+    // Time-travel: every refresh that changes memory is recorded in a
+    // delta-compressed history.  scrubTo() recomposes the view against a
+    // past frame (0 = oldest); -1 returns to the live view.  The budget
+    // covers every open controller and is split evenly between them; 0
+    // turns recording off.
+    const SnapshotHistory& history() const { return m_history; }
+    static void setHistoryBudget(qint64 bytes);
+    static qint64 historyBudget();
+    void scrubTo(int frame);
+    int  scrubFrame() const { return m_scrubFrame; }
+    bool isScrubbing() const { return m_scrubFrame >= 0; }
 
     // MCP bridge accessors
     void setSuppressRefresh(bool v) { m_suppressRefresh = v; }
@@ -145,6 +202,8 @@ public:
 signals:
     void nodeSelected(int nodeIdx);
     void selectionChanged(int count);
+    // Emitted when a frame is recorded or dropped, or the scrub position moves
+    void historyChanged();
 
 private:
     RcxDocument*       m_doc;
@@ -168,12 +227,48 @@ private:
     QFutureWatcher<PageMap>* m_refreshWatcher = nullptr;
     std::unique_ptr<SnapshotProvider> m_snapshotProv;
     PageMap         m_prevPages;
-    QSet<int64_t>   m_changedOffsets;
+    PageChanges     m_changes;           // bytes changed by the tick being shown
+    PageDiffer      m_differ;
+    bool            m_changesCoverTick = false;  // m_changes is a full diff against the last tick
     QHash<uint64_t, ValueHistory> m_valueHistory;
     bool            m_trackValues = false;
-    uint64_t        m_refreshGen = 0;
+    Generation      m_refreshGen;     // bumped on layout/source change; cancels reads in flight
     uint64_t        m_readGen = 0;
     bool            m_readInFlight = false;
+    bool            m_dirtyTracking = false;
+    bool            m_dirtyBaseline = false;   // m_prevPages matches the last dirty-bit reset
+    QElapsedTimer   m_fullRefreshAge;
+    RefreshScheduler m_scheduler;
+    QElapsedTimer   m_refreshClock;
+    QVector<uint64_t> m_tickPages;     // pages the read in flight fetches
+    int             m_refreshMs = 660;
+    bool            m_adaptiveRefresh = false;
+    int             m_prefetchLines = 256;
+    QSet<uint64_t>  m_viewportBand;    // pages on screen (plus prefetch) at the last tick
+    bool            m_viewportPending = false;  // scrolled while a read was in flight
+    QVector<uint64_t> m_predicted;     // plan walked through m_prevPages
+    bool            m_predictStale = true;   // plan or m_prevPages changed since
+    uint64_t        m_predictBase = 0;
+    QVector<uint64_t> m_pollPages;     // pages a tick reads once they are due
+    ChasePlan       m_plan;            // extent + pointer layout of the view root
+    bool            m_planStale = true;   // tree edited since m_plan was built
+    // Rendered fields reused across live refreshes.  Shared with the compose
+    // in flight; dropped for a fresh one rather than cleared under it.
+    std::shared_ptr<ComposeCache> m_composeCache = std::make_shared<ComposeCache>();
+    QFutureWatcher<ComposeOutput>* m_composeWatcher = nullptr;
+    Generation      m_composeGen;      // bumped by any newer refresh; cancels the compose in flight
+    uint64_t        m_composeIssued = 0;
+    bool            m_composeBusy = false;     // a compose result is still to come
+    bool            m_composePending = false;  // a tick arrived while composing
+    PageChanges     m_pendingChanges;
+    ArrayWindows    m_arrayWindows;    // slid windows of long arrays (see kArrayWindow)
+    bool            m_slidingWindows = false;  // recomposing for a window slide
+    SnapshotHistory m_history;
+    std::unique_ptr<SnapshotProvider> m_scrubProv;   // frozen past frame while scrubbing
+    int             m_scrubFrame = -1;
+
+    static QVector<RcxController*> s_historyOwners;   // controllers sharing the budget
+    static qint64                  s_historyBudget;   // bytes; -1 until read from settings
 
     QVector<RcxDocument*>* m_projectDocs = nullptr;
 
@@ -187,14 +282,26 @@ private:
 
     // ── Auto-refresh methods ──
     void setupAutoRefresh();
+    void applyHistoryShare(qint64 bytes);
+    static void rebalanceHistory();
     void onRefreshTick();
+    void startRefreshRead();
+    void armRefreshTimer();
     void onReadComplete();
+    void refreshAsync(PageChanges changes, bool coverTick);
+    void onComposeDone();
+    void cancelCompose();
+    void dropComposeCache();
+    void applyHeat(const QVector<ComposeOutput::Sample>& samples);
+    void presentResult();
     int  computeDataExtent() const;
+    const ChasePlan& refreshPlan();
     void resetSnapshot();
-    void collectPointerRanges(uint64_t structId, uint64_t memBase,
-                              int depth, int maxDepth,
-                              QSet<QPair<uint64_t,uint64_t>>& visited,
-                              QVector<QPair<uint64_t,int>>& ranges) const;
+    void applyRefreshIntervals();
+    void onViewportScrolled();
+    bool slideArrayWindows();
+    bool jumpToArrayElement(RcxEditor* editor, int nodeIdx, int index);
+    bool collectViewportPages(QSet<uint64_t>& pages) const;
 };
 
 } // namespace rcx
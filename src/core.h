@@ -271,6 +271,23 @@ struct NodeTree {
     uint64_t      m_nextId    = 1;
     mutable QHash<uint64_t, int> m_idCache;
 
+    // ── Layout index ──
+    // Child lists, and per node its offset from its root and its depth,
+    // built together in one pass on first use; container spans are
+    // memoized on demand.  The index is stamped with the tree generation it
+    // was built for.  addNode() and invalidateIdCache() move the generation;
+    // code that edits offset, kind, arrayLen, parentId or refId in place
+    // through `nodes` must call invalidateLayout() afterwards.
+    struct LayoutIndex {
+        uint64_t generation = 0;
+        QHash<uint64_t, QVector<int>> children;  // parentId -> indices, ascending
+        QVector<int64_t> offsets;                // own offset + every ancestor's
+        QVector<int>     depths;
+        QHash<uint64_t, int> spans;              // structSpan results so far
+    };
+    mutable uint64_t    m_generation = 1;
+    mutable LayoutIndex m_layoutIndex;
+
     int addNode(const Node& n) {
         Node copy = n;
         if (copy.id == 0) copy.id = m_nextId++;
@@ -279,13 +296,17 @@ struct NodeTree {
         nodes.append(copy);
         if (!m_idCache.isEmpty())
             m_idCache[copy.id] = idx;
+        invalidateLayout();
         return idx;
     }
 
     // Reserve a unique ID atomically (for use before pushing undo commands)
     uint64_t reserveId() { return m_nextId++; }
 
-    void invalidateIdCache() const { m_idCache.clear(); }
+    // Drops the id lookup and the layout index
+    void invalidateIdCache() const { m_idCache.clear(); invalidateLayout(); }
+    void invalidateLayout() const { ++m_generation; }
+    uint64_t generation() const { return m_generation; }
 
     int indexOfId(uint64_t id) const {
         if (m_idCache.isEmpty() && !nodes.isEmpty()) {
@@ -295,23 +316,22 @@ struct NodeTree {
         return m_idCache.value(id, -1);
     }
 
+    const LayoutIndex& layoutIndex() const {
+        if (m_layoutIndex.generation != m_generation)
+            buildLayoutIndex();
+        return m_layoutIndex;
+    }
+
     QVector<int> childrenOf(uint64_t parentId) const {
-        QVector<int> result;
-        for (int i = 0; i < nodes.size(); i++) {
-            if (nodes[i].parentId == parentId) result.append(i);
-        }
-        return result;
+        return layoutIndex().children.value(parentId);
     }
 
     // Collect node + all descendants (iterative, cycle-safe)
     QVector<int> subtreeIndices(uint64_t nodeId) const {
         int idx = indexOfId(nodeId);
         if (idx < 0) return {};
-        // Build parent→children map
-        QHash<uint64_t, QVector<int>> childMap;
-        for (int i = 0; i < nodes.size(); i++)
-            childMap[nodes[i].parentId].append(i);
-        // BFS with visited guard
+        const auto& childMap = layoutIndex().children;
+        // DFS with visited guard
         QVector<int> result;
         QSet<uint64_t> visited;
         QVector<uint64_t> stack;
@@ -320,7 +340,9 @@ struct NodeTree {
         visited.insert(nodeId);
         while (!stack.isEmpty()) {
             uint64_t pid = stack.takeLast();
-            for (int ci : childMap.value(pid)) {
+            auto kids = childMap.constFind(pid);
+            if (kids == childMap.constEnd()) continue;
+            for (int ci : *kids) {
                 uint64_t cid = nodes[ci].id;
                 if (!visited.contains(cid)) {
                     visited.insert(cid);
@@ -333,65 +355,22 @@ struct NodeTree {
     }
 
     int depthOf(int idx) const {
-        int d = 0;
-        QSet<uint64_t> visited;
-        int cur = idx;
-        while (cur >= 0 && cur < nodes.size() && nodes[cur].parentId != 0) {
-            uint64_t nid = nodes[cur].id;
-            if (visited.contains(nid)) break;
-            visited.insert(nid);
-            cur = indexOfId(nodes[cur].parentId);
-            if (cur < 0) break;
-            d++;
-        }
-        return d;
+        if (idx < 0 || idx >= nodes.size()) return 0;
+        return layoutIndex().depths[idx];
     }
 
     int64_t computeOffset(int idx) const {
-        int64_t total = 0;
-        QSet<uint64_t> visited;
-        int cur = idx;
-        while (cur >= 0 && cur < nodes.size()) {
-            uint64_t nid = nodes[cur].id;
-            if (visited.contains(nid)) break;
-            visited.insert(nid);
-            total += nodes[cur].offset;
-            if (nodes[cur].parentId == 0) break;
-            cur = indexOfId(nodes[cur].parentId);
-        }
-        return total;
+        if (idx < 0 || idx >= nodes.size()) return 0;
+        return layoutIndex().offsets[idx];
     }
 
-    int structSpan(uint64_t structId,
-                   const QHash<uint64_t, QVector<int>>* childMap = nullptr,
-                   QSet<uint64_t>* visited = nullptr) const {
-        QSet<uint64_t> localVisited;
-        if (!visited) visited = &localVisited;
-
-        if (visited->contains(structId)) return 0;  // Cycle detected
-        visited->insert(structId);
-
-        int idx = indexOfId(structId);
-        if (idx < 0) return 0;
-
-        const Node& node = nodes[idx];
-        int declaredSize = node.byteSize();
-
-        int maxEnd = 0;
-        QVector<int> kids = childMap ? childMap->value(structId) : childrenOf(structId);
-        for (int ci : kids) {
-            const Node& c = nodes[ci];
-            int sz = (c.kind == NodeKind::Struct || c.kind == NodeKind::Array)
-                ? structSpan(c.id, childMap, visited) : c.byteSize();
-            int end = c.offset + sz;
-            if (end > maxEnd) maxEnd = end;
-        }
-
-        // Embedded struct reference: no own children but refId points to a struct definition
-        if (kids.isEmpty() && node.kind == NodeKind::Struct && node.refId != 0)
-            maxEnd = qMax(maxEnd, structSpan(node.refId, childMap, visited));
-
-        return qMax(declaredSize, maxEnd);
+    int structSpan(uint64_t structId) const {
+        const LayoutIndex& li = layoutIndex();
+        auto it = li.spans.constFind(structId);
+        if (it != li.spans.constEnd()) return *it;
+        QSet<uint64_t> active;
+        bool cut = false;
+        return spanOf(structId, active, cut);
     }
 
     // Batch selection normalizers
@@ -424,6 +403,95 @@ struct NodeTree {
         return t;
     }
 
+private:
+    void buildLayoutIndex() const {
+        LayoutIndex& li = m_layoutIndex;
+        const int n = nodes.size();
+        li.generation = m_generation;
+        li.children.clear();
+        li.spans.clear();
+        li.offsets.fill(0, n);
+        li.depths.fill(0, n);
+        for (int i = 0; i < n; i++)
+            li.children[nodes[i].parentId].append(i);
+
+        // Each node's offset and depth extend its parent's.  Walk up to the
+        // first resolved ancestor, then unwind; a parent link back into the
+        // current walk is a cycle and ends it there.
+        enum : char { Unseen, Walking, Done };
+        QVector<char> state(n, Unseen);
+        QVector<int> chain;
+        for (int i = 0; i < n; i++) {
+            int cur = i;
+            while (state[cur] == Unseen) {
+                state[cur] = Walking;
+                chain.append(cur);
+                if (nodes[cur].parentId == 0) break;
+                int p = indexOfId(nodes[cur].parentId);
+                if (p < 0 || state[p] == Walking) break;
+                cur = p;
+            }
+            while (!chain.isEmpty()) {
+                int c = chain.takeLast();
+                int64_t off = nodes[c].offset;
+                int depth = 0;
+                if (nodes[c].parentId != 0) {
+                    int p = indexOfId(nodes[c].parentId);
+                    if (p >= 0 && state[p] == Done) {
+                        off += li.offsets[p];
+                        depth = li.depths[p] + 1;
+                    }
+                }
+                li.offsets[c] = off;
+                li.depths[c] = depth;
+                state[c] = Done;
+            }
+        }
+    }
+
+    // Span of a container: its declared size or the furthest child end,
+    // whichever is larger.  A struct on the current path counts as 0 and
+    // sets `cut`; spans computed under a cut depend on where the walk
+    // entered the cycle, so they are not memoized.
+    int spanOf(uint64_t structId, QSet<uint64_t>& active, bool& cut) const {
+        LayoutIndex& li = m_layoutIndex;
+        auto memo = li.spans.constFind(structId);
+        if (memo != li.spans.constEnd()) return *memo;
+        if (active.contains(structId)) {  // Cycle detected
+            cut = true;
+            return 0;
+        }
+
+        int idx = indexOfId(structId);
+        if (idx < 0) return 0;
+        active.insert(structId);
+
+        const Node& node = nodes[idx];
+        int declaredSize = node.byteSize();
+
+        int maxEnd = 0;
+        bool kidsCut = false;
+        const QVector<int> kids = li.children.value(structId);
+        for (int ci : kids) {
+            const Node& c = nodes[ci];
+            int sz = (c.kind == NodeKind::Struct || c.kind == NodeKind::Array)
+                ? spanOf(c.id, active, kidsCut) : c.byteSize();
+            int end = c.offset + sz;
+            if (end > maxEnd) maxEnd = end;
+        }
+
+        // Embedded struct reference: no own children but refId points to a struct definition
+        if (kids.isEmpty() && node.kind == NodeKind::Struct && node.refId != 0)
+            maxEnd = qMax(maxEnd, spanOf(node.refId, active, kidsCut));
+
+        active.remove(structId);
+        int span = qMax(declaredSize, maxEnd);
+        if (kidsCut)
+            cut = true;
+        else
+            li.spans.insert(structId, span);
+        return span;
+    }
 };
 
 // ── Value History (ring buffer for heatmap) ──
@@ -511,6 +579,7 @@ struct LineMeta {
     int      effectiveNameW = 22;  // Per-line name column width used for rendering
     QString  pointerTargetName;    // Resolved target type name for Pointer32/64 (empty = "void")
     bool     isArrayElement  = false;  // true for synthesized primitive array element lines
+    int      arrayElided     = 0;      // Placeholder: elements not shown, from arrayElementIdx on
 };
 
 inline bool isSyntheticLine(const LineMeta& lm) {
@@ -532,6 +601,72 @@ struct ComposeResult {
     QString            text;
     QVector<LineMeta>  meta;
     LayoutInfo         layout;
+    // Incremental composes only: [first, last] line ranges whose text,
+    // margin or markers differ from the previous compose with the same
+    // cache.  Meaningful only when linesStable is set; otherwise the line
+    // structure changed and the whole document must be redrawn.
+    QVector<QPair<int,int>> changedLines;
+    bool               linesStable = false;
+};
+
+// ── Array windows ──
+
+// Synthesized arrays longer than their window show only that many elements;
+// the elements before and after collapse into one placeholder line each
+// (ArrayElementSeparator with arrayElided set).  The window starts around
+// viewIndex unless the view has slid it (ArrayWindows, keyed by array node
+// id), which the controller does as placeholders scroll on screen.  Typing
+// an index over a placeholder's range jumps the window there directly.
+static constexpr int kArrayWindow       = 256;  // primitive elements
+static constexpr int kStructArrayWindow = 64;   // struct elements, several lines each
+
+inline int arrayWindowSize(const Node& n) {
+    return n.elementKind == NodeKind::Struct ? kStructArrayWindow : kArrayWindow;
+}
+
+using ArrayWindows = QHash<uint64_t, int>;   // array node id -> first element shown
+
+// ── Compose cache ──
+
+// Rendered field lines carried from one compose to the next.  A block (the
+// lines of one field, or of one synthesized primitive array element) is
+// reused when it lands at the same address, depth, column widths and
+// pointer base and the bytes it covers read the same as last time, so a
+// refresh re-formats only the values that changed.  Blocks not used by a
+// compose are dropped.  Whoever owns the cache must clear() it when the
+// tree or the view root changes: node definitions are not part of the key.
+struct ComposeCache {
+    struct Key {
+        uint64_t nodeId;
+        int      element;       // synthesized array element index, -1 for a field
+        uint64_t addr;
+        uint64_t ptrBase;
+        int      depth;
+        int      typeW;
+        int      nameW;
+        int      hexDigits;
+        bool operator==(const Key& o) const {
+            return nodeId == o.nodeId && element == o.element && addr == o.addr
+                && ptrBase == o.ptrBase && depth == o.depth && typeW == o.typeW
+                && nameW == o.nameW && hexDigits == o.hexDigits;
+        }
+        friend uint qHash(const Key& k, uint seed = 0) {
+            uint h = ::qHash(k.nodeId, seed) ^ (::qHash(k.addr, seed) * 31u)
+                   ^ (::qHash(k.ptrBase, seed) * 131u) ^ (uint(k.element) * 0x9E3779B9u);
+            return h ^ uint(k.depth ^ (k.typeW << 8) ^ (k.nameW << 16) ^ (k.hexDigits << 24));
+        }
+    };
+    struct Block {
+        QByteArray        bytes;      // what the block covered when rendered
+        QStringList       lines;      // without the fold prefix
+        QVector<LineMeta> meta;
+        QVector<uint>     hashes;     // per line, see ComposeResult::changedLines
+    };
+
+    QHash<Key, Block> blocks;
+    QVector<uint>     lineHashes;     // every line of the last compose
+
+    void clear() { blocks.clear(); lineHashes.clear(); }
 };
 
 // ── Command ──
@@ -801,6 +936,16 @@ inline ColumnSpan arrayCountSpanFor(const LineMeta& lm, const QString& lineText)
     return {slash + 1, gt, true};
 }
 
+// Placeholder of a windowed array: the "first..last" inside its brackets,
+// edited as EditTarget::ArrayIndex to jump to an element
+inline ColumnSpan arrayElidedSpanFor(const LineMeta& lm, const QString& lineText) {
+    if (lm.lineKind != LineKind::ArrayElementSeparator || lm.arrayElided <= 0) return {};
+    int open = lineText.indexOf('[');
+    int close = lineText.indexOf(']', open);
+    if (open < 0 || close <= open + 1) return {};
+    return {open + 1, close, true};
+}
+
 inline ColumnSpan arrayNextSpanFor(const LineMeta& lm, const QString& lineText) {
     if (!lm.isArrayHeader) return {};
     int gt = lineText.lastIndexOf('>');
@@ -864,6 +1009,14 @@ namespace fmt {
 
 // ── Compose function forward declaration ──
 
-ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewRootId = 0);
+ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewRootId = 0,
+                      const ArrayWindows& windows = {});
+// Incremental variant: reuses unchanged blocks from `cache` and fills in
+// ComposeResult::changedLines.  The result is identical to a full compose.
+// Once `cancel` fires the walk stops early and returns an empty result,
+// leaving `cache` as the last finished compose left it.
+ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewRootId,
+                      ComposeCache& cache, const ArrayWindows& windows = {},
+                      const CancelToken& cancel = {});
 
 } // namespace rcx
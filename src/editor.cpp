@@ -1,5 +1,6 @@
 #include "editor.h"
 #include "disasm.h"
+#include "providers/async_read.h"
 #include "providerregistry.h"
 #include <QDebug>
 #include <Qsci/qsciscintilla.h>
@@ -399,6 +400,7 @@ RcxEditor::RcxEditor(QWidget* parent) : QWidget(parent) {
     // deceleration, etc.) so the highlight tracks whatever is under the cursor.
     connect(m_sci->verticalScrollBar(), &QScrollBar::valueChanged,
             this, [this]() {
+        emit viewportScrolled();
         if (m_editState.active || !m_hoverInside) return;
         m_lastHoverPos = m_sci->viewport()->mapFromGlobal(QCursor::pos());
         m_hoverInside = m_sci->viewport()->rect().contains(m_lastHoverPos);
@@ -771,11 +773,33 @@ void RcxEditor::applyTheme(const Theme& theme) {
     }
 }
 
-void RcxEditor::applyDocument(const ComposeResult& result) {
+static inline void lineRangeNoEol(QsciScintilla* sci, int line, long& start, long& len) {
+    start = sci->SendScintilla(QsciScintillaBase::SCI_POSITIONFROMLINE, (unsigned long)line);
+    long end = sci->SendScintilla(QsciScintillaBase::SCI_GETLINEENDPOSITION, (unsigned long)line);
+    len = (end > start) ? (end - start) : 0;
+}
+
+// UTF-8 safe column-to-position conversion
+static inline long posFromCol(QsciScintilla* sci, int line, int col) {
+    return sci->SendScintilla(QsciScintillaBase::SCI_FINDCOLUMN,
+                              (unsigned long)line, (long)col);
+}
+
+// Line length without trailing spaces, for the horizontal scroll width
+static int trimmedLength(const QString& line) {
+    int len = line.size();
+    while (len > 0 && line[len - 1] == QChar(' ')) --len;
+    return len;
+}
+
+bool RcxEditor::applyDocument(const ComposeResult& result) {
     // Silently deactivate inline edit (no signal — refresh is already happening)
     if (m_editState.active)
         endInlineEdit();
 
+    if (patchDocument(result))
+        return true;
+
     // Guard: suppress popup dismiss during setText() which fires synthetic Leave events
     m_applyingDocument = true;
 
@@ -795,15 +819,13 @@ void RcxEditor::applyDocument(const ComposeResult& result) {
     m_sci->setText(result.text);
     m_sci->setReadOnly(true);
 
+    m_lines = result.text.split(QChar('\n'));
+
     // Set horizontal scroll width to match the longest line (ignoring trailing spaces)
     {
         int maxLen = 0;
-        const QStringList lines = result.text.split(QChar('\n'));
-        for (const auto& line : lines) {
-            int len = line.size();
-            while (len > 0 && line[len - 1] == QChar(' ')) --len;
-            if (len > maxLen) maxLen = len;
-        }
+        for (const auto& line : qAsConst(m_lines))
+            maxLen = qMax(maxLen, trimmedLength(line));
         QFontMetrics fm(editorFont());
         int pixelWidth = fm.horizontalAdvance(QString(maxLen, QChar('0')));
         m_sci->SendScintilla(QsciScintillaBase::SCI_SETSCROLLWIDTH,
@@ -839,6 +861,130 @@ void RcxEditor::applyDocument(const ComposeResult& result) {
     // composed text that updateCommandRow() will overwrite.  The correct call
     // happens via applySelectionOverlays() after all text is finalized.
     applyHoverHighlight();
+    return false;
+}
+
+static bool sameLineShape(const LineMeta& a, const LineMeta& b) {
+    return a.nodeId == b.nodeId && a.lineKind == b.lineKind
+        && a.subLine == b.subLine && a.depth == b.depth
+        && a.foldLevel == b.foldLevel && a.foldHead == b.foldHead
+        && a.foldCollapsed == b.foldCollapsed
+        && a.isContinuation == b.isContinuation;
+}
+
+// Margin text is compared through its inputs: in relative mode m_meta holds
+// the reformatted text, not the composed one.
+static bool sameLineDecor(const LineMeta& a, const LineMeta& b) {
+    return a.nodeIdx == b.nodeIdx && a.nodeKind == b.nodeKind
+        && a.offsetAddr == b.offsetAddr && a.ptrBase == b.ptrBase
+        && a.markerMask == b.markerMask && a.heatLevel == b.heatLevel
+        && a.effectiveTypeW == b.effectiveTypeW
+        && a.effectiveNameW == b.effectiveNameW
+        && a.arrayViewIdx == b.arrayViewIdx && a.arrayCount == b.arrayCount
+        && a.arrayElementIdx == b.arrayElementIdx
+        && a.arrayElided == b.arrayElided
+        && a.pointerTargetName == b.pointerTargetName;
+}
+
+// A refresh that keeps the line structure (a value tick, a heat change)
+// rewrites only the lines that differ.  Nothing is reloaded, so scroll,
+// cursor, folds and hover stay where they are.  Returns false when the
+// structure changed and the caller must reload the whole document.
+bool RcxEditor::patchDocument(const ComposeResult& result) {
+    const QVector<LineMeta>& meta = result.meta;
+    if (m_lines.size() != meta.size() || m_meta.size() != meta.size())
+        return false;
+    if (m_layout.typeW != result.layout.typeW || m_layout.nameW != result.layout.nameW
+        || m_layout.offsetHexDigits != result.layout.offsetHexDigits
+        || m_layout.baseAddress != result.layout.baseAddress)
+        return false;
+    const QStringList lines = result.text.split(QChar('\n'));
+    if (lines.size() != meta.size())
+        return false;
+
+    QVector<int> changed;
+    for (int i = 0; i < meta.size(); i++) {
+        if (!sameLineShape(m_meta[i], meta[i]))
+            return false;
+        if (lines[i] != m_lines[i] || !sameLineDecor(m_meta[i], meta[i]))
+            changed.append(i);
+    }
+    if (changed.isEmpty())
+        return true;
+
+    bool wasModified = m_sci->SendScintilla(QsciScintillaBase::SCI_GETMODIFY);
+    auto lineCol = [this](long pos) {
+        return qMakePair(
+            (int)m_sci->SendScintilla(QsciScintillaBase::SCI_LINEFROMPOSITION, pos),
+            (int)m_sci->SendScintilla(QsciScintillaBase::SCI_GETCOLUMN, pos));
+    };
+    QPair<int,int> caret = lineCol(m_sci->SendScintilla(QsciScintillaBase::SCI_GETCURRENTPOS));
+    QPair<int,int> anchor = lineCol(m_sci->SendScintilla(QsciScintillaBase::SCI_GETANCHOR));
+
+    m_sci->SendScintilla(QsciScintillaBase::SCI_SETUNDOCOLLECTION, 0);
+    m_sci->setReadOnly(false);
+    bool textChanged = false;
+    for (int i : changed) {
+        m_meta[i] = meta[i];
+        if (lines[i] == m_lines[i]) continue;
+        m_lines[i] = lines[i];
+        long start, len;
+        lineRangeNoEol(m_sci, i, start, len);
+        QByteArray utf8 = lines[i].toUtf8();
+        m_sci->SendScintilla(QsciScintillaBase::SCI_SETTARGETSTART, start);
+        m_sci->SendScintilla(QsciScintillaBase::SCI_SETTARGETEND, start + len);
+        m_sci->SendScintilla(QsciScintillaBase::SCI_REPLACETARGET,
+                             (uintptr_t)utf8.size(), utf8.constData());
+        m_sci->SendScintilla(QsciScintillaBase::SCI_COLOURISE,
+                             start, start + (long)utf8.size());
+        textChanged = true;
+    }
+    m_sci->setReadOnly(true);
+    m_sci->SendScintilla(QsciScintillaBase::SCI_SETUNDOCOLLECTION, 1);
+    if (!wasModified) m_sci->SendScintilla(QsciScintillaBase::SCI_SETSAVEPOINT);
+
+    // Replacing a line can move the caret to its start; put it back
+    m_sci->SendScintilla(QsciScintillaBase::SCI_SETCURRENTPOS,
+                         posFromCol(m_sci, caret.first, caret.second));
+    m_sci->SendScintilla(QsciScintillaBase::SCI_SETANCHOR,
+                         posFromCol(m_sci, anchor.first, anchor.second));
+
+    if (textChanged) {
+        int maxLen = 0;
+        for (const auto& line : qAsConst(m_lines))
+            maxLen = qMax(maxLen, trimmedLength(line));
+        QFontMetrics fm(editorFont());
+        int pixelWidth = qMax(1, fm.horizontalAdvance(QString(maxLen, QChar('0'))));
+        if (pixelWidth != (int)m_sci->SendScintilla(QsciScintillaBase::SCI_GETSCROLLWIDTH))
+            m_sci->SendScintilla(QsciScintillaBase::SCI_SETSCROLLWIDTH, (unsigned long)pixelWidth);
+    }
+
+    static constexpr int lineIndicators[] = {
+        IND_HEX_DIM, IND_HEAT_COLD, IND_HEAT_WARM, IND_HEAT_HOT,
+        IND_HINT_GREEN, IND_LOCAL_OFF };
+    m_sci->setReadOnly(false);
+    for (int i : changed) {
+        const LineMeta& lm = m_meta[i];
+        for (int ind : lineIndicators)
+            clearIndicatorLine(ind, i);
+        if (m_relativeOffsets) {
+            formatMarginLine(i);
+            formatLocalOffset(i);
+        } else {
+            setMarginLine(i, lm.offsetText);
+        }
+        for (int m = M_CONT; m <= M_STRUCT_BG; m++)
+            m_sci->markerDelete(i, m);
+        m_sci->markerDelete(i, M_CMD_ROW);
+        applyMarkersLine(i, lm);
+        applyHexDimmingLine(i, lm);
+        applyHeatmapLine(i, lm);
+        applySymbolColoringLine(i, lm);
+    }
+    m_sci->setReadOnly(true);
+    if (changed.contains(m_hintLine))
+        m_hintLine = -1;
+    return true;
 }
 
 void RcxEditor::applyMarginText(const QVector<LineMeta>& meta) {
@@ -848,123 +994,130 @@ void RcxEditor::applyMarginText(const QVector<LineMeta>& meta) {
     m_sci->clearMarginText(-1);
 
     for (int i = 0; i < meta.size(); i++) {
-        const auto& lm = meta[i];
-        if (lm.offsetText.isEmpty()) continue;
+        if (!meta[i].offsetText.isEmpty())
+            setMarginLine(i, meta[i].offsetText);
+    }
+}
 
-        QByteArray text = lm.offsetText.toUtf8();
-        m_sci->SendScintilla(QsciScintillaBase::SCI_MARGINSETTEXT,
-                             (uintptr_t)i, text.constData());
-        QByteArray styles(text.size(), '\0');  // style 0 = dim
-        m_sci->SendScintilla(QsciScintillaBase::SCI_MARGINSETSTYLES,
-                             (uintptr_t)i, styles.constData());
+void RcxEditor::setMarginLine(int line, const QString& offsetText) {
+    if (offsetText.isEmpty()) {
+        m_sci->clearMarginText(line);
+        return;
     }
+    QByteArray text = offsetText.toUtf8();
+    m_sci->SendScintilla(QsciScintillaBase::SCI_MARGINSETTEXT,
+                         (uintptr_t)line, text.constData());
+    QByteArray styles(text.size(), '\0');  // style 0 = dim
+    m_sci->SendScintilla(QsciScintillaBase::SCI_MARGINSETSTYLES,
+                         (uintptr_t)line, styles.constData());
 }
 
 void RcxEditor::reformatMargins() {
+    // ── Pass 1: margin text (global offset only) ──
+    m_sci->clearMarginText(-1);
+    for (int i = 0; i < m_meta.size(); i++)
+        formatMarginLine(i);
+
+    // ── Pass 2: inline local offsets in the text indent area ──
+    m_sci->setReadOnly(false);
+    for (int i = 0; i < m_meta.size(); i++)
+        formatLocalOffset(i);
+    m_sci->setReadOnly(true);
+}
+
+void RcxEditor::formatMarginLine(int i) {
     uint64_t base = m_layout.baseAddress;
     int hexDigits = m_layout.offsetHexDigits;
+    auto& lm = m_meta[i];
 
-    // ── Pass 1: margin text (global offset only) ──
-    m_sci->clearMarginText(-1);
-    for (int i = 0; i < m_meta.size(); i++) {
-        auto& lm = m_meta[i];
-
-        if (lm.isContinuation) {
-            lm.offsetText = QStringLiteral("  \u00B7 ");
-        } else if (lm.offsetText.isEmpty()) {
-            continue;
-        } else if (m_relativeOffsets) {
-            if (lm.lineKind == LineKind::Footer ||
-                lm.lineKind == LineKind::ArrayElementSeparator ||
-                lm.lineKind == LineKind::CommandRow) {
-                lm.offsetText = QString(hexDigits + 1, ' ');
-            } else {
-                uint64_t rvaBase = lm.ptrBase ? lm.ptrBase : base;
-                uint64_t rel = lm.offsetAddr >= rvaBase ? lm.offsetAddr - rvaBase : 0;
-                lm.offsetText = (QStringLiteral("+") +
-                    QString::number(rel, 16).toUpper())
-                    .rightJustified(hexDigits, ' ') + QChar(' ');
-            }
+    if (lm.isContinuation) {
+        lm.offsetText = QStringLiteral("  \u00B7 ");
+    } else if (lm.offsetText.isEmpty()) {
+        return;
+    } else if (m_relativeOffsets) {
+        if (lm.lineKind == LineKind::Footer ||
+            lm.lineKind == LineKind::ArrayElementSeparator ||
+            lm.lineKind == LineKind::CommandRow) {
+            lm.offsetText = QString(hexDigits + 1, ' ');
         } else {
-            lm.offsetText = QString::number(lm.offsetAddr, 16).toUpper()
-                .rightJustified(hexDigits, '0') + QChar(' ');
+            uint64_t rvaBase = lm.ptrBase ? lm.ptrBase : base;
+            uint64_t rel = lm.offsetAddr >= rvaBase ? lm.offsetAddr - rvaBase : 0;
+            lm.offsetText = (QStringLiteral("+") +
+                QString::number(rel, 16).toUpper())
+                .rightJustified(hexDigits, ' ') + QChar(' ');
         }
-
-        QByteArray text = lm.offsetText.toUtf8();
-        m_sci->SendScintilla(QsciScintillaBase::SCI_MARGINSETTEXT,
-                             (uintptr_t)i, text.constData());
-        QByteArray styles(text.size(), '\0');
-        m_sci->SendScintilla(QsciScintillaBase::SCI_MARGINSETSTYLES,
-                             (uintptr_t)i, styles.constData());
+    } else {
+        lm.offsetText = QString::number(lm.offsetAddr, 16).toUpper()
+            .rightJustified(hexDigits, '0') + QChar(' ');
     }
+    setMarginLine(i, lm.offsetText);
+}
 
-    // ── Pass 2: inline local offsets in the text indent area ──
-    m_sci->setReadOnly(false);
-    for (int i = 0; i < m_meta.size(); i++) {
-        const auto& lm = m_meta[i];
-        if (lm.depth <= 1 || lm.isContinuation) continue;
-        if (lm.lineKind != LineKind::Field && lm.lineKind != LineKind::Header)
-            continue;
+// Caller makes the document writable
+void RcxEditor::formatLocalOffset(int i) {
+    uint64_t base = m_layout.baseAddress;
+    const auto& lm = m_meta[i];
+    if (lm.depth <= 1 || lm.isContinuation) return;
+    if (lm.lineKind != LineKind::Field && lm.lineKind != LineKind::Header)
+        return;
 
-        // Place offset in the parent's indent slot (one level above the field's own indent)
-        // so the field's own 3-char indent acts as visual separator from the type column
-        int col = kFoldCol + (lm.depth - 2) * 3;
-        int slotWidth = 3;
+    // Place offset in the parent's indent slot (one level above the field's own indent)
+    // so the field's own 3-char indent acts as visual separator from the type column
+    int col = kFoldCol + (lm.depth - 2) * 3;
+    int slotWidth = 3;
 
-        auto pos = [&](int c) -> long {
-            return m_sci->SendScintilla(QsciScintillaBase::SCI_FINDCOLUMN,
-                                        (unsigned long)i, (long)c);
-        };
+    auto pos = [&](int c) -> long {
+        return m_sci->SendScintilla(QsciScintillaBase::SCI_FINDCOLUMN,
+                                    (unsigned long)i, (long)c);
+    };
 
-        if (m_relativeOffsets) {
-            // Derive local offset: for pointer-expanded children use ptrBase,
-            // otherwise find enclosing header or array element separator
-            uint64_t parentAddr = base;
-            if (lm.ptrBase != 0) {
-                parentAddr = lm.ptrBase;
-            } else {
-                for (int j = i - 1; j >= 0; j--) {
-                    const auto& pLm = m_meta[j];
-                    if (pLm.lineKind == LineKind::Header && pLm.depth < lm.depth) {
-                        parentAddr = pLm.offsetAddr;
-                        break;
-                    }
-                    if (pLm.lineKind == LineKind::ArrayElementSeparator && pLm.depth <= lm.depth) {
-                        parentAddr = pLm.offsetAddr;
-                        break;
-                    }
+    if (m_relativeOffsets) {
+        // Derive local offset: for pointer-expanded children use ptrBase,
+        // otherwise find enclosing header or array element separator
+        uint64_t parentAddr = base;
+        if (lm.ptrBase != 0) {
+            parentAddr = lm.ptrBase;
+        } else {
+            for (int j = i - 1; j >= 0; j--) {
+                const auto& pLm = m_meta[j];
+                if (pLm.lineKind == LineKind::Header && pLm.depth < lm.depth) {
+                    parentAddr = pLm.offsetAddr;
+                    break;
+                }
+                if (pLm.lineKind == LineKind::ArrayElementSeparator && pLm.depth <= lm.depth) {
+                    parentAddr = pLm.offsetAddr;
+                    break;
                 }
             }
-            uint64_t localOff = lm.offsetAddr >= parentAddr ? lm.offsetAddr - parentAddr : 0;
-
-            QString off = QStringLiteral("+") +
-                QString::number(localOff, 16).toUpper();
-            QString padded = off.size() <= slotWidth
-                ? off.rightJustified(slotWidth, ' ')
-                : off;
-            long posA = pos(col);
-            long posB = pos(col + slotWidth);
-            m_sci->SendScintilla(QsciScintillaBase::SCI_SETTARGETSTART, posA);
-            m_sci->SendScintilla(QsciScintillaBase::SCI_SETTARGETEND, posB);
-            QByteArray utf8 = padded.left(slotWidth).toUtf8();
-            m_sci->SendScintilla(QsciScintillaBase::SCI_REPLACETARGET,
-                                 (uintptr_t)utf8.size(), utf8.constData());
-            // Color the local offset dim
-            m_sci->SendScintilla(QsciScintillaBase::SCI_SETINDICATORCURRENT, IND_LOCAL_OFF);
-            m_sci->SendScintilla(QsciScintillaBase::SCI_INDICATORFILLRANGE,
-                                 posA, posB - posA);
-        } else {
-            // Restore spaces when toggling off
-            long posA = pos(col);
-            long posB = pos(col + slotWidth);
-            m_sci->SendScintilla(QsciScintillaBase::SCI_SETTARGETSTART, posA);
-            m_sci->SendScintilla(QsciScintillaBase::SCI_SETTARGETEND, posB);
-            QByteArray spaces(slotWidth, ' ');
-            m_sci->SendScintilla(QsciScintillaBase::SCI_REPLACETARGET,
-                                 (uintptr_t)spaces.size(), spaces.constData());
         }
+        uint64_t localOff = lm.offsetAddr >= parentAddr ? lm.offsetAddr - parentAddr : 0;
+
+        QString off = QStringLiteral("+") +
+            QString::number(localOff, 16).toUpper();
+        QString padded = off.size() <= slotWidth
+            ? off.rightJustified(slotWidth, ' ')
+            : off;
+        long posA = pos(col);
+        long posB = pos(col + slotWidth);
+        m_sci->SendScintilla(QsciScintillaBase::SCI_SETTARGETSTART, posA);
+        m_sci->SendScintilla(QsciScintillaBase::SCI_SETTARGETEND, posB);
+        QByteArray utf8 = padded.left(slotWidth).toUtf8();
+        m_sci->SendScintilla(QsciScintillaBase::SCI_REPLACETARGET,
+                             (uintptr_t)utf8.size(), utf8.constData());
+        // Color the local offset dim
+        m_sci->SendScintilla(QsciScintillaBase::SCI_SETINDICATORCURRENT, IND_LOCAL_OFF);
+        m_sci->SendScintilla(QsciScintillaBase::SCI_INDICATORFILLRANGE,
+                             posA, posB - posA);
+    } else {
+        // Restore spaces when toggling off
+        long posA = pos(col);
+        long posB = pos(col + slotWidth);
+        m_sci->SendScintilla(QsciScintillaBase::SCI_SETTARGETSTART, posA);
+        m_sci->SendScintilla(QsciScintillaBase::SCI_SETTARGETEND, posB);
+        QByteArray spaces(slotWidth, ' ');
+        m_sci->SendScintilla(QsciScintillaBase::SCI_REPLACETARGET,
+                             (uintptr_t)spaces.size(), spaces.constData());
     }
-    m_sci->setReadOnly(true);
 }
 
 void RcxEditor::applyMarkers(const QVector<LineMeta>& meta) {
@@ -972,16 +1125,19 @@ void RcxEditor::applyMarkers(const QVector<LineMeta>& meta) {
         m_sci->markerDeleteAll(m);
     }
     m_sci->markerDeleteAll(M_CMD_ROW);
-    for (int i = 0; i < meta.size(); i++) {
-        if (meta[i].lineKind == LineKind::CommandRow) {
-            m_sci->markerAdd(i, M_CMD_ROW);
-            continue;
-        }
-        uint32_t mask = meta[i].markerMask;
-        for (int m = M_CONT; m <= M_STRUCT_BG; m++) {
-            if (mask & (1u << m)) {
-                m_sci->markerAdd(i, m);
-            }
+    for (int i = 0; i < meta.size(); i++)
+        applyMarkersLine(i, meta[i]);
+}
+
+void RcxEditor::applyMarkersLine(int line, const LineMeta& lm) {
+    if (lm.lineKind == LineKind::CommandRow) {
+        m_sci->markerAdd(line, M_CMD_ROW);
+        return;
+    }
+    uint32_t mask = lm.markerMask;
+    for (int m = M_CONT; m <= M_STRUCT_BG; m++) {
+        if (mask & (1u << m)) {
+            m_sci->markerAdd(line, m);
         }
     }
 }
@@ -993,18 +1149,6 @@ void RcxEditor::applyFoldLevels(const QVector<LineMeta>& meta) {
     }
 }
 
-static inline void lineRangeNoEol(QsciScintilla* sci, int line, long& start, long& len) {
-    start = sci->SendScintilla(QsciScintillaBase::SCI_POSITIONFROMLINE, (unsigned long)line);
-    long end = sci->SendScintilla(QsciScintillaBase::SCI_GETLINEENDPOSITION, (unsigned long)line);
-    len = (end > start) ? (end - start) : 0;
-}
-
-// UTF-8 safe column-to-position conversion
-static inline long posFromCol(QsciScintilla* sci, int line, int col) {
-    return sci->SendScintilla(QsciScintillaBase::SCI_FINDCOLUMN,
-                              (unsigned long)line, (long)col);
-}
-
 void RcxEditor::clearIndicatorLine(int indic, int line) {
     if (line < 0) return;
     long start, len;
@@ -1024,32 +1168,35 @@ void RcxEditor::fillIndicatorCols(int indic, int line, int colA, int colB) {
 }
 
 void RcxEditor::applyHexDimming(const QVector<LineMeta>& meta) {
+    for (int i = 0; i < meta.size(); i++)
+        applyHexDimmingLine(i, meta[i]);
+}
+
+void RcxEditor::applyHexDimmingLine(int i, const LineMeta& lm) {
+    // Dim fold arrows (▸/▾) on fold head lines
+    if (lm.foldHead && lm.lineKind != LineKind::CommandRow)
+        fillIndicatorCols(IND_HEX_DIM, i, 0, kFoldCol);
+
     m_sci->SendScintilla(QsciScintillaBase::SCI_SETINDICATORCURRENT, IND_HEX_DIM);
-    for (int i = 0; i < meta.size(); i++) {
-        // Dim fold arrows (▸/▾) on fold head lines
-        if (meta[i].foldHead && meta[i].lineKind != LineKind::CommandRow)
-            fillIndicatorCols(IND_HEX_DIM, i, 0, kFoldCol);
-
-        if (isHexPreview(meta[i].nodeKind)) {
-            long pos, len; lineRangeNoEol(m_sci, i, pos, len);
-            if (len > 0)
-                m_sci->SendScintilla(QsciScintillaBase::SCI_INDICATORFILLRANGE, pos, len);
-        }
-        // Dim struct/array braces: entire footer line, trailing "{" on headers
-        if (meta[i].lineKind == LineKind::Footer) {
-            long pos, len; lineRangeNoEol(m_sci, i, pos, len);
-            if (len > 0)
-                m_sci->SendScintilla(QsciScintillaBase::SCI_INDICATORFILLRANGE, pos, len);
-        } else if (meta[i].lineKind == LineKind::Header ||
-                   meta[i].lineKind == LineKind::CommandRow) {
-            long endPos = m_sci->SendScintilla(QsciScintillaBase::SCI_GETLINEENDPOSITION, (unsigned long)i);
-            for (long p = endPos - 1; p >= 0; --p) {
-                int ch = (int)m_sci->SendScintilla(QsciScintillaBase::SCI_GETCHARAT, (unsigned long)p);
-                if (ch == ' ' || ch == '\t') continue;
-                if (ch == '{')
-                    m_sci->SendScintilla(QsciScintillaBase::SCI_INDICATORFILLRANGE, p, 1);
-                break;
-            }
+    if (isHexPreview(lm.nodeKind)) {
+        long pos, len; lineRangeNoEol(m_sci, i, pos, len);
+        if (len > 0)
+            m_sci->SendScintilla(QsciScintillaBase::SCI_INDICATORFILLRANGE, pos, len);
+    }
+    // Dim struct/array braces: entire footer line, trailing "{" on headers
+    if (lm.lineKind == LineKind::Footer) {
+        long pos, len; lineRangeNoEol(m_sci, i, pos, len);
+        if (len > 0)
+            m_sci->SendScintilla(QsciScintillaBase::SCI_INDICATORFILLRANGE, pos, len);
+    } else if (lm.lineKind == LineKind::Header ||
+               lm.lineKind == LineKind::CommandRow) {
+        long endPos = m_sci->SendScintilla(QsciScintillaBase::SCI_GETLINEENDPOSITION, (unsigned long)i);
+        for (long p = endPos - 1; p >= 0; --p) {
+            int ch = (int)m_sci->SendScintilla(QsciScintillaBase::SCI_GETCHARAT, (unsigned long)p);
+            if (ch == ' ' || ch == '\t') continue;
+            if (ch == '{')
+                m_sci->SendScintilla(QsciScintillaBase::SCI_INDICATORFILLRANGE, p, 1);
+            break;
         }
     }
 }
@@ -1149,6 +1296,16 @@ const LineMeta* RcxEditor::metaForLine(int line) const {
     return nullptr;
 }
 
+QPair<int, int> RcxEditor::visibleLineRange() const {
+    int firstVisible = (int)m_sci->SendScintilla(QsciScintillaBase::SCI_GETFIRSTVISIBLELINE);
+    int onScreen = (int)m_sci->SendScintilla(QsciScintillaBase::SCI_LINESONSCREEN);
+    int first = (int)m_sci->SendScintilla(QsciScintillaBase::SCI_DOCLINEFROMVISIBLE,
+                                          (unsigned long)firstVisible);
+    int last = (int)m_sci->SendScintilla(QsciScintillaBase::SCI_DOCLINEFROMVISIBLE,
+                                         (unsigned long)(firstVisible + qMax(onScreen, 1)));
+    return {first, qMin(last, (int)m_meta.size() - 1)};
+}
+
 int RcxEditor::currentNodeIndex() const {
     int line, col;
     m_sci->getCursorPosition(&line, &col);
@@ -1221,57 +1378,61 @@ static QString getLineText(QsciScintilla* sci, int line) {
 }
 
 void RcxEditor::applyHeatmapHighlight(const QVector<LineMeta>& meta) {
+    for (int i = 0; i < meta.size(); i++)
+        applyHeatmapLine(i, meta[i]);
+}
+
+void RcxEditor::applyHeatmapLine(int i, const LineMeta& lm) {
     static constexpr int heatIndicators[] = { IND_HEAT_COLD, IND_HEAT_WARM, IND_HEAT_HOT };
 
-    for (int i = 0; i < meta.size(); i++) {
-        const LineMeta& lm = meta[i];
-        if (isSyntheticLine(lm)) continue;
+    if (isSyntheticLine(lm)) return;
 
-        int heat = lm.heatLevel;
-        int typeW = lm.effectiveTypeW;
-        int nameW = lm.effectiveNameW;
+    int heat = lm.heatLevel;
+    int typeW = lm.effectiveTypeW;
+    int nameW = lm.effectiveNameW;
 
-        if (heat <= 0) continue;
+    if (heat <= 0) return;
 
-        // Pick the right indicator for this heat level (1→cold, 2→warm, 3→hot)
-        int activeInd = heatIndicators[qBound(0, heat - 1, 2)];
+    // Pick the right indicator for this heat level (1→cold, 2→warm, 3→hot)
+    int activeInd = heatIndicators[qBound(0, heat - 1, 2)];
 
-        // Apply heat-level indicator to value span (narrowed for pointer-like nodes)
-        QString lineText = getLineText(m_sci, i);
-        ColumnSpan vs = narrowPtrValueSpan(lm,
-            valueSpan(lm, lineText.size(), typeW, nameW), lineText);
-        if (!vs.valid) continue;
+    // Apply heat-level indicator to value span (narrowed for pointer-like nodes)
+    QString lineText = getLineText(m_sci, i);
+    ColumnSpan vs = narrowPtrValueSpan(lm,
+        valueSpan(lm, lineText.size(), typeW, nameW), lineText);
+    if (!vs.valid) return;
 
-        fillIndicatorCols(activeInd, i, vs.start, vs.end);
+    fillIndicatorCols(activeInd, i, vs.start, vs.end);
 
-        // Clear the other two heat indicators on this span to avoid overlap
-        for (int hi : heatIndicators) {
-            if (hi != activeInd)
-                clearIndicatorLine(hi, i);
-        }
+    // Clear the other two heat indicators on this span to avoid overlap
+    for (int hi : heatIndicators) {
+        if (hi != activeInd)
+            clearIndicatorLine(hi, i);
     }
 }
 
 void RcxEditor::applySymbolColoring(const QVector<LineMeta>& meta) {
-    for (int i = 0; i < meta.size(); i++) {
-        const LineMeta& lm = meta[i];
-        if (!isFuncPtr(lm.nodeKind)
-            && lm.nodeKind != NodeKind::Pointer32
-            && lm.nodeKind != NodeKind::Pointer64)
-            continue;
-        QString lineText = getLineText(m_sci, i);
-        // Find "  // " within the value region and color "// sym" portion green
-        ColumnSpan vs = valueSpan(lm, lineText.size(), lm.effectiveTypeW, lm.effectiveNameW);
-        if (!vs.valid) continue;
-        int searchFrom = vs.start;
-        int sep = lineText.indexOf(QLatin1String("  // "), searchFrom);
-        if (sep < 0 || sep >= vs.end) continue;
-        int symStart = sep + 2;  // start of "// sym"
-        int symEnd = vs.end;
-        while (symEnd > symStart && lineText[symEnd - 1] == ' ') symEnd--;
-        if (symEnd > symStart)
-            fillIndicatorCols(IND_HINT_GREEN, i, symStart, symEnd);
-    }
+    for (int i = 0; i < meta.size(); i++)
+        applySymbolColoringLine(i, meta[i]);
+}
+
+void RcxEditor::applySymbolColoringLine(int i, const LineMeta& lm) {
+    if (!isFuncPtr(lm.nodeKind)
+        && lm.nodeKind != NodeKind::Pointer32
+        && lm.nodeKind != NodeKind::Pointer64)
+        return;
+    QString lineText = getLineText(m_sci, i);
+    // Find "  // " within the value region and color "// sym" portion green
+    ColumnSpan vs = valueSpan(lm, lineText.size(), lm.effectiveTypeW, lm.effectiveNameW);
+    if (!vs.valid) return;
+    int searchFrom = vs.start;
+    int sep = lineText.indexOf(QLatin1String("  // "), searchFrom);
+    if (sep < 0 || sep >= vs.end) return;
+    int symStart = sep + 2;  // start of "// sym"
+    int symEnd = vs.end;
+    while (symEnd > symStart && lineText[symEnd - 1] == ' ') symEnd--;
+    if (symEnd > symStart)
+        fillIndicatorCols(IND_HINT_GREEN, i, symStart, symEnd);
 }
 
 void RcxEditor::applyBaseAddressColoring(const QVector<LineMeta>& meta) {
@@ -1530,6 +1691,7 @@ bool RcxEditor::resolvedSpanFor(int line, EditTarget t,
                                       valueSpan(*lm, textLen, typeW, nameW), lineText); break;
     case EditTarget::BaseAddress: break;  // No longer on header lines
     case EditTarget::ArrayIndex:
+        s = arrayElidedSpanFor(*lm, lineText); break;
     case EditTarget::ArrayCount:
         break;  // Array navigation removed
     case EditTarget::ArrayElementType:
@@ -1611,12 +1773,18 @@ static bool hitTestTarget(QsciScintilla* sci,
 
     const LineMeta& lm = meta[line];
 
-    if (lm.lineKind == LineKind::ArrayElementSeparator) return false;
-
     auto inSpan = [&](const ColumnSpan& s) {
         return s.valid && col >= s.start && col < s.end;
     };
 
+    // Placeholder of a windowed array: its range takes an index to jump to
+    if (lm.lineKind == LineKind::ArrayElementSeparator) {
+        if (!inSpan(arrayElidedSpanFor(lm, lineText))) return false;
+        outTarget = EditTarget::ArrayIndex;
+        outLine = line;
+        return true;
+    }
+
     // CommandRow: interactive chevron/SRC/ADDR + root class (type+name)
     if (lm.lineKind == LineKind::CommandRow) {
         ColumnSpan chevron = commandRowChevronSpan(lineText);
@@ -1740,7 +1908,7 @@ bool RcxEditor::eventFilter(QObject* obj, QEvent* event) {
                 case EditTarget::Value:       raw = valueSpan(*lm, lineText.size(), typeW, nameW); break;
                 case EditTarget::BaseAddress: raw = commandRowAddrSpan(lineText); break;
                 case EditTarget::Source:      raw = commandRowSrcSpan(lineText); break;
-                case EditTarget::ArrayIndex:  raw = arrayIndexSpanFor(*lm, lineText); break;
+                case EditTarget::ArrayIndex:  raw = arrayElidedSpanFor(*lm, lineText); break;
                 case EditTarget::ArrayCount:  raw = arrayCountSpanFor(*lm, lineText); break;
                 case EditTarget::ArrayElementType:  raw = arrayElemTypeSpanFor(*lm, lineText); break;
                 case EditTarget::ArrayElementCount: raw = arrayElemCountSpanFor(*lm, lineText); break;
@@ -2213,6 +2381,7 @@ bool RcxEditor::beginInlineEdit(EditTarget target, int line, int col) {
     }
 
     m_editState.active = true;
+    m_lines.clear();  // the edit rewrites this line; the next apply reloads
     m_editState.line = line;
     m_editState.nodeIdx = lm->nodeIdx;
     m_editState.subLine = lm->subLine;
@@ -2448,6 +2617,7 @@ void RcxEditor::showSourcePicker() {
     menuFont.setPointSize(menuFont.pointSize() + zoom);
     menu.setFont(menuFont);
     menu.addAction("File");
+    menu.addAction("Raw File");
 
     // Add all registered providers from global registry
     const auto& providers = ProviderRegistry::instance().providers();
@@ -2598,7 +2768,7 @@ void RcxEditor::paintEditableSpans(int line) {
     NormalizedSpan norm;
     for (EditTarget t : {EditTarget::Type, EditTarget::Name, EditTarget::Value,
                          EditTarget::ArrayElementType, EditTarget::ArrayElementCount,
-                         EditTarget::PointerTarget}) {
+                         EditTarget::PointerTarget, EditTarget::ArrayIndex}) {
         if (resolvedSpanFor(line, t, norm))
             fillIndicatorCols(IND_EDITABLE, line, norm.start, norm.end);
     }
@@ -2651,6 +2821,13 @@ void RcxEditor::updateEditableIndicators(int line) {
 
 // ── Hover cursor ──
 
+void RcxEditor::dropDisasmCode() {
+    m_disasmCodeAddr = 0;
+    m_disasmCode.clear();
+    m_disasmCodePending = false;
+    ++m_disasmGen;
+}
+
 void RcxEditor::applyHoverCursor() {
     // Clear previous hover span indicators
     for (int ln : m_hoverSpanLines)
@@ -2726,8 +2903,10 @@ void RcxEditor::applyHoverCursor() {
     if (!m_hoverInside) {
         if (m_historyPopup && !m_applyingDocument)
             static_cast<ValueHistoryPopup*>(m_historyPopup)->dismiss();
-        if (m_disasmPopup && !m_applyingDocument)
+        if (m_disasmPopup && !m_applyingDocument) {
             static_cast<DisasmPopup*>(m_disasmPopup)->dismiss();
+            dropDisasmCode();
+        }
         if (m_structPreviewPopup && !m_applyingDocument)
             static_cast<StructPreviewPopup*>(m_structPreviewPopup)->dismiss();
         m_sci->viewport()->setCursor(Qt::ArrowCursor);
@@ -2873,6 +3052,7 @@ void RcxEditor::applyHoverCursor() {
     // Disasm / hex-dump popup on hover for FuncPtr and void Pointer nodes
     {
         bool showDisasm = false;
+        uint64_t wantCodeAddr = 0;
         if (m_disasmProvider && m_disasmTree && h.line >= 0 && h.line < m_meta.size()) {
             const LineMeta& lm = m_meta[h.line];
             bool isFP = isFuncPtr(lm.nodeKind);
@@ -2902,13 +3082,36 @@ void RcxEditor::applyHoverCursor() {
                             // Read code bytes from the function target address.
                             // Use the real provider (not snapshot) because function
                             // code lives at arbitrary process addresses that aren't
-                            // in the snapshot page table.
-                            const Provider* codeProv = m_disasmRealProv
-                                ? m_disasmRealProv : m_disasmProvider;
+                            // in the snapshot page table.  That read may be slow, so
+                            // it runs off the UI thread and re-enters here when done.
                             constexpr int kMaxRead = 128;
                             uint64_t codeAddr = ptrVal;
-                            QByteArray bytes(kMaxRead, Qt::Uninitialized);
-                            bool readOk = codeProv->read(codeAddr, bytes.data(), kMaxRead);
+                            QByteArray bytes;
+                            bool readOk = false;
+                            if (m_disasmRealProv) {
+                                wantCodeAddr = codeAddr;
+                                if (m_disasmCodeAddr != codeAddr) {
+                                    m_disasmCodeAddr = codeAddr;
+                                    m_disasmCode.clear();
+                                    m_disasmCodePending = true;
+                                    ++m_disasmGen;
+                                    AsyncRead r;
+                                    r.addr = codeAddr;
+                                    r.len  = kMaxRead;
+                                    readAsyncOn(this, m_disasmRealProv, {r}, m_disasmGen.token(),
+                                        [this](const QVector<AsyncRead>& reads) {
+                                            m_disasmCodePending = false;
+                                            if (!reads.isEmpty() && reads[0].ok)
+                                                m_disasmCode = reads[0].data;
+                                            applyHoverCursor();
+                                        });
+                                }
+                                bytes = m_disasmCode;
+                                readOk = !m_disasmCodePending && !bytes.isEmpty();
+                            } else {
+                                bytes = QByteArray(kMaxRead, Qt::Uninitialized);
+                                readOk = m_disasmProvider->read(codeAddr, bytes.data(), kMaxRead);
+                            }
                             if (readOk) {
                                 QString title, body;
                                 if (isFP) {
@@ -2967,6 +3170,10 @@ void RcxEditor::applyHoverCursor() {
         }
         if (!showDisasm && m_disasmPopup && m_disasmPopup->isVisible())
             static_cast<DisasmPopup*>(m_disasmPopup)->dismiss();
+        // Left the pointer: drop its bytes (so re-hovering shows fresh data)
+        // and cancel a read still in flight
+        if (!wantCodeAddr && m_disasmCodeAddr)
+            dropDisasmCode();
     }
 
     // Struct preview popup for collapsed typed pointers
@@ -21,7 +21,9 @@ public:
     explicit RcxEditor(QWidget* parent = nullptr);
     ~RcxEditor() override;
 
-    void applyDocument(const ComposeResult& result);
+    // Returns true when the result kept the line structure and was patched
+    // in place; scroll, cursor and hover were never disturbed.
+    bool applyDocument(const ComposeResult& result);
 
     ViewState saveViewState() const;
     void restoreViewState(const ViewState& vs);
@@ -29,6 +31,8 @@ public:
     QsciScintilla* scintilla() const { return m_sci; }
     QWidget* structPreviewPopup() const { return m_structPreviewPopup; }
     const LineMeta* metaForLine(int line) const;
+    // First and last document lines currently on screen (inclusive)
+    QPair<int, int> visibleLineRange() const;
     int currentNodeIndex() const;
     void scrollToNodeId(uint64_t nodeId);
 
@@ -56,8 +60,8 @@ public:
     QString textWithMargins() const;
     void setCustomTypeNames(const QStringList& names);
     void setValueHistoryRef(const QHash<uint64_t, ValueHistory>* ref) { m_valueHistory = ref; }
-    void setProviderRef(const Provider* prov, const Provider* realProv, const NodeTree* tree) {
-        m_disasmProvider = prov; m_disasmRealProv = realProv; m_disasmTree = tree;
+    void setProviderRef(const Provider* prov, std::shared_ptr<Provider> realProv, const NodeTree* tree) {
+        m_disasmProvider = prov; m_disasmRealProv = std::move(realProv); m_disasmTree = tree;
     }
 
     // Saved sources for quick-switch in source picker
@@ -74,6 +78,7 @@ signals:
     void inlineEditCancelled();
     void typeSelectorRequested();
     void typePickerRequested(EditTarget target, int nodeIdx, QPoint globalPos);
+    void viewportScrolled();
 
 protected:
     bool eventFilter(QObject* obj, QEvent* event) override;
@@ -83,6 +88,7 @@ private:
     QsciLexerCPP*     m_lexer  = nullptr;
     QVector<LineMeta> m_meta;
     LayoutInfo        m_layout;  // cached from ComposeResult
+    QStringList       m_lines;   // composed text of each line, as last applied
 
     // ── Toggle: absolute vs relative offset margin
     bool m_relativeOffsets = true;
@@ -142,7 +148,12 @@ private:
     QWidget* m_disasmPopup = nullptr;   // DisasmPopup (file-local class in editor.cpp)
     QWidget* m_structPreviewPopup = nullptr; // StructPreviewPopup (file-local class in editor.cpp)
     const Provider* m_disasmProvider = nullptr;   // snapshot or real — for reading tree data
-    const Provider* m_disasmRealProv = nullptr;   // real process provider — for reading code at arbitrary addresses
+    std::shared_ptr<Provider> m_disasmRealProv;   // real process provider — for reading code at arbitrary addresses
+    // Code bytes for the hovered pointer, fetched off the UI thread
+    uint64_t   m_disasmCodeAddr = 0;
+    QByteArray m_disasmCode;                      // empty once fetched means the read failed
+    bool       m_disasmCodePending = false;
+    Generation m_disasmGen;                       // bumped when the hover target changes
     const NodeTree* m_disasmTree = nullptr;
 
     // ── Reentrancy guards ──
@@ -157,13 +168,21 @@ private:
     void setupMarkers();
     void allocateMarginStyles();
 
+    bool patchDocument(const ComposeResult& result);
     void applyMarginText(const QVector<LineMeta>& meta);
+    void setMarginLine(int line, const QString& offsetText);
     void reformatMargins();
+    void formatMarginLine(int line);
+    void formatLocalOffset(int line);
     void applyMarkers(const QVector<LineMeta>& meta);
+    void applyMarkersLine(int line, const LineMeta& lm);
     void applyFoldLevels(const QVector<LineMeta>& meta);
     void applyHexDimming(const QVector<LineMeta>& meta);
+    void applyHexDimmingLine(int line, const LineMeta& lm);
     void applyHeatmapHighlight(const QVector<LineMeta>& meta);
+    void applyHeatmapLine(int line, const LineMeta& lm);
     void applySymbolColoring(const QVector<LineMeta>& meta);
+    void applySymbolColoringLine(int line, const LineMeta& lm);
     void applyBaseAddressColoring(const QVector<LineMeta>& meta);
     void applyCommandRowPills();
 
@@ -181,6 +200,7 @@ private:
     void paintEditableSpans(int line);
     void updateEditableIndicators(int line);
     void applyHoverCursor();
+    void dropDisasmCode();
     void applyHoverHighlight();
     void validateEditLive();
     void setEditComment(const QString& comment);
@@ -161,7 +161,7 @@ static void emitStructBody(GenContext& ctx, uint64_t structId) {
     int idx = tree.indexOfId(structId);
     if (idx < 0) return;
 
-    int structSize = tree.structSpan(structId, &ctx.childMap);
+    int structSize = tree.structSpan(structId);
 
     QVector<int> children = ctx.childMap.value(structId);
     std::sort(children.begin(), children.end(), [&](int a, int b) {
@@ -185,7 +185,7 @@ static void emitStructBody(GenContext& ctx, uint64_t structId) {
         const Node& child = tree.nodes[children[i]];
         int childSize;
         if (child.kind == NodeKind::Struct || child.kind == NodeKind::Array)
-            childSize = tree.structSpan(child.id, &ctx.childMap);
+            childSize = tree.structSpan(child.id);
         else
             childSize = child.byteSize();
 
@@ -324,7 +324,7 @@ static void emitStruct(GenContext& ctx, uint64_t structId) {
 
     ctx.emittedIds.insert(structId);
     ctx.emittedTypeNames.insert(typeName);
-    int structSize = ctx.tree.structSpan(structId, &ctx.childMap);
+    int structSize = ctx.tree.structSpan(structId);
 
     QString kw = node.resolvedClassKeyword();
     if (kw == QStringLiteral("enum")) kw = QStringLiteral("struct");  // enum is cosmetic
@@ -342,13 +342,6 @@ static void emitStruct(GenContext& ctx, uint64_t structId) {
 
 // ── Build the child map used by all generators ──
 
-static QHash<uint64_t, QVector<int>> buildChildMap(const NodeTree& tree) {
-    QHash<uint64_t, QVector<int>> map;
-    for (int i = 0; i < tree.nodes.size(); i++)
-        map[tree.nodes[i].parentId].append(i);
-    return map;
-}
-
 // ── Align offset comments ──
 // Replaces kCommentMarker with spaces so all "// 0x..." comments align to
 // the same column (the longest code portion + 1 space).
@@ -396,7 +389,7 @@ QString renderCpp(const NodeTree& tree, uint64_t rootStructId,
     const Node& root = tree.nodes[idx];
     if (root.kind != NodeKind::Struct) return {};
 
-    GenContext ctx{tree, buildChildMap(tree), {}, {}, {}, {}, {}, 0, typeAliases};
+    GenContext ctx{tree, tree.layoutIndex().children, {}, {}, {}, {}, {}, 0, typeAliases};
 
     ctx.output += QStringLiteral("#pragma once\n\n");
 
@@ -407,7 +400,7 @@ QString renderCpp(const NodeTree& tree, uint64_t rootStructId,
 
 QString renderCppAll(const NodeTree& tree,
                      const QHash<NodeKind, QString>* typeAliases) {
-    GenContext ctx{tree, buildChildMap(tree), {}, {}, {}, {}, {}, 0, typeAliases};
+    GenContext ctx{tree, tree.layoutIndex().children, {}, {}, {}, {}, {}, 0, typeAliases};
 
     ctx.output += QStringLiteral("#pragma once\n\n");
 
@@ -32,6 +32,8 @@
 #include <QPainter>
 #include <QSvgRenderer>
 #include <QSettings>
+#include <QDateTime>
+#include <QSignalBlocker>
 #include <QDockWidget>
 #include <QTreeView>
 #include <QStandardItemModel>
@@ -348,6 +350,7 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
     setCentralWidget(m_mdiArea);
 
     createWorkspaceDock();
+    createHistoryDock();
     createMenus();
     createStatusBar();
 
@@ -383,6 +386,7 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
             this, [this](QMdiSubWindow*) {
         updateWindowTitle();
         rebuildWorkspaceModel();
+        bindHistoryDock();
     });
 
     // Track which split pane has focus (for menu-driven view switching)
@@ -424,6 +428,7 @@ void MainWindow::createMenus() {
     file->addSeparator();
     Qt5Qt6AddAction(file, "&Save", QKeySequence::Save, makeIcon(":/vsicons/save.svg"), this, &MainWindow::saveFile);
     Qt5Qt6AddAction(file, "Save &As...", QKeySequence::SaveAs, makeIcon(":/vsicons/save-as.svg"), this, &MainWindow::saveFileAs);
+    Qt5Qt6AddAction(file, "Save Data &Patches", QKeySequence::UnknownKey, QIcon(), this, &MainWindow::saveDataPatches);
     file->addSeparator();
     m_sourceMenu = file->addMenu("Current Tab So&urce");
     connect(m_sourceMenu, &QMenu::aboutToShow, this, &MainWindow::populateSourceMenu);
@@ -504,6 +509,7 @@ void MainWindow::createMenus() {
 
     view->addSeparator();
     view->addAction(m_workspaceDock->toggleViewAction());
+    view->addAction(m_historyDock->toggleViewAction());
 
     // Plugins
     auto* plugins = m_titleBar->menuBar()->addMenu("&Plugins");
@@ -1154,6 +1160,23 @@ void MainWindow::saveFileAs() {
     project_save(nullptr, true);
 }
 
+void MainWindow::saveDataPatches() {
+    auto* tab = activeTab();
+    if (!tab) return;
+    auto* mapped = dynamic_cast<MappedFileProvider*>(tab->doc->provider.get());
+    if (!mapped || !mapped->hasPatches()) {
+        m_statusLabel->setText("No unsaved data patches");
+        return;
+    }
+    QString error;
+    if (!mapped->savePatches(&error)) {
+        QMessageBox::warning(this, "Save Data Patches",
+            QStringLiteral("Failed to write %1:\n%2").arg(mapped->filePath(), error));
+        return;
+    }
+    m_statusLabel->setText("Data patches written to " + mapped->name());
+}
+
 void MainWindow::closeFile() {
     project_close();
 }
@@ -1427,6 +1450,10 @@ void MainWindow::showOptionsDialog() {
     current.safeMode = QSettings("Reclass", "Reclass").value("safeMode", false).toBool();
     current.autoStartMcp = QSettings("Reclass", "Reclass").value("autoStartMcp", false).toBool();
     current.refreshMs = QSettings("Reclass", "Reclass").value("refreshMs", 660).toInt();
+    current.refreshPrefetchLines = QSettings("Reclass", "Reclass").value("refreshPrefetchLines", 256).toInt();
+    current.softDirtyRefresh = QSettings("Reclass", "Reclass").value("softDirtyRefresh", false).toBool();
+    current.adaptiveRefresh = QSettings("Reclass", "Reclass").value("adaptiveRefresh", false).toBool();
+    current.historyBudgetMB = (int)(RcxController::historyBudget() / (1024 * 1024));
 
     OptionsDialog dlg(current, this);
     if (dlg.exec() != QDialog::Accepted) return; // OptionsDialog doesn't apply anything. Only apply on OK
@@ -1460,6 +1487,29 @@ void MainWindow::showOptionsDialog() {
         for (auto& tab : m_tabs)
             tab.ctrl->setRefreshInterval(r.refreshMs);
     }
+
+    if (r.refreshPrefetchLines != current.refreshPrefetchLines) {
+        QSettings("Reclass", "Reclass").setValue("refreshPrefetchLines", r.refreshPrefetchLines);
+        for (auto& tab : m_tabs)
+            tab.ctrl->setRefreshPrefetch(r.refreshPrefetchLines);
+    }
+
+    if (r.softDirtyRefresh != current.softDirtyRefresh) {
+        QSettings("Reclass", "Reclass").setValue("softDirtyRefresh", r.softDirtyRefresh);
+        for (auto& tab : m_tabs)
+            tab.ctrl->setDirtyTracking(r.softDirtyRefresh);
+    }
+
+    if (r.adaptiveRefresh != current.adaptiveRefresh) {
+        QSettings("Reclass", "Reclass").setValue("adaptiveRefresh", r.adaptiveRefresh);
+        for (auto& tab : m_tabs)
+            tab.ctrl->setAdaptiveRefresh(r.adaptiveRefresh);
+    }
+
+    if (r.historyBudgetMB != current.historyBudgetMB) {
+        QSettings("Reclass", "Reclass").setValue("historyBudgetMB", r.historyBudgetMB);
+        RcxController::setHistoryBudget((qint64)r.historyBudgetMB * 1024 * 1024);
+    }
 }
 
 void MainWindow::setEditorFont(const QString& fontName) {
@@ -1909,9 +1959,7 @@ void MainWindow::showTypeAliasesDialog() {
             newAliases[kKindMeta[i].kind] = val;
     }
 
-    tab->doc->typeAliases = newAliases;
-    tab->doc->modified = true;
-    tab->ctrl->refresh();
+    tab->ctrl->setTypeAliases(newAliases);
     updateWindowTitle();
 }
 
@@ -2193,12 +2241,88 @@ void MainWindow::createWorkspaceDock() {
         // Type/Enum node: navigate to it
         auto& tree = m_tabs[sub].doc->tree;
         int ni = tree.indexOfId(structId);
-        if (ni >= 0) tree.nodes[ni].collapsed = false;
+        if (ni >= 0) {
+            tree.nodes[ni].collapsed = false;
+            tree.invalidateLayout();
+        }
         m_tabs[sub].ctrl->setViewRootId(structId);
         m_tabs[sub].ctrl->scrollToNodeId(structId);
     });
 }
 
+void MainWindow::createHistoryDock() {
+    m_historyDock = new QDockWidget("History", this);
+    m_historyDock->setObjectName("HistoryDock");
+    m_historyDock->setAllowedAreas(Qt::TopDockWidgetArea | Qt::BottomDockWidgetArea);
+    m_historyDock->setFeatures(QDockWidget::DockWidgetClosable | QDockWidget::DockWidgetMovable);
+
+    auto* body = new QWidget(m_historyDock);
+    auto* layout = new QHBoxLayout(body);
+    layout->setContentsMargins(6, 2, 6, 2);
+
+    m_historySlider = new QSlider(Qt::Horizontal, body);
+    m_historySlider->setObjectName("historySlider");
+    m_historySlider->setRange(0, 0);
+    layout->addWidget(m_historySlider, 1);
+
+    m_historyLabel = new QLabel("Live", body);
+    m_historyLabel->setMinimumWidth(m_historyLabel->fontMetrics().horizontalAdvance(
+        QStringLiteral("0000 / 0000  00:00:00.000  (-000.0 s)")));
+    layout->addWidget(m_historyLabel);
+
+    auto* liveBtn = new QPushButton("Live", body);
+    liveBtn->setObjectName("historyLiveButton");
+    layout->addWidget(liveBtn);
+
+    // The rightmost slider position is the live view; the rest are frames
+    connect(m_historySlider, &QSlider::valueChanged, this, [this](int v) {
+        auto* ctrl = activeController();
+        if (!ctrl) return;
+        ctrl->scrubTo(v >= ctrl->history().count() ? -1 : v);
+    });
+    connect(liveBtn, &QPushButton::clicked, this, [this]() {
+        if (auto* ctrl = activeController()) ctrl->scrubTo(-1);
+    });
+
+    m_historyDock->setWidget(body);
+    addDockWidget(Qt::BottomDockWidgetArea, m_historyDock);
+    m_historyDock->hide();
+}
+
+void MainWindow::bindHistoryDock() {
+    disconnect(m_historyConn);
+    if (auto* ctrl = activeController())
+        m_historyConn = connect(ctrl, &RcxController::historyChanged,
+                                this, &MainWindow::syncHistoryDock);
+    syncHistoryDock();
+}
+
+void MainWindow::syncHistoryDock() {
+    auto* ctrl = activeController();
+    int count = ctrl ? ctrl->history().count() : 0;
+    int frame = ctrl ? ctrl->scrubFrame() : -1;
+
+    QSignalBlocker block(m_historySlider);
+    m_historySlider->setRange(0, count);
+    m_historySlider->setValue(frame < 0 ? count : frame);
+
+    if (frame < 0) {
+        m_historyLabel->setText(count > 0
+            ? QStringLiteral("Live  (%1 frames, %2 MB)")
+                  .arg(count)
+                  .arg(ctrl->history().memoryUsage() / (1024.0 * 1024.0), 0, 'f', 1)
+            : QStringLiteral("Live"));
+        return;
+    }
+    const auto& h = ctrl->history();
+    qint64 ts = h.timestamp(frame);
+    double ago = (h.timestamp(count - 1) - ts) / 1000.0;
+    m_historyLabel->setText(QStringLiteral("%1 / %2  %3  (-%4 s)")
+        .arg(frame + 1).arg(count)
+        .arg(QDateTime::fromMSecsSinceEpoch(ts).toString("HH:mm:ss.zzz"))
+        .arg(ago, 0, 'f', 1));
+}
+
 void MainWindow::rebuildAllDocs() {
     m_allDocs.clear();
     for (auto it = m_tabs.begin(); it != m_tabs.end(); ++it)
@@ -2225,6 +2349,9 @@ void MainWindow::populateSourceMenu() {
     m_sourceMenu->addAction("File", this, [this]() {
         if (auto* c = activeController()) c->selectSource(QStringLiteral("File"));
     });
+    m_sourceMenu->addAction("Raw File", this, [this]() {
+        if (auto* c = activeController()) c->selectSource(QStringLiteral("Raw File"));
+    });
 
     const auto& providers = ProviderRegistry::instance().providers();
     for (const auto& prov : providers) {
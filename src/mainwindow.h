@@ -14,6 +14,7 @@
 #include <QMap>
 #include <QButtonGroup>
 #include <QPushButton>
+#include <QSlider>
 #include <Qsci/qsciscintilla.h>
 
 namespace rcx {
@@ -34,6 +35,7 @@ private slots:
     void openFile();
     void saveFile();
     void saveFileAs();
+    void saveDataPatches();
     void closeFile();
 
     void addNode();
@@ -136,6 +138,15 @@ private:
     void rebuildWorkspaceModel();
     void updateBorderColor(const QColor& color);
 
+    // History dock (time-travel scrubber for the active tab)
+    QDockWidget*            m_historyDock   = nullptr;
+    QSlider*                m_historySlider = nullptr;
+    QLabel*                 m_historyLabel  = nullptr;
+    QMetaObject::Connection m_historyConn;
+    void createHistoryDock();
+    void bindHistoryDock();
+    void syncHistoryDock();
+
 protected:
     void changeEvent(QEvent* event) override;
     void resizeEvent(QResizeEvent* event) override;
@@ -3,8 +3,10 @@
 #include "controller.h"
 #include "generator.h"
 #include "mainwindow.h"
+#include "providers/async_read.h"
 #include <QCoreApplication>
 #include <QDebug>
+#include <QPointer>
 #include <cstring>
 
 namespace rcx {
@@ -174,7 +176,9 @@ void McpBridge::processLine(const QByteArray& line) {
     } else if (method == "tools/list") {
         sendJson(handleToolsList(id));
     } else if (method == "tools/call") {
-        sendJson(handleToolsCall(id, req.value("params").toObject()));
+        // Tools that read provider memory reply later (empty result here)
+        QJsonObject reply = handleToolsCall(id, req.value("params").toObject());
+        if (!reply.isEmpty()) sendJson(reply);
     } else {
         sendJson(errReply(id, -32601, "Method not found: " + method));
     }
@@ -273,6 +277,9 @@ QJsonObject McpBridge::handleToolsList(const QJsonValue& id) {
                     {"description", "MDI tab index (0-based). Omit for active tab."}}},
                 {"sourceIndex", QJsonObject{{"type", "integer"}}},
                 {"filePath", QJsonObject{{"type", "string"}}},
+                {"raw", QJsonObject{{"type", "boolean"},
+                    {"description", "With filePath: map ELF/PE files flat at their file "
+                                    "offsets instead of at their virtual addresses."}}},
                 {"pid", QJsonObject{{"type", "integer"},
                     {"description", "Process ID to attach to for live memory reading."}}},
                 {"processName", QJsonObject{{"type", "string"},
@@ -372,7 +379,7 @@ QJsonObject McpBridge::handleToolsCall(const QJsonValue& id, const QJsonObject&
     if      (toolName == "project.state")  result = toolProjectState(args);
     else if (toolName == "tree.apply")     result = toolTreeApply(args);
     else if (toolName == "source.switch")  result = toolSourceSwitch(args);
-    else if (toolName == "hex.read")       result = toolHexRead(args);
+    else if (toolName == "hex.read")       { toolHexRead(id, args); return {}; }
     else if (toolName == "hex.write")      result = toolHexWrite(args);
     else if (toolName == "status.set")     result = toolStatusSet(args);
     else if (toolName == "ui.action")      result = toolUiAction(args);
@@ -450,7 +457,7 @@ QJsonObject McpBridge::toolProjectState(const QJsonObject& args) {
         provInfo["name"] = doc->provider->name();
         provInfo["writable"] = doc->provider->isWritable();
         provInfo["live"] = doc->provider->isLive();
-        provInfo["size"] = doc->provider->size();
+        provInfo["size"] = (qint64)doc->provider->size64();
         provInfo["kind"] = doc->provider->kind();
     }
     state["provider"] = provInfo;
@@ -484,10 +491,7 @@ QJsonObject McpBridge::toolProjectState(const QJsonObject& args) {
 
     // Filtered tree: only emit nodes up to maxDepth from the filter root
     if (includeTree) {
-        // Build parent→children map once
-        QHash<uint64_t, QVector<int>> childMap;
-        for (int i = 0; i < tree.nodes.size(); i++)
-            childMap[tree.nodes[i].parentId].append(i);
+        const auto& childMap = tree.layoutIndex().children;
 
         // BFS from filterParentId, respecting maxDepth
         QJsonArray nodeArr;
@@ -505,7 +509,7 @@ QJsonObject McpBridge::toolProjectState(const QJsonObject& args) {
                 QJsonObject nj = n.toJson();
                 // Add computed size for containers
                 if (n.kind == NodeKind::Struct || n.kind == NodeKind::Array) {
-                    nj["computedSize"] = tree.structSpan(n.id, &childMap);
+                    nj["computedSize"] = tree.structSpan(n.id);
                     nj["childCount"] = childMap.value(n.id).size();
                 }
                 nodeArr.append(nj);
@@ -804,7 +808,7 @@ QJsonObject McpBridge::toolSourceSwitch(const QJsonObject& args) {
 
     if (args.contains("filePath")) {
         QString path = args.value("filePath").toString();
-        doc->loadData(path);
+        doc->loadData(path, !args.value("raw").toBool());
         ctrl->refresh();
         return makeTextResult("Loaded file: " + path);
     }
@@ -816,12 +820,12 @@ QJsonObject McpBridge::toolSourceSwitch(const QJsonObject& args) {
 // TOOL: hex.read
 // ════════════════════════════════════════════════════════════════════
 
-QJsonObject McpBridge::toolHexRead(const QJsonObject& args) {
+void McpBridge::toolHexRead(const QJsonValue& id, const QJsonObject& args) {
     auto* tab = resolveTab(args);
-    if (!tab) return makeTextResult("No active tab", true);
+    if (!tab) { sendJson(okReply(id, makeTextResult("No active tab", true))); return; }
 
-    auto* prov = tab->doc->provider.get();
-    if (!prov) return makeTextResult("No provider", true);
+    auto prov = tab->doc->cachedProvider();
+    if (!prov) { sendJson(okReply(id, makeTextResult("No provider", true))); return; }
 
     int64_t offset = static_cast<int64_t>(args.value("offset").toDouble());
     int length = qMin(args.value("length").toInt(64), 4096);
@@ -829,11 +833,30 @@ QJsonObject McpBridge::toolHexRead(const QJsonObject& args) {
     if (!args.value("baseRelative").toBool())
         offset += (int64_t)tab->doc->tree.baseAddress;
 
-    if (offset < 0 || !prov->isReadable((uint64_t)offset, length))
-        return makeTextResult("Cannot read at offset " + QString::number(offset), true);
+    if (offset < 0 || !prov->isReadable((uint64_t)offset, length)) {
+        sendJson(okReply(id, makeTextResult("Cannot read at offset " + QString::number(offset), true)));
+        return;
+    }
 
-    QByteArray data = prov->readBytes((uint64_t)offset, length);
+    // The read runs off the UI thread; the reply goes out when it lands,
+    // provided the same client is still connected.
+    uint64_t base = tab->doc->tree.baseAddress;
+    int provSize = prov->size();
+    QPointer<QLocalSocket> client = m_client;
+    AsyncRead r;
+    r.addr = (uint64_t)offset;
+    r.len  = length;
+    readAsyncOn(this, prov, {r}, CancelToken(),
+        [this, id, client, offset, base, provSize](const QVector<AsyncRead>& reads) {
+            if (!client || client != m_client) return;
+            sendJson(okReply(id, makeTextResult(
+                formatHexRead(reads[0].data, offset, base, provSize))));
+        });
+}
 
+// Hex dump plus the common type interpretations of the first bytes
+QString McpBridge::formatHexRead(const QByteArray& data, int64_t offset,
+                                 uint64_t base, int provSize) {
     // Format hex dump (16 bytes per line)
     QString dump;
     for (int i = 0; i < data.size(); i += 16) {
@@ -877,8 +900,6 @@ QJsonObject McpBridge::toolHexRead(const QJsonObject& args) {
             dump += "f64: " + QString::number(dv) + "\n";
 
             // Pointer-likeness
-            uint64_t base = tab->doc->tree.baseAddress;
-            int provSize = prov->size();
             if (v >= base && v < base + (uint64_t)provSize)
                 dump += "ptr?: LIKELY (within provider range)\n";
         }
@@ -890,7 +911,7 @@ QJsonObject McpBridge::toolHexRead(const QJsonObject& args) {
             dump += "str?: " + QString::number(printable) + " printable ASCII bytes\n";
     }
 
-    return makeTextResult(dump);
+    return dump;
 }
 
 // ════════════════════════════════════════════════════════════════════
@@ -903,7 +924,8 @@ QJsonObject McpBridge::toolHexWrite(const QJsonObject& args) {
 
     auto* ctrl = tab->ctrl;
     auto* doc = tab->doc;
-    auto* prov = doc->provider.get();
+    auto provRef = doc->cachedProvider();
+    auto* prov = provRef.get();
 
     int64_t offset = static_cast<int64_t>(args.value("offset").toDouble());
     QString hexStr = args.value("hexBytes").toString().remove(' ');
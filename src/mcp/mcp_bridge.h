@@ -54,13 +54,15 @@ private:
     QJsonObject toolProjectState(const QJsonObject& args);
     QJsonObject toolTreeApply(const QJsonObject& args);
     QJsonObject toolSourceSwitch(const QJsonObject& args);
-    QJsonObject toolHexRead(const QJsonObject& args);
+    void toolHexRead(const QJsonValue& id, const QJsonObject& args);   // replies asynchronously
     QJsonObject toolHexWrite(const QJsonObject& args);
     QJsonObject toolStatusSet(const QJsonObject& args);
     QJsonObject toolUiAction(const QJsonObject& args);
 
     // Helpers
     QJsonObject makeTextResult(const QString& text, bool isError = false);
+    static QString formatHexRead(const QByteArray& data, int64_t offset,
+                                 uint64_t base, int provSize);
     QString resolvePlaceholder(const QString& ref,
                                const QHash<QString, uint64_t>& placeholderMap);
 
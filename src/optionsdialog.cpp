@@ -79,6 +79,63 @@ OptionsDialog::OptionsDialog(const OptionsResult& current, QWidget* parent)
     refreshDesc->setContentsMargins(0, 0, 0, 0);
     refreshLayout->addRow(refreshDesc);
 
+    m_prefetchSpin = new QSpinBox;
+    m_prefetchSpin->setRange(0, 100000);
+    m_prefetchSpin->setSingleStep(64);
+    m_prefetchSpin->setValue(current.refreshPrefetchLines);
+    m_prefetchSpin->setSuffix(" lines");
+    m_prefetchSpin->setObjectName("prefetchSpin");
+    refreshLayout->addRow("Prefetch:", m_prefetchSpin);
+
+    auto* prefetchDesc = new QLabel(
+        "Only the lines on screen and this many lines above and below them are "
+        "re-read; the rest is updated when scrolled into view. Default: 256 lines.");
+    prefetchDesc->setWordWrap(true);
+    prefetchDesc->setContentsMargins(0, 0, 0, 0);
+    refreshLayout->addRow(prefetchDesc);
+
+    m_softDirtyCheck = new QCheckBox("Only re-read pages the process wrote to");
+    m_softDirtyCheck->setChecked(current.softDirtyRefresh);
+    m_softDirtyCheck->setObjectName("softDirtyCheck");
+    refreshLayout->addRow(m_softDirtyCheck);
+
+    auto* softDirtyDesc = new QLabel(
+        "Uses the Linux kernel's soft-dirty page tracking to skip pages that have not "
+        "changed since the last refresh. Cuts reads on large, mostly static structures. "
+        "Ignored for sources that cannot track writes.");
+    softDirtyDesc->setWordWrap(true);
+    softDirtyDesc->setContentsMargins(0, 0, 0, 0);
+    refreshLayout->addRow(softDirtyDesc);
+
+    m_adaptiveCheck = new QCheckBox("Poll changing memory faster");
+    m_adaptiveCheck->setChecked(current.adaptiveRefresh);
+    m_adaptiveCheck->setObjectName("adaptiveRefreshCheck");
+    refreshLayout->addRow(m_adaptiveCheck);
+
+    auto* adaptiveDesc = new QLabel(
+        "Re-reads pages that keep changing up to 60 times a second and backs pages "
+        "that stay the same off to the interval above. Turn off to re-read everything "
+        "at the interval. Not used while soft-dirty tracking is on.");
+    adaptiveDesc->setWordWrap(true);
+    adaptiveDesc->setContentsMargins(0, 0, 0, 0);
+    refreshLayout->addRow(adaptiveDesc);
+
+    m_historySpin = new QSpinBox;
+    m_historySpin->setRange(0, 65536);
+    m_historySpin->setSingleStep(64);
+    m_historySpin->setValue(current.historyBudgetMB);
+    m_historySpin->setSuffix(" MB");
+    m_historySpin->setSpecialValueText("Off");
+    m_historySpin->setObjectName("historyBudgetSpin");
+    refreshLayout->addRow("History:", m_historySpin);
+
+    auto* historyDesc = new QLabel(
+        "Memory kept for scrubbing back through past refreshes, shared by all open "
+        "tabs. The oldest snapshots are dropped first. Default: 256 MB.");
+    historyDesc->setWordWrap(true);
+    historyDesc->setContentsMargins(0, 0, 0, 0);
+    refreshLayout->addRow(historyDesc);
+
     generalLayout->addWidget(refreshGroup);
 
     // Visual Experience group box
@@ -208,6 +265,10 @@ OptionsResult OptionsDialog::result() const {
     r.safeMode = m_safeModeCheck->isChecked();
     r.autoStartMcp = m_autoMcpCheck->isChecked();
     r.refreshMs = m_refreshSpin->value();
+    r.refreshPrefetchLines = m_prefetchSpin->value();
+    r.softDirtyRefresh = m_softDirtyCheck->isChecked();
+    r.adaptiveRefresh = m_adaptiveCheck->isChecked();
+    r.historyBudgetMB = m_historySpin->value();
     return r;
 }
 
@@ -18,6 +18,10 @@ struct OptionsResult {
     bool    safeMode = false;
     bool    autoStartMcp = false;
     int     refreshMs = 660;
+    int     refreshPrefetchLines = 256;
+    bool    softDirtyRefresh = false;
+    bool    adaptiveRefresh = false;
+    int     historyBudgetMB = 256;
 };
 
 class OptionsDialog : public QDialog {
@@ -41,6 +45,10 @@ private:
     QCheckBox*      m_safeModeCheck  = nullptr;
     QCheckBox*      m_autoMcpCheck   = nullptr;
     QSpinBox*       m_refreshSpin    = nullptr;
+    QSpinBox*       m_prefetchSpin   = nullptr;
+    QCheckBox*      m_softDirtyCheck = nullptr;
+    QCheckBox*      m_adaptiveCheck  = nullptr;
+    QSpinBox*       m_historySpin    = nullptr;
 
     // searchable keywords per leaf tree item
     QHash<QTreeWidgetItem*, QStringList> m_pageKeywords;
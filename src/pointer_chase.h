@@ -0,0 +1,179 @@
+#pragma once
+#include "core.h"
+#include <QHash>
+#include <QSet>
+#include <cstring>
+#include <functional>
+
+namespace rcx {
+
+// Pointer layout of a tree, copied out so a background refresh can follow
+// pointers through the pages it has just fetched instead of through the
+// previous snapshot.
+//
+// run() fetches in rounds: the root range first, then every target of the
+// expanded pointers found in it, then theirs, down to maxDepth.  Each round
+// is one fetch call, and the pages of all rounds come back as one map, so
+// a pointer that changed is followed in the same tick and a chain of N
+// pointers settles in one refresh instead of N.  predict() walks the same
+// layout through the last snapshot to decide which pages are due.
+//
+// Building a plan walks the whole tree; the controller keeps one per tree
+// generation and only patches rootBase between ticks.
+struct ChasePlan {
+    using PageMap = QHash<uint64_t, QByteArray>;
+    // Adds the listed pages (page-aligned, none already present) to `into`.
+    // Pages it cannot read may be left out; pointers on them are not followed.
+    using Fetch = std::function<void(const QVector<uint64_t>& pages, PageMap& into)>;
+
+    static constexpr uint64_t kPageSize = 4096;
+
+    struct Pointer {
+        int      offset;
+        int      size;      // 4 or 8
+        uint64_t refId;
+    };
+    struct Layout {
+        int              span = 0;
+        QVector<Pointer> pointers;   // expanded (not collapsed, typed) only
+        uint64_t         embedRef = 0;  // struct with a refId and no own children
+    };
+
+    QHash<uint64_t, Layout> layouts;   // every struct reachable from the root
+    uint64_t rootId     = 0;
+    uint64_t rootBase   = 0;
+    int      rootExtent = 0;
+    int      maxDepth   = 99;
+
+    static ChasePlan build(const NodeTree& tree, uint64_t rootId, uint64_t rootBase,
+                           int rootExtent, int maxDepth = 99) {
+        ChasePlan plan;
+        plan.rootId = rootId;
+        plan.rootBase = rootBase;
+        plan.rootExtent = rootExtent;
+        plan.maxDepth = maxDepth;
+
+        const auto& childMap = tree.layoutIndex().children;
+
+        QVector<uint64_t> work{rootId};
+        while (!work.isEmpty()) {
+            uint64_t id = work.takeLast();
+            if (id == 0 || plan.layouts.contains(id)) continue;
+            Layout& l = plan.layouts[id];
+            l.span = tree.structSpan(id);
+            const QVector<int> children = childMap.value(id);
+            for (int ci : children) {
+                const Node& child = tree.nodes[ci];
+                if (child.kind != NodeKind::Pointer32 && child.kind != NodeKind::Pointer64)
+                    continue;
+                if (child.collapsed || child.refId == 0) continue;
+                l.pointers.append({child.offset, child.byteSize(), child.refId});
+                work.append(child.refId);
+            }
+            int idx = tree.indexOfId(id);
+            if (idx >= 0 && children.isEmpty()) {
+                const Node& sn = tree.nodes[idx];
+                if (sn.kind == NodeKind::Struct && sn.refId != 0) {
+                    l.embedRef = sn.refId;
+                    work.append(sn.refId);
+                }
+            }
+        }
+        return plan;
+    }
+
+    PageMap run(const Fetch& fetch, int* rounds = nullptr) const {
+        struct Item { uint64_t id; uint64_t base; int depth; };
+
+        PageMap pages;
+        QSet<QPair<uint64_t, uint64_t>> visited;
+        QVector<Item> frontier{{rootId, rootBase, 0}};
+        QVector<QPair<uint64_t, int>> ranges;
+        if (rootExtent > 0) ranges.append({rootBase, rootExtent});
+        if (rounds) *rounds = 0;
+
+        while (!frontier.isEmpty()) {
+            QVector<Item> admitted;
+            for (const Item& it : frontier) {
+                if (it.depth >= maxDepth) continue;
+                QPair<uint64_t, uint64_t> key{it.id, it.base};
+                if (visited.contains(key)) continue;
+                visited.insert(key);
+                auto l = layouts.constFind(it.id);
+                if (l == layouts.constEnd() || l->span <= 0) continue;
+                ranges.append({it.base, l->span});
+                admitted.append(it);
+            }
+
+            QVector<uint64_t> want;
+            QSet<uint64_t> seen;
+            for (const auto& r : ranges) {
+                uint64_t end = r.first + uint64_t(r.second);
+                for (uint64_t p = r.first & ~(kPageSize - 1); p < end; p += kPageSize) {
+                    if (pages.contains(p) || seen.contains(p)) continue;
+                    seen.insert(p);
+                    want.append(p);
+                }
+            }
+            ranges.clear();
+            if (!want.isEmpty()) {
+                fetch(want, pages);
+                if (rounds) ++*rounds;
+            }
+
+            QVector<Item> next;
+            for (const Item& it : admitted) {
+                const Layout& l = *layouts.constFind(it.id);
+                for (const Pointer& p : l.pointers) {
+                    uint64_t val = 0;
+                    if (!readFrom(pages, it.base + uint64_t(p.offset), &val, p.size)) continue;
+                    if (val == 0 || val == UINT64_MAX) continue;
+                    next.append({p.refId, val, it.depth + 1});
+                }
+                if (l.embedRef)
+                    next.append({l.embedRef, it.base, it.depth});
+            }
+            frontier = std::move(next);
+        }
+        return pages;
+    }
+
+    // The pages run() would fetch if memory still held `known`, in fetch
+    // order.  Pointers are followed only through pages present in `known`;
+    // nothing is read.
+    QVector<uint64_t> predict(const PageMap& known) const {
+        QVector<uint64_t> order;
+        QSet<uint64_t> seen;
+        run([&](const QVector<uint64_t>& want, PageMap& into) {
+            for (uint64_t p : want) {
+                if (!seen.contains(p)) {
+                    seen.insert(p);
+                    order.append(p);
+                }
+                auto it = known.constFind(p);
+                if (it != known.constEnd()) into.insert(p, it.value());
+            }
+        });
+        return order;
+    }
+
+private:
+    // Little-endian value of len (<= 8) bytes, if every page is present
+    static bool readFrom(const PageMap& pages, uint64_t addr, uint64_t* out, int len) {
+        char buf[8] = {};
+        for (int done = 0; done < len; ) {
+            uint64_t cur = addr + uint64_t(done);
+            uint64_t page = cur & ~(kPageSize - 1);
+            auto it = pages.constFind(page);
+            if (it == pages.constEnd() || it->size() < int(kPageSize)) return false;
+            int off = int(cur - page);
+            int chunk = qMin(len - done, int(kPageSize) - off);
+            std::memcpy(buf + done, it->constData() + off, chunk);
+            done += chunk;
+        }
+        std::memcpy(out, buf, 8);
+        return true;
+    }
+};
+
+} // namespace rcx
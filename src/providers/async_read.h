@@ -0,0 +1,52 @@
+#pragma once
+#include "provider.h"
+#include <QFuture>
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <QObject>
+
+namespace rcx {
+
+// Future over Provider::readAsync.  The future is cancelled rather than
+// given a result when the token fires first.  prov is kept alive until the
+// read finishes, so the caller may drop its own reference.
+inline QFuture<QVector<AsyncRead>> readFuture(std::shared_ptr<Provider> prov,
+                                              QVector<AsyncRead> reads,
+                                              CancelToken token = {}) {
+    QFutureInterface<QVector<AsyncRead>> fi;
+    fi.reportStarted();
+    QFuture<QVector<AsyncRead>> future = fi.future();
+    if (!prov) {
+        fi.cancel();
+        fi.reportFinished();
+        return future;
+    }
+    const Provider* raw = prov.get();
+    raw->readAsync(std::move(reads), token,
+        [fi, prov](QVector<AsyncRead> result, bool cancelled) mutable {
+            if (cancelled)
+                fi.cancel();
+            else
+                fi.reportResult(result);
+            fi.reportFinished();
+        });
+    return future;
+}
+
+// Read without blocking and hand the result to onDone on context's thread.
+// onDone is skipped if the token was cancelled by the time the result
+// arrives, or if context has been destroyed.
+template<typename Fn>
+void readAsyncOn(QObject* context, std::shared_ptr<Provider> prov,
+                 QVector<AsyncRead> reads, CancelToken token, Fn onDone) {
+    auto* watcher = new QFutureWatcher<QVector<AsyncRead>>(context);
+    QObject::connect(watcher, &QFutureWatcherBase::finished, context,
+        [watcher, token, onDone]() {
+            watcher->deleteLater();
+            if (watcher->isCanceled() || token.isCancelled()) return;
+            onDone(watcher->result());
+        });
+    watcher->setFuture(readFuture(std::move(prov), std::move(reads), token));
+}
+
+} // namespace rcx
@@ -0,0 +1,263 @@
+#pragma once
+#include "provider.h"
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <atomic>
+#include <list>
+#include <memory>
+
+namespace rcx {
+
+// Read-through page cache in front of a (usually live) provider.
+//
+// Holds a bounded LRU of 4 KB pages.  A page older than the TTL is treated
+// as stale and re-fetched on next touch, so values can lag the target by at
+// most ttlMs.  Failed page reads are cached too (negative entries), which
+// keeps repeated hovers over a garbage pointer from hammering the target.
+//
+// Writes go straight to the wrapped provider and patch any cached copy.
+// Everything else (regions, symbols, readability) is forwarded untouched.
+//
+// Use shared() to get the one cache for a given provider, so the hover
+// disassembly, struct preview, MCP reads and value editing all hit the same
+// pages instead of each issuing their own target reads.
+class CachingProvider : public Provider {
+public:
+    static constexpr uint64_t kPageSize = 4096;
+    static constexpr uint64_t kPageMask = ~(kPageSize - 1);
+    static constexpr int kDefaultCapacity = 2048;   // pages (8 MB)
+    static constexpr int kDefaultTtlMs    = 250;
+
+    explicit CachingProvider(std::shared_ptr<Provider> real,
+                             int capacityPages = kDefaultCapacity,
+                             int ttlMs = kDefaultTtlMs)
+        : m_real(std::move(real))
+        , m_capacity(qMax(1, capacityPages))
+        , m_ttlMs(ttlMs)
+    {
+        m_clock.start();
+    }
+
+    CachingProvider(const CachingProvider&) = delete;
+    CachingProvider& operator=(const CachingProvider&) = delete;
+
+    // The shared cache for `real`.  Every caller passing the same provider
+    // gets the same instance for as long as someone holds it.  Non-live
+    // providers are returned as-is: their data cannot go stale and they are
+    // already cheap to read.
+    static std::shared_ptr<Provider> shared(const std::shared_ptr<Provider>& real) {
+        if (!real || !real->isLive()) return real;
+        static QMutex lock;
+        static QHash<const Provider*, std::weak_ptr<CachingProvider>> registry;
+        QMutexLocker guard(&lock);
+        for (auto it = registry.begin(); it != registry.end(); ) {
+            if (it.value().expired()) it = registry.erase(it);
+            else ++it;
+        }
+        if (auto existing = registry.value(real.get()).lock())
+            return existing;
+        auto cache = std::make_shared<CachingProvider>(real);
+        registry.insert(real.get(), cache);
+        return cache;
+    }
+
+    const std::shared_ptr<Provider>& real() const { return m_real; }
+
+    bool read(uint64_t addr, void* buf, int len) const override {
+        if (len <= 0 || !m_real) return false;
+        uint64_t end = addr + static_cast<uint64_t>(len);
+        if (end < addr) return false;
+
+        // Look up every page the range touches; collect the misses so they
+        // go to the target as one batch.
+        uint64_t first = addr & kPageMask;
+        int pageCount = static_cast<int>((((end - 1) & kPageMask) - first) / kPageSize) + 1;
+        QVector<Page> pages(pageCount);
+        QVector<bool> fresh(pageCount, false);
+        QVector<int> missing;
+        {
+            QMutexLocker guard(&m_lock);
+            qint64 now = m_clock.elapsed();
+            for (int i = 0; i < pageCount; i++) {
+                uint64_t pageAddr = first + static_cast<uint64_t>(i) * kPageSize;
+                auto it = m_pages.find(pageAddr);
+                if (it != m_pages.end() && now - it->fetchedAt < m_ttlMs) {
+                    m_lru.splice(m_lru.begin(), m_lru, it->lruPos);
+                    pages[i] = *it;
+                    m_hits.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    missing.append(i);
+                    fresh[i] = true;
+                    m_misses.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        if (!missing.isEmpty()) {
+            // Fetch outside the lock so a slow target does not stall other
+            // readers that only need cached pages.
+            QVector<ReadRequest> reqs(missing.size());
+            for (int j = 0; j < missing.size(); j++) {
+                Page& p = pages[missing[j]];
+                p.data = QByteArray(static_cast<int>(kPageSize), Qt::Uninitialized);
+                reqs[j].addr = first + static_cast<uint64_t>(missing[j]) * kPageSize;
+                reqs[j].buf  = p.data.data();
+                reqs[j].len  = static_cast<int>(kPageSize);
+            }
+            m_real->readBatch(reqs.data(), reqs.size());
+
+            QMutexLocker guard(&m_lock);
+            qint64 now = m_clock.elapsed();
+            for (int j = 0; j < missing.size(); j++) {
+                Page& p = pages[missing[j]];
+                p.ok = reqs[j].ok;
+                if (!p.ok) p.data.clear();
+                p.fetchedAt = now;
+                storeLocked(reqs[j].addr, p);
+            }
+        }
+
+        // A page that failed as a whole may still be partly readable (the
+        // last page of a region that ends mid-page on some transports); on
+        // the fetch that discovered the failure, retry just the requested
+        // bytes.  Cached negative pages fail without touching the target.
+        char* out = static_cast<char*>(buf);
+        uint64_t cur = addr;
+        int remaining = len;
+        bool ok = true;
+        for (int i = 0; i < pageCount; i++) {
+            uint64_t pageAddr = first + static_cast<uint64_t>(i) * kPageSize;
+            int pageOff = static_cast<int>(cur - pageAddr);
+            int chunk = qMin(remaining, static_cast<int>(kPageSize) - pageOff);
+            const Page& p = pages[i];
+            if (p.ok)
+                std::memcpy(out, p.data.constData() + pageOff, chunk);
+            else if (!fresh[i] || !m_real->read(cur, out, chunk)) {
+                std::memset(out, 0, chunk);
+                ok = false;
+            }
+            out += chunk;
+            cur += chunk;
+            remaining -= chunk;
+        }
+        return ok;
+    }
+
+    bool write(uint64_t addr, const void* buf, int len) override {
+        if (!m_real || !m_real->write(addr, buf, len)) return false;
+        QMutexLocker guard(&m_lock);
+        const char* src = static_cast<const char*>(buf);
+        uint64_t cur = addr;
+        int remaining = len;
+        while (remaining > 0) {
+            uint64_t pageAddr = cur & kPageMask;
+            int pageOff = static_cast<int>(cur - pageAddr);
+            int chunk = qMin(remaining, static_cast<int>(kPageSize) - pageOff);
+            auto it = m_pages.find(pageAddr);
+            if (it != m_pages.end()) {
+                if (it->ok)
+                    std::memcpy(it->data.data() + pageOff, src, chunk);
+                else
+                    dropLocked(it);
+            }
+            src += chunk;
+            cur += chunk;
+            remaining -= chunk;
+        }
+        return true;
+    }
+
+    int size() const override { return m_real ? m_real->size() : 0; }
+    uint64_t size64() const override { return m_real ? m_real->size64() : 0; }
+    bool isWritable() const override { return m_real && m_real->isWritable(); }
+    bool isLive() const override { return m_real && m_real->isLive(); }
+    QString name() const override { return m_real ? m_real->name() : QString(); }
+    QString kind() const override { return m_real ? m_real->kind() : QStringLiteral("File"); }
+    uint64_t base() const override { return m_real ? m_real->base() : 0; }
+    bool isReadable(uint64_t addr, int len) const override {
+        return m_real && m_real->isReadable(addr, len);
+    }
+    QVector<MemoryRegion> regions() const override {
+        return m_real ? m_real->regions() : QVector<MemoryRegion>();
+    }
+    QString getSymbol(uint64_t addr) const override {
+        return m_real ? m_real->getSymbol(addr) : QString();
+    }
+    uint64_t symbolToAddress(const QString& n) const override {
+        return m_real ? m_real->symbolToAddress(n) : 0;
+    }
+
+    // ── Cache control ──
+
+    void setTtlMs(int ms) { QMutexLocker guard(&m_lock); m_ttlMs = ms; }
+    int ttlMs() const { QMutexLocker guard(&m_lock); return m_ttlMs; }
+
+    void setCapacity(int pages) {
+        QMutexLocker guard(&m_lock);
+        m_capacity = qMax(1, pages);
+        while (m_pages.size() > m_capacity)
+            evictOneLocked();
+    }
+    int capacity() const { QMutexLocker guard(&m_lock); return m_capacity; }
+    int cachedPages() const { QMutexLocker guard(&m_lock); return m_pages.size(); }
+
+    void invalidate() {
+        QMutexLocker guard(&m_lock);
+        m_pages.clear();
+        m_lru.clear();
+    }
+
+    // Page lookups served from cache vs. sent to the target
+    uint64_t hits() const   { return m_hits.load(std::memory_order_relaxed); }
+    uint64_t misses() const { return m_misses.load(std::memory_order_relaxed); }
+    void resetStats() { m_hits.store(0); m_misses.store(0); }
+
+private:
+    struct Page {
+        QByteArray data;        // kPageSize bytes when ok, empty otherwise
+        bool       ok = false;
+        qint64     fetchedAt = 0;
+        std::list<uint64_t>::iterator lruPos;
+    };
+
+    void storeLocked(uint64_t pageAddr, Page p) const {
+        auto it = m_pages.find(pageAddr);
+        if (it != m_pages.end()) {
+            m_lru.splice(m_lru.begin(), m_lru, it->lruPos);
+            p.lruPos = it->lruPos;
+            *it = std::move(p);
+            return;
+        }
+        while (m_pages.size() >= m_capacity)
+            evictOneLocked();
+        m_lru.push_front(pageAddr);
+        p.lruPos = m_lru.begin();
+        m_pages.insert(pageAddr, std::move(p));
+    }
+
+    void dropLocked(QHash<uint64_t, Page>::iterator it) const {
+        m_lru.erase(it->lruPos);
+        m_pages.erase(it);
+    }
+
+    void evictOneLocked() const {
+        if (m_lru.empty()) return;
+        m_pages.remove(m_lru.back());
+        m_lru.pop_back();
+    }
+
+    std::shared_ptr<Provider> m_real;
+    int m_capacity;
+    int m_ttlMs;
+
+    mutable QMutex m_lock;
+    mutable QElapsedTimer m_clock;
+    mutable QHash<uint64_t, Page> m_pages;
+    mutable std::list<uint64_t> m_lru;       // front = most recently used
+    mutable std::atomic<uint64_t> m_hits{0};
+    mutable std::atomic<uint64_t> m_misses{0};
+};
+
+} // namespace rcx
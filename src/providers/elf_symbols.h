@@ -0,0 +1,411 @@
+#pragma once
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QString>
+#include <QVector>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <memory>
+
+#if defined(__has_include)
+#  if __has_include(<cxxabi.h>)
+#    include <cxxabi.h>
+#    define RCX_HAVE_CXXABI 1
+#  endif
+#endif
+
+namespace rcx {
+
+// ──────────────────────────────────────────────────────────────────────────
+// ElfSymbolTable
+//
+// Function and object symbols of one ELF image (.symtab and .dynsym),
+// sorted by link-time address for binary search.  The file is memory-mapped
+// and names stay in the mapping, so indexing a library costs one pass over
+// its symbol tables and no string copies.  Fields are decoded straight from
+// the byte layout (no <elf.h>); little-endian images only.
+// ──────────────────────────────────────────────────────────────────────────
+
+class ElfSymbolTable {
+public:
+    explicit ElfSymbolTable(const QString& path) : m_file(path) {
+        if (!m_file.open(QIODevice::ReadOnly)) return;
+        qint64 size = m_file.size();
+        if (size < 64) return;
+        m_map = m_file.map(0, size);
+        if (!m_map) return;
+        m_size = static_cast<uint64_t>(size);
+        if (!parse()) {
+            m_syms.clear();
+            m_file.unmap(const_cast<uchar*>(m_map));
+            m_map = nullptr;
+        }
+    }
+
+    ~ElfSymbolTable() {
+        if (m_map) m_file.unmap(const_cast<uchar*>(m_map));
+    }
+
+    ElfSymbolTable(const ElfSymbolTable&) = delete;
+    ElfSymbolTable& operator=(const ElfSymbolTable&) = delete;
+
+    bool isValid() const { return m_map != nullptr; }
+    int  symbolCount() const { return m_syms.size(); }
+
+    // Lowest PT_LOAD address, page-aligned.  A module mapped at base has
+    // load bias base - imageBase().
+    uint64_t imageBase() const { return m_imageBase; }
+
+    // Raw (mangled) name of the symbol covering link-time address vaddr,
+    // with *offset set to vaddr minus the symbol's start.  Sized symbols
+    // cover [value, value+size); unsized ones only their own address.
+    const char* lookup(uint64_t vaddr, uint64_t* offset) const {
+        auto it = std::upper_bound(m_syms.begin(), m_syms.end(), vaddr,
+            [](uint64_t a, const Sym& s) { return a < s.value; });
+        // Two candidates cover nesting (a sized symbol right before an
+        // unsized label)
+        for (int step = 0; step < 2 && it != m_syms.begin(); step++) {
+            --it;
+            uint64_t off = vaddr - it->value;
+            if (off == 0 || off < it->size) {
+                if (offset) *offset = off;
+                return reinterpret_cast<const char*>(m_map + it->name);
+            }
+        }
+        return nullptr;
+    }
+
+    // Every indexed symbol as (raw name, link-time address)
+    template<typename Fn>
+    void forEachSymbol(Fn fn) const {
+        for (const Sym& s : m_syms)
+            fn(reinterpret_cast<const char*>(m_map + s.name), s.value);
+    }
+
+private:
+    struct Sym {
+        uint64_t value;
+        uint64_t size;
+        uint64_t name;    // file offset of the NUL-terminated name
+    };
+
+    QFile           m_file;
+    const uchar*    m_map = nullptr;
+    uint64_t        m_size = 0;
+    uint64_t        m_imageBase = 0;
+    QVector<Sym>    m_syms;
+
+    static constexpr uint8_t  kClass32   = 1;
+    static constexpr uint8_t  kClass64   = 2;
+    static constexpr uint8_t  kDataLsb   = 1;
+    static constexpr uint32_t kPtLoad    = 1;
+    static constexpr uint32_t kShtSymtab = 2;
+    static constexpr uint32_t kShtDynsym = 11;
+    static constexpr uint8_t  kSttObject = 1;
+    static constexpr uint8_t  kSttFunc   = 2;
+    static constexpr uint8_t  kSttIfunc  = 10;
+
+    template<typename T>
+    T rd(uint64_t off) const { T v; std::memcpy(&v, m_map + off, sizeof(T)); return v; }
+
+    bool inFile(uint64_t off, uint64_t len) const {
+        return off <= m_size && len <= m_size - off;
+    }
+
+    bool parse() {
+        if (std::memcmp(m_map, "\x7f" "ELF", 4) != 0) return false;
+        uint8_t cls = m_map[4];
+        if ((cls != kClass32 && cls != kClass64) || m_map[5] != kDataLsb) return false;
+        bool is64 = cls == kClass64;
+
+        uint64_t phoff = is64 ? rd<uint64_t>(32) : rd<uint32_t>(28);
+        uint64_t shoff = is64 ? rd<uint64_t>(40) : rd<uint32_t>(32);
+        uint32_t phentsize = rd<uint16_t>(is64 ? 54 : 42);
+        uint32_t phnum     = rd<uint16_t>(is64 ? 56 : 44);
+        uint32_t shentsize = rd<uint16_t>(is64 ? 58 : 46);
+        uint32_t shnum     = rd<uint16_t>(is64 ? 60 : 48);
+
+        // Image base: lowest loadable segment
+        bool haveLoad = false;
+        uint64_t minVaddr = 0;
+        if (phentsize >= (is64 ? 56u : 32u) && inFile(phoff, uint64_t(phnum) * phentsize)) {
+            for (uint32_t i = 0; i < phnum; i++) {
+                uint64_t ph = phoff + uint64_t(i) * phentsize;
+                if (rd<uint32_t>(ph) != kPtLoad) continue;
+                uint64_t vaddr = is64 ? rd<uint64_t>(ph + 16) : rd<uint32_t>(ph + 8);
+                if (!haveLoad || vaddr < minVaddr) minVaddr = vaddr;
+                haveLoad = true;
+            }
+        }
+        m_imageBase = minVaddr & ~uint64_t(0xFFF);
+
+        if (shentsize < (is64 ? 64u : 40u) || !inFile(shoff, uint64_t(shnum) * shentsize))
+            return false;
+
+        auto shField = [&](uint32_t idx, int off64, int off32, bool wide) -> uint64_t {
+            uint64_t sh = shoff + uint64_t(idx) * shentsize;
+            if (is64) return wide ? rd<uint64_t>(sh + off64) : rd<uint32_t>(sh + off64);
+            return rd<uint32_t>(sh + off32);
+        };
+
+        for (uint32_t i = 0; i < shnum; i++) {
+            uint32_t type = static_cast<uint32_t>(shField(i, 4, 4, false));
+            if (type != kShtSymtab && type != kShtDynsym) continue;
+            uint64_t off     = shField(i, 24, 16, true);
+            uint64_t size    = shField(i, 32, 20, true);
+            uint32_t link    = static_cast<uint32_t>(shField(i, 40, 24, false));
+            uint64_t entsize = shField(i, 56, 36, true);
+            if (entsize < (is64 ? 24u : 16u) || !inFile(off, size) || link >= shnum) continue;
+            uint64_t strOff  = shField(link, 24, 16, true);
+            uint64_t strSize = shField(link, 32, 20, true);
+            if (!inFile(strOff, strSize)) continue;
+
+            uint64_t count = size / entsize;
+            m_syms.reserve(m_syms.size() + static_cast<int>(count));
+            for (uint64_t k = 0; k < count; k++) {
+                uint64_t e = off + k * entsize;
+                uint32_t name  = rd<uint32_t>(e);
+                uint8_t  info  = is64 ? rd<uint8_t>(e + 4)   : rd<uint8_t>(e + 12);
+                uint16_t shndx = is64 ? rd<uint16_t>(e + 6)  : rd<uint16_t>(e + 14);
+                uint64_t value = is64 ? rd<uint64_t>(e + 8)  : rd<uint32_t>(e + 4);
+                uint64_t ssize = is64 ? rd<uint64_t>(e + 16) : rd<uint32_t>(e + 8);
+                uint8_t  stt   = info & 0xF;
+                if (stt != kSttFunc && stt != kSttObject && stt != kSttIfunc) continue;
+                if (shndx == 0 || value == 0 || name == 0 || name >= strSize) continue;
+                const char* s = reinterpret_cast<const char*>(m_map + strOff + name);
+                if (!std::memchr(s, 0, strSize - name)) continue;
+                m_syms.append({value, ssize, strOff + name});
+            }
+        }
+
+        // .symtab and .dynsym overlap: keep one entry per address, the
+        // largest size first so the covering symbol wins
+        std::sort(m_syms.begin(), m_syms.end(), [](const Sym& a, const Sym& b) {
+            return a.value != b.value ? a.value < b.value : a.size > b.size;
+        });
+        m_syms.erase(std::unique(m_syms.begin(), m_syms.end(),
+            [](const Sym& a, const Sym& b) { return a.value == b.value; }), m_syms.end());
+        return true;
+    }
+};
+
+// C++ names come back demangled without their parameter list
+// ("Class::method"); anything else is returned as-is.
+inline QString demangleSymbol(const char* name) {
+#ifdef RCX_HAVE_CXXABI
+    if (name[0] == '_' && name[1] == 'Z') {
+        int status = -1;
+        char* out = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        if (out && status == 0) {
+            QString s = QString::fromUtf8(out);
+            std::free(out);
+            // Drop "(args)" and a trailing " const" by matching back from
+            // the last ')'
+            if (s.endsWith(QStringLiteral(" const"))) s.chop(6);
+            if (s.endsWith(QChar(')'))) {
+                int depth = 0;
+                for (int i = s.size() - 1; i >= 0; i--) {
+                    if (s[i] == QChar(')')) depth++;
+                    else if (s[i] == QChar('(') && --depth == 0) {
+                        if (i > 0) s.truncate(i);
+                        break;
+                    }
+                }
+            }
+            return s;
+        }
+        std::free(out);
+    }
+#endif
+    return QString::fromUtf8(name);
+}
+
+// ──────────────────────────────────────────────────────────────────────────
+// ModuleSymbolizer
+//
+// Address → "module!symbol+0xOFF" for a process's module list.  Modules are
+// kept sorted for binary search; each module's ELF symbols are loaded the
+// first time an address lands in it; finished strings are memoised in an
+// LRU keyed by address, so re-composing the same pointers costs one hash
+// lookup each.  Modules without a readable ELF image (PE, deleted files)
+// fall back to "module+0xOFF".
+//
+// The reverse direction, "module" or "module!symbol" → address, goes
+// through hash indexes: module names are indexed when the list is set,
+// a module's symbol names the first time one of them is asked for.
+// Thread-safe.
+// ──────────────────────────────────────────────────────────────────────────
+
+class ModuleSymbolizer {
+public:
+    struct Module {
+        QString  name;      // display name ("libc.so.6")
+        QString  path;      // image on disk; empty skips symbol loading
+        uint64_t base = 0;
+        uint64_t size = 0;
+
+        uint64_t end() const { return base + size; }
+    };
+
+    static constexpr int kDefaultCacheSize = 4096;
+
+    explicit ModuleSymbolizer(int cacheSize = kDefaultCacheSize)
+        : m_capacity(qMax(1, cacheSize)) {}
+
+    ModuleSymbolizer(const ModuleSymbolizer&) = delete;
+    ModuleSymbolizer& operator=(const ModuleSymbolizer&) = delete;
+
+    // Replace the module list.  Drops loaded symbols and memoised results.
+    void setModules(QVector<Module> modules) {
+        std::sort(modules.begin(), modules.end(),
+                  [](const Module& a, const Module& b) { return a.base < b.base; });
+        QMutexLocker lock(&m_lock);
+        m_modules = std::move(modules);
+        m_tables = QVector<std::shared_ptr<ElfSymbolTable>>(m_modules.size());
+        m_loaded = QVector<bool>(m_modules.size(), false);
+        m_symbolIndex = QVector<std::shared_ptr<SymbolIndex>>(m_modules.size());
+        m_byName.clear();
+        m_byName.reserve(m_modules.size());
+        for (int i = 0; i < m_modules.size(); i++) {
+            QString key = m_modules[i].name.toLower();
+            if (!m_byName.contains(key)) m_byName.insert(key, i);
+        }
+        m_cache.clear();
+        m_lru.clear();
+    }
+
+    QVector<Module> modules() const {
+        QMutexLocker lock(&m_lock);
+        return m_modules;
+    }
+
+    // Index of the module containing addr, or -1
+    int moduleAt(uint64_t addr) const {
+        QMutexLocker lock(&m_lock);
+        return moduleAtLocked(addr);
+    }
+
+    // Symbol table of module i (loaded on demand); null if it has none
+    std::shared_ptr<ElfSymbolTable> symbolsFor(int i) const {
+        QMutexLocker lock(&m_lock);
+        return tableLocked(i);
+    }
+
+    // "libfoo.so!Class::method+0x12", "libfoo.so!g_var", "libfoo.so+0x1a30",
+    // or empty if addr is outside every module.
+    QString symbolize(uint64_t addr) const {
+        QMutexLocker lock(&m_lock);
+        auto hit = m_cache.find(addr);
+        if (hit != m_cache.end()) {
+            m_lru.splice(m_lru.begin(), m_lru, hit->second);
+            return hit->first;
+        }
+
+        QString result;
+        int i = moduleAtLocked(addr);
+        if (i >= 0) {
+            const Module& mod = m_modules[i];
+            result = mod.name;
+            uint64_t off = addr - mod.base;
+            bool named = false;
+            if (auto table = tableLocked(i)) {
+                uint64_t vaddr = addr - mod.base + table->imageBase();
+                uint64_t symOff = 0;
+                if (const char* raw = table->lookup(vaddr, &symOff)) {
+                    result += QChar('!') + demangleSymbol(raw);
+                    off = symOff;
+                    named = true;
+                }
+            }
+            if (off || !named)
+                result += QStringLiteral("+0x") + QString::number(off, 16);
+        }
+
+        if (m_cache.size() >= m_capacity) {
+            m_cache.remove(m_lru.back());
+            m_lru.pop_back();
+        }
+        m_lru.push_front(addr);
+        m_cache.insert(addr, {result, m_lru.begin()});
+        return result;
+    }
+
+    // Base of "module", or the address of "module!symbol", or 0 if either
+    // is unknown.  Module names are case-insensitive; a symbol matches its
+    // raw or its demangled name ("Class::method").
+    uint64_t addressOf(const QString& name) const {
+        int bang = name.indexOf(QChar('!'));
+        QString key = (bang < 0 ? name : name.left(bang)).trimmed().toLower();
+        QMutexLocker lock(&m_lock);
+        auto mod = m_byName.find(key);
+        if (mod == m_byName.end()) return 0;
+        int i = mod.value();
+        if (bang < 0) return m_modules[i].base;
+
+        auto index = symbolIndexLocked(i);
+        if (!index) return 0;
+        auto sym = index->find(name.mid(bang + 1).trimmed());
+        return sym == index->end() ? 0 : m_modules[i].base + sym.value();
+    }
+
+private:
+    using Entry = std::pair<QString, std::list<uint64_t>::iterator>;
+    using SymbolIndex = QHash<QString, uint64_t>;   // name → module offset
+
+    mutable QMutex                   m_lock;
+    QVector<Module>                  m_modules;
+    mutable QVector<std::shared_ptr<ElfSymbolTable>> m_tables;
+    mutable QVector<bool>            m_loaded;
+    int                              m_capacity;
+    mutable QHash<uint64_t, Entry>   m_cache;
+    mutable std::list<uint64_t>      m_lru;       // most recent first
+    QHash<QString, int>              m_byName;    // lower-case name → module
+    mutable QVector<std::shared_ptr<SymbolIndex>> m_symbolIndex;
+
+    int moduleAtLocked(uint64_t addr) const {
+        auto it = std::upper_bound(m_modules.begin(), m_modules.end(), addr,
+            [](uint64_t a, const Module& m) { return a < m.base; });
+        if (it == m_modules.begin()) return -1;
+        --it;
+        return addr < it->end() ? static_cast<int>(it - m_modules.begin()) : -1;
+    }
+
+    std::shared_ptr<ElfSymbolTable> tableLocked(int i) const {
+        if (i < 0 || i >= m_modules.size()) return nullptr;
+        if (!m_loaded[i]) {
+            m_loaded[i] = true;
+            if (!m_modules[i].path.isEmpty()) {
+                auto table = std::make_shared<ElfSymbolTable>(m_modules[i].path);
+                if (table->isValid()) m_tables[i] = std::move(table);
+            }
+        }
+        return m_tables[i];
+    }
+
+    std::shared_ptr<SymbolIndex> symbolIndexLocked(int i) const {
+        if (!m_symbolIndex[i]) {
+            auto table = tableLocked(i);
+            if (!table) return nullptr;
+            auto index = std::make_shared<SymbolIndex>();
+            index->reserve(table->symbolCount());
+            uint64_t imageBase = table->imageBase();
+            // First definition of a name wins (lowest address)
+            table->forEachSymbol([&](const char* raw, uint64_t vaddr) {
+                uint64_t off = vaddr - imageBase;
+                QString plain = QString::fromUtf8(raw);
+                if (!index->contains(plain)) index->insert(plain, off);
+                QString pretty = demangleSymbol(raw);
+                if (pretty != plain && !index->contains(pretty)) index->insert(pretty, off);
+            });
+            m_symbolIndex[i] = std::move(index);
+        }
+        return m_symbolIndex[i];
+    }
+};
+
+} // namespace rcx
@@ -0,0 +1,249 @@
+#pragma once
+#include "provider.h"
+#include "elf_symbols.h"
+#include <QFile>
+#include <QFileInfo>
+#include <algorithm>
+
+namespace rcx {
+
+// Executable image opened from disk, laid out the way the loader would.
+//
+// ELF program headers (PT_LOAD) and PE section tables are parsed once and
+// turned into segments; reads go straight to a read-only mapping of the
+// file, so addresses are virtual addresses (ImageBase + RVA for PE,
+// p_vaddr for ELF) and bytes past a segment's file data -- .bss and other
+// uninitialised tails -- read as zero without anything being copied.
+// Pointers between globals in the image then resolve exactly as they do
+// in a running process.  Files that are neither are rejected (isImage()
+// false) and should be opened as flat files instead.
+class ImageProvider : public Provider {
+public:
+    enum class Format { None, Elf, Pe };
+
+    struct Segment {
+        uint64_t vaddr;
+        uint64_t memsz;
+        uint64_t filesz;   // <= memsz; bytes past this read as zero
+        uint64_t offset;   // file offset of vaddr
+        uint32_t prot;     // RegionProt bits
+        QString  name;     // PE section name, empty for ELF segments
+    };
+
+    explicit ImageProvider(const QString& path)
+        : m_file(path)
+        , m_name(QFileInfo(path).fileName())
+    {
+        if (!m_file.open(QIODevice::ReadOnly)) return;
+        qint64 sz = m_file.size();
+        if (sz < 64) return;
+        m_map = m_file.map(0, sz);
+        if (!m_map) return;
+        m_fileSize = static_cast<uint64_t>(sz);
+
+        if (std::memcmp(m_map, "\x7f" "ELF", 4) == 0 && parseElf())
+            m_format = Format::Elf;
+        else if (m_map[0] == 'M' && m_map[1] == 'Z' && parsePe())
+            m_format = Format::Pe;
+        if (m_format != Format::None)
+            finishLayout(path);
+
+        if (m_segments.isEmpty()) {
+            m_format = Format::None;
+            m_file.unmap(const_cast<uchar*>(m_map));
+            m_map = nullptr;
+        }
+    }
+
+    ~ImageProvider() override {
+        if (m_map) m_file.unmap(const_cast<uchar*>(m_map));
+    }
+
+    ImageProvider(const ImageProvider&) = delete;
+    ImageProvider& operator=(const ImageProvider&) = delete;
+
+    bool isImage() const { return m_format != Format::None; }
+    Format format() const { return m_format; }
+    const QVector<Segment>& segments() const { return m_segments; }
+
+    bool read(uint64_t addr, void* buf, int len) const override {
+        if (len <= 0) return false;
+        char* out = static_cast<char*>(buf);
+        uint64_t cur = addr;
+        uint64_t remaining = static_cast<uint64_t>(len);
+        while (remaining > 0) {
+            const Segment* s = segmentFor(cur);
+            if (!s) return false;
+            uint64_t off = cur - s->vaddr;
+            uint64_t chunk = qMin(remaining, s->memsz - off);
+            uint64_t fromFile = off < s->filesz ? qMin(chunk, s->filesz - off) : 0;
+            if (fromFile)
+                std::memcpy(out, m_map + s->offset + off, fromFile);
+            if (chunk > fromFile)
+                std::memset(out + fromFile, 0, chunk - fromFile);
+            out += chunk;
+            cur += chunk;
+            remaining -= chunk;
+        }
+        return true;
+    }
+
+    int size() const override {
+        return static_cast<int>(qMin<uint64_t>(size64(), INT_MAX));
+    }
+    uint64_t size64() const override {
+        return m_segments.isEmpty() ? 0 : m_segments.last().vaddr + m_segments.last().memsz;
+    }
+
+    bool isReadable(uint64_t addr, int len) const override {
+        if (len <= 0) return (len == 0);
+        return regionsCover(m_regions, addr, static_cast<uint64_t>(len));
+    }
+
+    QVector<MemoryRegion> regions() const override { return m_regions; }
+    QString name() const override { return m_name; }
+    QString kind() const override { return QStringLiteral("File"); }
+    uint64_t base() const override { return m_base; }
+
+    QString getSymbol(uint64_t addr) const override { return m_symbols.symbolize(addr); }
+    uint64_t symbolToAddress(const QString& name) const override {
+        return m_symbols.addressOf(name);
+    }
+
+private:
+    QFile                 m_file;
+    const uchar*          m_map = nullptr;
+    uint64_t              m_fileSize = 0;
+    Format                m_format = Format::None;
+    uint64_t              m_base = 0;
+    QString               m_name;
+    QVector<Segment>      m_segments;     // sorted by vaddr, non-overlapping
+    QVector<MemoryRegion> m_regions;
+    ModuleSymbolizer      m_symbols;
+
+    static constexpr uint8_t  kElfClass32 = 1;
+    static constexpr uint8_t  kElfClass64 = 2;
+    static constexpr uint8_t  kElfDataLsb = 1;
+    static constexpr uint16_t kEtExec     = 2;
+    static constexpr uint16_t kEtDyn      = 3;
+    static constexpr uint32_t kPtLoad     = 1;
+    static constexpr uint16_t kPeMagic32  = 0x10b;
+    static constexpr uint16_t kPeMagic64  = 0x20b;
+    static constexpr uint32_t kScnExecute = 0x20000000;
+    static constexpr uint32_t kScnWrite   = 0x80000000;
+
+    template<typename T>
+    T rd(uint64_t off) const { T v; std::memcpy(&v, m_map + off, sizeof(T)); return v; }
+
+    bool inFile(uint64_t off, uint64_t len) const {
+        return off <= m_fileSize && len <= m_fileSize - off;
+    }
+
+    // File bytes past EOF become part of the zero-filled tail
+    void addSegment(uint64_t vaddr, uint64_t memsz, uint64_t offset, uint64_t filesz,
+                    uint32_t prot, const QString& name = {}) {
+        if (memsz == 0) return;
+        if (offset > m_fileSize) filesz = 0;
+        filesz = qMin(qMin(filesz, memsz), m_fileSize - qMin(offset, m_fileSize));
+        m_segments.append({vaddr, memsz, filesz, offset, prot, name});
+    }
+
+    bool parseElf() {
+        bool is64 = m_map[4] == kElfClass64;
+        if ((!is64 && m_map[4] != kElfClass32) || m_map[5] != kElfDataLsb) return false;
+        // Executables and shared objects only: a core's PT_LOADs describe a
+        // dumped process, which the CoreDump source lays out instead
+        uint16_t type = rd<uint16_t>(16);
+        if (type != kEtExec && type != kEtDyn) return false;
+        uint64_t phoff     = is64 ? rd<uint64_t>(32) : rd<uint32_t>(28);
+        uint32_t phentsize = rd<uint16_t>(is64 ? 54 : 42);
+        uint32_t phnum     = rd<uint16_t>(is64 ? 56 : 44);
+        if (phentsize < (is64 ? 56u : 32u) || !inFile(phoff, uint64_t(phnum) * phentsize))
+            return false;
+
+        for (uint32_t i = 0; i < phnum; i++) {
+            uint64_t ph = phoff + uint64_t(i) * phentsize;
+            if (rd<uint32_t>(ph) != kPtLoad) continue;
+            uint32_t flags  = is64 ? rd<uint32_t>(ph + 4)  : rd<uint32_t>(ph + 24);
+            uint64_t offset = is64 ? rd<uint64_t>(ph + 8)  : rd<uint32_t>(ph + 4);
+            uint64_t vaddr  = is64 ? rd<uint64_t>(ph + 16) : rd<uint32_t>(ph + 8);
+            uint64_t filesz = is64 ? rd<uint64_t>(ph + 32) : rd<uint32_t>(ph + 16);
+            uint64_t memsz  = is64 ? rd<uint64_t>(ph + 40) : rd<uint32_t>(ph + 20);
+            // PF_X = 1, PF_W = 2.  Everything loaded is readable here, even
+            // execute-only text.
+            uint32_t prot = RP_Read | ((flags & 2) ? RP_Write : 0) | ((flags & 1) ? RP_Exec : 0);
+            addSegment(vaddr, memsz, offset, filesz, prot);
+        }
+        return true;
+    }
+
+    bool parsePe() {
+        uint32_t pe = rd<uint32_t>(0x3C);
+        if (!inFile(pe, 24) || std::memcmp(m_map + pe, "PE\0\0", 4) != 0) return false;
+        uint32_t numSections = rd<uint16_t>(pe + 6);
+        uint32_t optSize     = rd<uint16_t>(pe + 20);
+        uint64_t opt = pe + 24;
+        if (optSize < 64 || !inFile(opt, optSize)) return false;
+        uint16_t magic = rd<uint16_t>(opt);
+        if (magic != kPeMagic32 && magic != kPeMagic64) return false;
+        uint64_t imageBase = magic == kPeMagic64 ? rd<uint64_t>(opt + 24) : rd<uint32_t>(opt + 28);
+        uint32_t sizeOfHeaders = rd<uint32_t>(opt + 60);
+
+        uint64_t sections = opt + optSize;
+        if (!inFile(sections, uint64_t(numSections) * 40)) return false;
+
+        addSegment(imageBase, sizeOfHeaders, 0, sizeOfHeaders, RP_Read,
+                   QStringLiteral("headers"));
+        for (uint32_t i = 0; i < numSections; i++) {
+            uint64_t sh = sections + uint64_t(i) * 40;
+            const char* rawName = reinterpret_cast<const char*>(m_map + sh);
+            QString name = QString::fromLatin1(rawName, int(qstrnlen(rawName, 8)));
+            uint32_t virtualSize = rd<uint32_t>(sh + 8);
+            uint32_t rva         = rd<uint32_t>(sh + 12);
+            uint32_t rawSize     = rd<uint32_t>(sh + 16);
+            uint32_t rawPtr      = rd<uint32_t>(sh + 20);
+            uint32_t chars       = rd<uint32_t>(sh + 36);
+            uint32_t prot = RP_Read | ((chars & kScnWrite) ? RP_Write : 0)
+                          | ((chars & kScnExecute) ? RP_Exec : 0);
+            addSegment(imageBase + rva, virtualSize ? virtualSize : rawSize,
+                       rawPtr, rawSize, prot, name);
+        }
+        return true;
+    }
+
+    // Sort, clip overlaps (a later segment wins its own range), then build
+    // the region map and the one-module symbolizer.
+    void finishLayout(const QString& path) {
+        std::stable_sort(m_segments.begin(), m_segments.end(),
+            [](const Segment& a, const Segment& b) { return a.vaddr < b.vaddr; });
+        for (int i = 0; i + 1 < m_segments.size(); i++) {
+            Segment& s = m_segments[i];
+            uint64_t next = m_segments[i + 1].vaddr;
+            if (s.vaddr + s.memsz > next) {
+                s.memsz = next - s.vaddr;
+                s.filesz = qMin(s.filesz, s.memsz);
+            }
+        }
+        m_segments.erase(std::remove_if(m_segments.begin(), m_segments.end(),
+            [](const Segment& s) { return s.memsz == 0; }), m_segments.end());
+        if (m_segments.isEmpty()) return;
+
+        m_regions.reserve(m_segments.size());
+        for (const Segment& s : m_segments)
+            m_regions.append({s.vaddr, s.memsz, s.prot, s.name.isEmpty() ? m_name : s.name});
+
+        m_base = m_segments.first().vaddr & ~uint64_t(0xFFF);
+        m_symbols.setModules({{m_name, m_format == Format::Elf ? path : QString(),
+                               m_base, size64() - m_base}});
+    }
+
+    const Segment* segmentFor(uint64_t addr) const {
+        auto it = std::upper_bound(m_segments.cbegin(), m_segments.cend(), addr,
+            [](uint64_t a, const Segment& s) { return a < s.vaddr; });
+        if (it == m_segments.cbegin()) return nullptr;
+        --it;
+        return (addr - it->vaddr < it->memsz) ? &*it : nullptr;
+    }
+};
+
+} // namespace rcx
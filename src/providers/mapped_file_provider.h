@@ -0,0 +1,112 @@
+#pragma once
+#include "provider.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+
+namespace rcx {
+
+// Memory-mapped file source.
+//
+// The file is mapped copy-on-write (QFile::map with MapPrivateOption), so
+// opening is O(1) regardless of file size and pages are faulted in by the OS
+// on first touch.  write() patches the private mapping only; the file on disk
+// is untouched until savePatches() copies the dirty ranges back.
+class MappedFileProvider : public Provider {
+    QFile    m_file;
+    uchar*   m_map  = nullptr;
+    uint64_t m_size = 0;
+    QString  m_name;
+    QMap<uint64_t, uint64_t> m_patches;   // dirty range start → end (exclusive)
+
+public:
+    explicit MappedFileProvider(const QString& path)
+        : m_file(path)
+        , m_name(QFileInfo(path).fileName())
+    {
+        if (!m_file.open(QIODevice::ReadOnly)) return;
+        qint64 sz = m_file.size();
+        if (sz <= 0) return;
+        m_map = m_file.map(0, sz, QFileDevice::MapPrivateOption);
+        if (m_map) m_size = static_cast<uint64_t>(sz);
+    }
+
+    ~MappedFileProvider() override {
+        if (m_map) m_file.unmap(m_map);
+    }
+
+    MappedFileProvider(const MappedFileProvider&) = delete;
+    MappedFileProvider& operator=(const MappedFileProvider&) = delete;
+
+    // False if the file could not be opened or mapped (empty, pipe, device)
+    bool isMapped() const { return m_map != nullptr; }
+
+    int size() const override {
+        return static_cast<int>(qMin<uint64_t>(m_size, INT_MAX));
+    }
+    uint64_t size64() const override { return m_size; }
+
+    bool read(uint64_t addr, void* buf, int len) const override {
+        if (!m_map || !isReadable(addr, len)) return false;
+        std::memcpy(buf, m_map + addr, len);
+        return true;
+    }
+
+    bool isWritable() const override { return m_map != nullptr; }
+
+    bool write(uint64_t addr, const void* buf, int len) override {
+        if (!m_map || len <= 0 || !isReadable(addr, len)) return false;
+        std::memcpy(m_map + addr, buf, len);
+        addPatch(addr, addr + static_cast<uint64_t>(len));
+        return true;
+    }
+
+    QString name() const override { return m_name; }
+    QString kind() const override { return QStringLiteral("File"); }
+
+    QString filePath() const { return m_file.fileName(); }
+    bool hasPatches() const { return !m_patches.isEmpty(); }
+    const QMap<uint64_t, uint64_t>& patches() const { return m_patches; }
+
+    // Write every patched range back to the file on disk.
+    bool savePatches(QString* errorMsg = nullptr) {
+        if (m_patches.isEmpty()) return true;
+        QFile out(m_file.fileName());
+        if (!out.open(QIODevice::ReadWrite)) {
+            if (errorMsg) *errorMsg = out.errorString();
+            return false;
+        }
+        for (auto it = m_patches.constBegin(); it != m_patches.constEnd(); ++it) {
+            qint64 len = static_cast<qint64>(it.value() - it.key());
+            if (!out.seek(static_cast<qint64>(it.key()))
+                || out.write(reinterpret_cast<const char*>(m_map + it.key()), len) != len) {
+                if (errorMsg) *errorMsg = out.errorString();
+                return false;
+            }
+        }
+        m_patches.clear();
+        return true;
+    }
+
+private:
+    // Insert [start, end) and merge with any overlapping or adjacent ranges
+    void addPatch(uint64_t start, uint64_t end) {
+        auto it = m_patches.upperBound(start);
+        if (it != m_patches.begin()) {
+            auto prev = it;
+            --prev;
+            if (prev.value() >= start) {
+                start = prev.key();
+                end = qMax(end, prev.value());
+                it = m_patches.erase(prev);
+            }
+        }
+        while (it != m_patches.end() && it.key() <= end) {
+            end = qMax(end, it.value());
+            it = m_patches.erase(it);
+        }
+        m_patches.insert(start, end);
+    }
+};
+
+} // namespace rcx
@@ -0,0 +1,308 @@
+#pragma once
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define RCX_DIFF_SSE2 1
+#  if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    include <immintrin.h>
+#    define RCX_DIFF_AVX2 1     // compiled per function, picked at run time
+#  endif
+#endif
+
+namespace rcx {
+
+namespace pagediff {
+
+// Sets bit i of bits[i / 64] where a[i] != b[i], for len a multiple of 64.
+// Returns true if any byte differs.
+inline bool diffScalar(const uint8_t* a, const uint8_t* b, int len, uint64_t* bits) {
+    uint64_t any = 0;
+    for (int w = 0; w < len / 64; w++) {
+        uint64_t mask = 0;
+        const uint8_t* pa = a + w * 64;
+        const uint8_t* pb = b + w * 64;
+        for (int i = 0; i < 64; i += 8) {
+            uint64_t x, y;
+            std::memcpy(&x, pa + i, 8);
+            std::memcpy(&y, pb + i, 8);
+            if (x == y) continue;
+            for (int k = 0; k < 8; k++)
+                if (pa[i + k] != pb[i + k]) mask |= uint64_t(1) << (i + k);
+        }
+        bits[w] = mask;
+        any |= mask;
+    }
+    return any != 0;
+}
+
+#ifdef RCX_DIFF_SSE2
+inline bool diffSse2(const uint8_t* a, const uint8_t* b, int len, uint64_t* bits) {
+    uint64_t any = 0;
+    for (int w = 0; w < len / 64; w++) {
+        uint64_t eq = 0;
+        for (int k = 0; k < 4; k++) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + w * 64 + k * 16));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + w * 64 + k * 16));
+            eq |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)))) << (k * 16);
+        }
+        bits[w] = ~eq;
+        any |= ~eq;
+    }
+    return any != 0;
+}
+#endif
+
+#ifdef RCX_DIFF_AVX2
+__attribute__((target("avx2")))
+inline bool diffAvx2(const uint8_t* a, const uint8_t* b, int len, uint64_t* bits) {
+    uint64_t any = 0;
+    for (int w = 0; w < len / 64; w++) {
+        const uint8_t* pa = a + w * 64;
+        const uint8_t* pb = b + w * 64;
+        __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pa));
+        __m256i y0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pb));
+        __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pa + 32));
+        __m256i y1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pb + 32));
+        uint64_t eq = uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x0, y0))))
+                    | uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x1, y1)))) << 32;
+        bits[w] = ~eq;
+        any |= ~eq;
+    }
+    return any != 0;
+}
+#endif
+
+using DiffFn = bool (*)(const uint8_t*, const uint8_t*, int, uint64_t*);
+
+// Widest comparator this CPU runs
+inline DiffFn bestDiff() {
+#if defined(RCX_DIFF_AVX2)
+    static const DiffFn fn = __builtin_cpu_supports("avx2") ? diffAvx2 : diffSse2;
+    return fn;
+#elif defined(RCX_DIFF_SSE2)
+    return diffSse2;
+#else
+    return diffScalar;
+#endif
+}
+
+// 64-bit hash of a page, for skipping unchanged pages without reading the
+// previous copy.  Not cryptographic; a collision only hides a highlight.
+inline uint64_t hashBytes(const uint8_t* p, int len) {
+    uint64_t h1 = 0x9E3779B97F4A7C15ULL ^ uint64_t(len);
+    uint64_t h2 = 0xC2B2AE3D27D4EB4FULL;
+    int i = 0;
+    for (; i + 16 <= len; i += 16) {
+        uint64_t x, y;
+        std::memcpy(&x, p + i, 8);
+        std::memcpy(&y, p + i + 8, 8);
+        h1 = (h1 ^ x) * 0xFF51AFD7ED558CCDULL;
+        h2 = (h2 ^ y) * 0xC4CEB9FE1A85EC53ULL;
+        h1 = (h1 << 31) | (h1 >> 33);
+        h2 = (h2 << 29) | (h2 >> 35);
+    }
+    for (; i < len; i++)
+        h1 = (h1 ^ p[i]) * 0x100000001B3ULL;
+    uint64_t h = h1 ^ (h2 * 0x9E3779B97F4A7C15ULL);
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return h;
+}
+
+} // namespace pagediff
+
+// Byte-level changes between two page snapshots, one bitmap per page that
+// changed (bit i = byte i of the page).  Pages compared but found clean
+// cost a hash entry and no bitmap, so a page that churns thousands of
+// bytes still costs 512 bytes.  Addresses are absolute.
+class PageChanges {
+public:
+    static constexpr int kPageSize = 4096;
+    static constexpr int kWords    = kPageSize / 64;
+    using Bitmap = std::array<uint64_t, kWords>;
+
+    void clear() { m_pages.clear(); m_bitmaps.clear(); }
+
+    // No page changed (also true before any diff)
+    bool isEmpty() const { return m_bitmaps.isEmpty(); }
+    int  changedPageCount() const { return m_bitmaps.size(); }
+
+    // Every page of [addr, addr+len) was part of the diff, so a clean
+    // answer from anyChanged() means the bytes really are unchanged.
+    bool covers(uint64_t addr, uint64_t len) const {
+        for (uint64_t p = pageOf(addr); len && p <= pageOf(addr + len - 1); p += kPageSize)
+            if (!m_pages.contains(p)) return false;
+        return true;
+    }
+
+    bool anyChanged(uint64_t addr, uint64_t len) const {
+        bool hit = false;
+        forEachWord(addr, len, [&](uint64_t, uint64_t bits) { hit = hit || bits; });
+        return hit;
+    }
+
+    // Appends i for every changed byte addr+i, i < len
+    void changedIndices(uint64_t addr, int len, QVector<int>& out) const {
+        if (len <= 0) return;
+        forEachWord(addr, uint64_t(len), [&](uint64_t wordAddr, uint64_t bits) {
+            while (bits) {
+                int bit = ctz(bits);
+                bits &= bits - 1;
+                out.append(int(wordAddr + bit - addr));
+            }
+        });
+    }
+
+    int changedByteCount() const {
+        int n = 0;
+        for (const Bitmap& b : m_bitmaps)
+            for (uint64_t w : b) n += popcount(w);
+        return n;
+    }
+
+private:
+    friend class PageDiffer;
+
+    QHash<uint64_t, int> m_pages;     // compared page → bitmap index, -1 if clean
+    QVector<Bitmap>      m_bitmaps;
+
+    static uint64_t pageOf(uint64_t a) { return a & ~uint64_t(kPageSize - 1); }
+
+    static int ctz(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(v);
+#else
+        int n = 0;
+        while (!(v & 1)) { v >>= 1; n++; }
+        return n;
+#endif
+    }
+    static int popcount(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(v);
+#else
+        int n = 0;
+        for (; v; v &= v - 1) n++;
+        return n;
+#endif
+    }
+
+    // fn(address of bit 0, change bits) for each 64-byte word overlapping
+    // [addr, addr+len), bits outside the range masked off
+    template<typename Fn>
+    void forEachWord(uint64_t addr, uint64_t len, Fn fn) const {
+        if (len == 0 || m_bitmaps.isEmpty()) return;
+        uint64_t end = addr + len;
+        for (uint64_t p = pageOf(addr); p < end; p += kPageSize) {
+            auto it = m_pages.constFind(p);
+            if (it == m_pages.constEnd() || it.value() < 0) continue;
+            const Bitmap& bm = m_bitmaps[it.value()];
+            uint64_t lo = qMax(addr, p) - p;
+            uint64_t hi = qMin<uint64_t>(end - p, kPageSize);
+            for (uint64_t w = lo / 64; w * 64 < hi; w++) {
+                uint64_t bits = bm[w];
+                uint64_t first = w * 64;
+                if (lo > first) bits &= ~uint64_t(0) << (lo - first);
+                if (hi < first + 64) bits &= ~uint64_t(0) >> (first + 64 - hi);
+                if (bits) fn(p + first, bits);
+            }
+        }
+    }
+};
+
+// Diffs successive page snapshots into PageChanges.
+//
+// Per page: pages that share storage (carried over by dirty-page tracking)
+// are skipped outright; otherwise the new page is hashed and compared with
+// the hash remembered for the old copy, and only pages whose hashes differ
+// are compared byte-wise with SSE2/AVX2.  Hashes are remembered per page
+// so the next diff, whose old pages are this diff's new ones, reads each
+// unchanged page once.
+class PageDiffer {
+public:
+    using PageMap = QHash<uint64_t, QByteArray>;
+
+    // Fills out with the changes from oldPages to newPages.  Pages missing
+    // from either side are not compared.  Returns true if the snapshots are
+    // identical: same pages, no byte changed.
+    bool diff(const PageMap& oldPages, const PageMap& newPages, PageChanges& out) {
+        out.clear();
+        out.m_pages.reserve(newPages.size());
+        QHash<uint64_t, Hashed> hashes;
+        hashes.reserve(newPages.size());
+        bool identical = oldPages.size() == newPages.size();
+        pagediff::DiffFn cmp = pagediff::bestDiff();
+
+        for (auto it = newPages.constBegin(); it != newPages.constEnd(); ++it) {
+            uint64_t pageAddr = it.key();
+            const QByteArray& newPage = it.value();
+            auto oldIt = oldPages.constFind(pageAddr);
+            if (oldIt == oldPages.constEnd()) {
+                identical = false;   // new page, no previous data to diff against
+                continue;
+            }
+            const QByteArray& oldPage = oldIt.value();
+            auto cached = m_hashes.constFind(pageAddr);
+            bool haveOld = cached != m_hashes.constEnd()
+                        && cached->data == oldPage.constData() && cached->size == oldPage.size();
+
+            if (oldPage.constData() == newPage.constData() && oldPage.size() == newPage.size()) {
+                if (haveOld) hashes.insert(pageAddr, cached.value());
+                out.m_pages.insert(pageAddr, -1);
+                continue;
+            }
+
+            const auto* a = reinterpret_cast<const uint8_t*>(oldPage.constData());
+            const auto* b = reinterpret_cast<const uint8_t*>(newPage.constData());
+            int len = qMin(qMin(oldPage.size(), newPage.size()), int(PageChanges::kPageSize));
+            if (oldPage.size() != newPage.size()) identical = false;
+
+            uint64_t newHash = pagediff::hashBytes(b, newPage.size());
+            hashes.insert(pageAddr, {newPage.constData(), newPage.size(), newHash});
+            uint64_t oldHash = haveOld ? cached->hash : pagediff::hashBytes(a, oldPage.size());
+            if (oldHash == newHash && oldPage.size() == newPage.size()) {
+                out.m_pages.insert(pageAddr, -1);
+                continue;
+            }
+
+            PageChanges::Bitmap bm{};
+            int whole = len & ~63;
+            bool changed = whole > 0 && cmp(a, b, whole, bm.data());
+            for (int i = whole; i < len; i++) {
+                if (a[i] != b[i]) {
+                    bm[i / 64] |= uint64_t(1) << (i % 64);
+                    changed = true;
+                }
+            }
+            if (changed) {
+                out.m_pages.insert(pageAddr, out.m_bitmaps.size());
+                out.m_bitmaps.append(bm);
+                identical = false;
+            } else {
+                out.m_pages.insert(pageAddr, -1);
+            }
+        }
+        m_hashes = std::move(hashes);
+        return identical;
+    }
+
+    // Forget remembered hashes (e.g. the old snapshot was replaced)
+    void reset() { m_hashes.clear(); }
+
+private:
+    struct Hashed {
+        const char* data;     // identity of the page copy the hash belongs to
+        int         size;
+        uint64_t    hash;
+    };
+    QHash<uint64_t, Hashed> m_hashes;
+};
+
+} // namespace rcx
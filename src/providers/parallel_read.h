@@ -0,0 +1,75 @@
+#pragma once
+#include "provider.h"
+#include <QSemaphore>
+
+namespace rcx {
+
+// Threads that refresh chunks run on.  Separate from providerReadPool() so
+// chunk fetches never queue behind a stalled readAsync, and bounded so a
+// tab full of slow sources cannot spawn a thread per page.  The threads
+// mostly wait on I/O, so the bound does not follow the core count.
+inline QThreadPool* pageFetchPool() {
+    static QThreadPool* pool = [] {
+        auto* p = new QThreadPool;
+        p->setMaxThreadCount(8);
+        return p;
+    }();
+    return pool;
+}
+
+// Provider::readBatch split across up to prov.maxConcurrentReads() threads.
+//
+// Requests are cut into contiguous chunks of at least minChunk; the first
+// runs on the calling thread and the rest on pageFetchPool().  A chunk the
+// pool has no free thread for also runs on the caller, so this never waits
+// on work that is not already running.  Returns once every chunk is done:
+// each request's buffer and ok flag are written by exactly one chunk, so
+// the caller sees the whole set at once.  Chunks that start after token is
+// cancelled are skipped (zero-filled, ok = false).
+inline void readBatchParallel(const Provider& prov, ReadRequest* reqs, int count,
+                              const CancelToken& token = {}, int minChunk = 16) {
+    if (count <= 0) return;
+    int chunks = qMin(prov.maxConcurrentReads(), pageFetchPool()->maxThreadCount() + 1);
+    chunks = qMin(chunks, (count + qMax(1, minChunk) - 1) / qMax(1, minChunk));
+    if (chunks <= 1) {
+        prov.readBatch(reqs, count);
+        return;
+    }
+
+    auto runChunk = [&prov, token](ReadRequest* r, int n) {
+        if (token.isCancelled()) {
+            for (int i = 0; i < n; i++) {
+                r[i].ok = false;
+                if (r[i].len > 0) std::memset(r[i].buf, 0, r[i].len);
+            }
+            return;
+        }
+        prov.readBatch(r, n);
+    };
+
+    // Shared so a worker still inside release() never outlives it
+    auto done = std::make_shared<QSemaphore>();
+    int started = 0;
+    int per = count / chunks, extra = count % chunks;
+    int first = per + (extra > 0 ? 1 : 0);
+    int at = first;
+    for (int c = 1; c < chunks; c++) {
+        int n = per + (c < extra ? 1 : 0);
+        ReadRequest* r = reqs + at;
+        at += n;
+        auto* job = new detail::FunctionRunnable([&runChunk, done, r, n]() {
+            runChunk(r, n);
+            done->release();
+        });
+        if (pageFetchPool()->tryStart(job)) {
+            started++;
+        } else {
+            delete job;
+            runChunk(r, n);
+        }
+    }
+    runChunk(reqs, first);
+    done->acquire(started);
+}
+
+} // namespace rcx
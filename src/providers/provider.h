@@ -1,11 +1,129 @@
 #pragma once
 #include <QByteArray>
+#include <QRunnable>
 #include <QString>
+#include <QThreadPool>
+#include <QVector>
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
+#include <functional>
+#include <memory>
 
 namespace rcx {
 
+// One range of a vectored read (see Provider::readBatch).
+struct ReadRequest {
+    uint64_t addr = 0;
+    void*    buf  = nullptr;
+    int      len  = 0;
+    bool     ok   = false;   // out: true if the whole range was read
+};
+
+// One range of an asynchronous read (see Provider::readAsync).  Unlike
+// ReadRequest it owns its buffer, so it can cross threads.
+struct AsyncRead {
+    uint64_t   addr = 0;
+    int        len  = 0;
+    QByteArray data;          // out: len bytes, zero-filled if the read failed
+    bool       ok   = false;  // out: true if the whole range was read
+};
+
+// Cancellation for asynchronous reads.  A token watches a Generation and is
+// cancelled once the generation moves past the value it was issued at.
+// A default-constructed token is never cancelled.
+class CancelToken {
+public:
+    CancelToken() = default;
+    CancelToken(std::shared_ptr<const std::atomic<uint64_t>> gen, uint64_t issued)
+        : m_gen(std::move(gen)), m_issued(issued) {}
+
+    bool isCancelled() const {
+        return m_gen && m_gen->load(std::memory_order_acquire) != m_issued;
+    }
+
+private:
+    std::shared_ptr<const std::atomic<uint64_t>> m_gen;
+    uint64_t m_issued = 0;
+};
+
+// Counter that issues CancelTokens.  Bumping it cancels every token handed
+// out before.  Reads like a plain uint64_t so it can stand in for one.
+class Generation {
+public:
+    Generation() : m_value(std::make_shared<std::atomic<uint64_t>>(0)) {}
+    Generation(const Generation&) = delete;
+    Generation& operator=(const Generation&) = delete;
+
+    Generation& operator++() { m_value->fetch_add(1, std::memory_order_acq_rel); return *this; }
+    uint64_t operator++(int) { return m_value->fetch_add(1, std::memory_order_acq_rel); }
+    operator uint64_t() const { return m_value->load(std::memory_order_acquire); }
+
+    CancelToken token() const { return CancelToken(m_value, *this); }
+
+private:
+    std::shared_ptr<std::atomic<uint64_t>> m_value;
+};
+
+using AsyncReadDone = std::function<void(QVector<AsyncRead> reads, bool cancelled)>;
+
+// Threads for Provider::readAsync's default path.  Kept apart from the
+// global pool so a stalled source cannot starve the refresh worker.
+inline QThreadPool* providerReadPool() {
+    static QThreadPool* pool = [] {
+        auto* p = new QThreadPool;
+        p->setMaxThreadCount(4);
+        return p;
+    }();
+    return pool;
+}
+
+namespace detail {
+class FunctionRunnable : public QRunnable {
+    std::function<void()> m_fn;
+public:
+    explicit FunctionRunnable(std::function<void()> fn) : m_fn(std::move(fn)) {}
+    void run() override { m_fn(); }
+};
+} // namespace detail
+
+// Protection bits for MemoryRegion::prot
+enum RegionProt : uint32_t {
+    RP_None  = 0,
+    RP_Read  = 1 << 0,
+    RP_Write = 1 << 1,
+    RP_Exec  = 1 << 2,
+};
+
+// One mapped range of the target address space (see Provider::regions).
+struct MemoryRegion {
+    uint64_t base = 0;
+    uint64_t size = 0;
+    uint32_t prot = RP_None;   // RegionProt bitmask
+    QString  name;             // backing file or pseudo-name ("[heap]"), may be empty
+
+    uint64_t end() const { return base + size; }
+};
+
+// True if [addr, addr+len) lies in readable regions with no gaps.
+// regs must be sorted by base and non-overlapping.
+inline bool regionsCover(const QVector<MemoryRegion>& regs, uint64_t addr, uint64_t len) {
+    if (len == 0) return true;
+    auto it = std::upper_bound(regs.begin(), regs.end(), addr,
+        [](uint64_t a, const MemoryRegion& r) { return a < r.base; });
+    if (it == regs.begin()) return false;
+    --it;
+    uint64_t cur = addr;
+    uint64_t end = (addr + len < addr) ? UINT64_MAX : addr + len;
+    for (; it != regs.end(); ++it) {
+        if (it->base > cur || !(it->prot & RP_Read)) return false;
+        if (it->end() >= end) return true;
+        cur = it->end();
+    }
+    return false;
+}
+
 class Provider {
 public:
     virtual ~Provider() = default;
@@ -14,6 +132,13 @@ public:
     virtual bool read(uint64_t addr, void* buf, int len) const = 0;
     virtual int  size() const = 0;
 
+    // Full 64-bit extent.  size() is an int, so sources larger than 2 GB
+    // clamp size() to INT_MAX and report their real extent here.
+    virtual uint64_t size64() const {
+        int s = size();
+        return s > 0 ? static_cast<uint64_t>(s) : 0;
+    }
+
     // --- Optional overrides ---
     virtual bool write(uint64_t addr, const void* buf, int len) {
         Q_UNUSED(addr); Q_UNUSED(buf); Q_UNUSED(len);
@@ -21,6 +146,64 @@ public:
     }
     virtual bool isWritable() const { return false; }
 
+    // Read many ranges in one call.  Sets ok per request; failed ranges are
+    // zero-filled (same contract as readBytes).  The default loops over read().
+    // Providers with a vectored transport override this so a refresh costs
+    // one round trip instead of one per page.
+    virtual void readBatch(ReadRequest* reqs, int count) const {
+        for (int i = 0; i < count; i++) {
+            ReadRequest& r = reqs[i];
+            r.ok = r.len > 0 && read(r.addr, r.buf, r.len);
+            if (!r.ok && r.len > 0)
+                std::memset(r.buf, 0, r.len);
+        }
+    }
+
+    // Asynchronous form of readBatch.  done runs exactly once, on a worker
+    // thread, with the filled ranges; cancelled is set (and the ranges left
+    // empty) if token was cancelled before the read started.  The default
+    // runs readBatch on providerReadPool().  The provider must outlive the
+    // call -- UI code should go through readAsyncOn() (async_read.h), which
+    // holds a reference and delivers on the caller's thread.
+    virtual void readAsync(QVector<AsyncRead> reads, CancelToken token, AsyncReadDone done) const {
+        const Provider* self = this;
+        providerReadPool()->start(new detail::FunctionRunnable(
+            [self, reads = std::move(reads), token, done = std::move(done)]() mutable {
+                if (token.isCancelled()) {
+                    done(std::move(reads), true);
+                    return;
+                }
+                QVector<ReadRequest> reqs(reads.size());
+                for (int i = 0; i < reads.size(); i++) {
+                    reads[i].data = QByteArray(qMax(0, reads[i].len), Qt::Uninitialized);
+                    reqs[i].addr = reads[i].addr;
+                    reqs[i].buf  = reads[i].data.data();
+                    reqs[i].len  = reads[i].len;
+                }
+                self->readBatch(reqs.data(), reqs.size());
+                for (int i = 0; i < reads.size(); i++)
+                    reads[i].ok = reqs[i].ok;
+                done(std::move(reads), false);
+            }));
+    }
+
+    // How many readBatch calls the source can usefully serve at once.  The
+    // refresh splits large page sets into that many chunks and fetches them
+    // on parallel threads (see readBatchParallel), which hides per-call
+    // latency on remote and network-backed sources.  Only raise it if
+    // readBatch is safe to call concurrently; the default keeps every read
+    // on one thread.
+    virtual int maxConcurrentReads() const { return 1; }
+
+    // Write tracking for live sources.  For each page-aligned address in
+    // pages[], sets dirty[i] if the page may have been written since the
+    // previous call, then re-arms tracking for the next call.  Returns false
+    // if the source cannot track writes; callers must then re-read every page.
+    virtual bool dirtyPages(const uint64_t* pages, int count, bool* dirty) const {
+        Q_UNUSED(pages); Q_UNUSED(count); Q_UNUSED(dirty);
+        return false;
+    }
+
     // Human-readable label for this source.
     // Examples: "notepad.exe", "dump.bin", "tcp://10.0.0.1:1337"
     virtual QString name() const { return {}; }
@@ -38,6 +221,11 @@ public:
     // For file/buffer providers this is always 0.
     virtual uint64_t base() const { return 0; }
 
+    // Mapped ranges of the address space, sorted by base and non-overlapping.
+    // Empty means the provider has no region map (flat files, buffers), in
+    // which case callers fall back to isReadable().
+    virtual QVector<MemoryRegion> regions() const { return {}; }
+
     // Resolve an absolute address to a symbol name.
     // Returns empty string if no symbol is known.
     // Example: "ntdll.dll+0x1A30"
@@ -61,7 +249,8 @@ public:
     virtual bool isReadable(uint64_t addr, int len) const {
         if (len <= 0) return (len == 0);
         uint64_t ulen = (uint64_t)len;
-        return addr <= (uint64_t)size() && ulen <= (uint64_t)size() - addr;
+        uint64_t total = size64();
+        return addr <= total && ulen <= total - addr;
     }
 
     template<typename T>
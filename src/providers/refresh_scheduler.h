@@ -0,0 +1,129 @@
+#pragma once
+#include <QHash>
+#include <QVector>
+#include <QtGlobal>
+#include <cstdint>
+
+namespace rcx {
+
+// Per-page poll rates for the live refresh.
+//
+// Every page starts at the fast interval.  A read that finds the page
+// unchanged doubles its interval, up to the slow ceiling; a read that finds
+// it changed drops it straight back to the fast interval.  Value heat from
+// the fields on a page (ValueHistory::heatLevel, 0-3) lowers the ceiling:
+// each level halves it, so a field known to be hot is never backed off far
+// even through a quiet stretch.  The refresh timer sleeps msUntilDue() and
+// each tick reads only the pages due() returns; the rest are carried over
+// from the previous snapshot.
+//
+// With fast == slow every page is due every tick, which is the old
+// fixed-interval behaviour.
+class RefreshScheduler {
+public:
+    static constexpr uint64_t kPageSize = 4096;
+    static constexpr int kMaxHeat = 3;
+
+    void setIntervals(int fastMs, int slowMs) {
+        m_slowMs = qMax(1, slowMs);
+        m_fastMs = qBound(1, fastMs, m_slowMs);
+    }
+    int fastMs() const { return m_fastMs; }
+    int slowMs() const { return m_slowMs; }
+
+    // The pages of `pages` that are due at nowMs, in the same order.  Pages
+    // never read are always due.  State for pages no longer in the plan is
+    // dropped, so a pointer that moves away does not leave stale entries.
+    QVector<uint64_t> due(const QVector<uint64_t>& pages, qint64 nowMs) {
+        QVector<uint64_t> out;
+        out.reserve(pages.size());
+        QHash<uint64_t, PageState> kept;
+        kept.reserve(pages.size());
+        // Timer ticks jitter; a page due within half a fast tick goes now
+        // rather than waiting a whole extra tick.
+        qint64 slack = m_fastMs / 2;
+        for (uint64_t p : pages) {
+            auto it = m_pages.constFind(p);
+            if (it == m_pages.constEnd() || m_fastMs >= m_slowMs) {
+                out.append(p);
+                if (it != m_pages.constEnd()) kept.insert(p, *it);
+                continue;
+            }
+            // A page that heated up since its last read comes down to its
+            // new ceiling here and regrows from there once it cools
+            PageState st = *it;
+            st.intervalMs = qMin(st.intervalMs, ceilingFor(p));
+            if (nowMs - st.lastMs + slack >= st.intervalMs)
+                out.append(p);
+            kept.insert(p, st);
+        }
+        m_pages = std::move(kept);
+        return out;
+    }
+
+    // Milliseconds from nowMs until the first of `pages` is due by the rule
+    // due() applies; 0 if one is due already, slowMs() if `pages` is empty
+    int msUntilDue(const QVector<uint64_t>& pages, qint64 nowMs) const {
+        qint64 slack = m_fastMs / 2;
+        qint64 wait = m_slowMs;
+        for (uint64_t p : pages) {
+            auto it = m_pages.constFind(p);
+            if (it == m_pages.constEnd()) return 0;
+            qint64 interval = qMin(it->intervalMs, ceilingFor(p));
+            wait = qMin(wait, it->lastMs + interval - slack - nowMs);
+            if (wait <= 0) return 0;
+        }
+        return int(wait);
+    }
+
+    // A read of `page` finished at nowMs
+    void observe(uint64_t page, bool changed, qint64 nowMs) {
+        auto it = m_pages.find(page);
+        if (it == m_pages.end()) {
+            m_pages.insert(page, {m_fastMs, nowMs});
+            return;
+        }
+        it->intervalMs = changed ? m_fastMs : qMin(it->intervalMs * 2, ceilingFor(page));
+        it->lastMs = nowMs;
+    }
+
+    // Heat is re-collected on every compose: beginHeat(), then noteHeat()
+    // for each tracked field.  A page takes the hottest field on it.
+    void beginHeat() { m_heat.clear(); }
+    void noteHeat(uint64_t addr, uint64_t len, int level) {
+        if (len == 0 || level <= 0) return;
+        level = qMin(level, kMaxHeat);
+        for (uint64_t p = addr & ~(kPageSize - 1); p <= ((addr + len - 1) & ~(kPageSize - 1));
+             p += kPageSize) {
+            int& h = m_heat[p];
+            if (level > h) h = level;
+        }
+    }
+
+    // Current poll interval of a page; 0 if it has not been read yet
+    int intervalOf(uint64_t page) const {
+        auto it = m_pages.constFind(page);
+        return it == m_pages.constEnd() ? 0 : qMin(it->intervalMs, ceilingFor(page));
+    }
+    int trackedPages() const { return m_pages.size(); }
+
+    void reset() { m_pages.clear(); m_heat.clear(); }
+
+private:
+    struct PageState {
+        int    intervalMs;
+        qint64 lastMs;     // when the page was last read
+    };
+
+    QHash<uint64_t, PageState> m_pages;
+    QHash<uint64_t, int>       m_heat;
+    int m_fastMs = 16;
+    int m_slowMs = 660;
+
+    int ceilingFor(uint64_t page) const {
+        int h = m_heat.value(page, 0);
+        return qMax(m_fastMs, m_slowMs >> h);
+    }
+};
+
+} // namespace rcx
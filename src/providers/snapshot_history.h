@@ -0,0 +1,239 @@
+#pragma once
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+
+namespace rcx {
+
+// Bounded in-memory history of refresh snapshots, for time-travel scrubbing.
+//
+// Frames are grouped behind a keyframe that holds every page in full.  The
+// other frames of a group store only the pages that differ from the
+// keyframe, each encoded as byte runs against the keyframe page.  A counter
+// that ticks every refresh costs a few bytes per frame instead of a page.
+//
+// Deltas are taken against the keyframe, not the previous frame, so any
+// frame decodes in one step and the oldest frame can be dropped on its own.
+// A new keyframe starts once a group's deltas outgrow half its keyframe.
+// When memoryUsage() exceeds the budget, frames are dropped oldest first;
+// a keyframe is freed with the last frame that refers to it.
+class SnapshotHistory {
+public:
+    using PageMap = QHash<uint64_t, QByteArray>;
+
+    static constexpr qint64 kDefaultBudget  = 256LL * 1024 * 1024;
+    static constexpr int    kMaxGroupFrames = 1024;
+
+    explicit SnapshotHistory(qint64 budgetBytes = kDefaultBudget)
+        : m_budget(budgetBytes) {}
+
+    // Record a snapshot.  Returns how many old frames were dropped to stay
+    // within budget (callers holding frame indices shift them down by that).
+    int push(const PageMap& pages, qint64 timestampMs) {
+        if (m_groups.empty() || needsKeyframe())
+            startGroup(pages, timestampMs);
+        else
+            appendDelta(pages, timestampMs);
+        m_count++;
+        return evict();
+    }
+
+    int    count() const   { return m_count; }
+    bool   isEmpty() const { return m_count == 0; }
+    int    keyframeCount() const { return (int)m_groups.size(); }
+    qint64 memoryUsage() const { return m_bytes; }
+
+    qint64 budget() const { return m_budget; }
+    int setBudget(qint64 bytes) { m_budget = bytes; return evict(); }
+
+    void clear() {
+        m_groups.clear();
+        m_count = 0;
+        m_bytes = 0;
+    }
+
+    // Frame 0 is the oldest retained snapshot, count()-1 the newest.
+    qint64 timestamp(int frame) const {
+        const Frame* f = locate(frame, nullptr);
+        return f ? f->timestamp : 0;
+    }
+
+    // Rebuild the full page set of a frame.  Unchanged pages share storage
+    // with the keyframe.
+    PageMap pagesAt(int frame) const {
+        const Group* g = nullptr;
+        const Frame* f = locate(frame, &g);
+        if (!f) return {};
+        PageMap out = g->key;
+        for (uint64_t addr : f->removed)
+            out.remove(addr);
+        for (auto it = f->changed.constBegin(); it != f->changed.constEnd(); ++it) {
+            if (it->raw)
+                out.insert(it.key(), it->data);
+            else
+                out.insert(it.key(), applyRuns(g->key.value(it.key()), it->data));
+        }
+        return out;
+    }
+
+private:
+    struct PageDelta {
+        QByteArray data;    // full page if raw, otherwise encoded runs
+        bool       raw = false;
+    };
+    struct Frame {
+        qint64                      timestamp = 0;
+        QHash<uint64_t, PageDelta>  changed;   // pages differing from the keyframe
+        QVector<uint64_t>           removed;   // keyframe pages absent from this frame
+        qint64                      bytes = 0;
+    };
+    struct Group {
+        PageMap            key;
+        qint64             keyBytes = 0;
+        qint64             deltaBytes = 0;
+        std::deque<Frame>  frames;    // frames[0] is the keyframe itself while retained
+    };
+
+    // Per-entry bookkeeping (hash node, QByteArray header) so budgets stay
+    // honest for frames with many tiny deltas.
+    static constexpr qint64 kEntryOverhead = 48;
+    // Runs closer than this are merged; a run header costs 4 bytes.
+    static constexpr int kRunMergeGap = 8;
+
+    std::deque<Group> m_groups;
+    qint64 m_budget = kDefaultBudget;
+    qint64 m_bytes  = 0;
+    int    m_count  = 0;
+
+    bool needsKeyframe() const {
+        const Group& g = m_groups.back();
+        return g.deltaBytes > g.keyBytes / 2
+            || (int)g.frames.size() >= kMaxGroupFrames;
+    }
+
+    void startGroup(const PageMap& pages, qint64 ts) {
+        Group g;
+        g.key = pages;
+        for (auto it = pages.constBegin(); it != pages.constEnd(); ++it)
+            g.keyBytes += it->size() + kEntryOverhead;
+        Frame f;
+        f.timestamp = ts;
+        g.frames.push_back(std::move(f));
+        m_bytes += g.keyBytes;
+        m_groups.push_back(std::move(g));
+    }
+
+    void appendDelta(const PageMap& pages, qint64 ts) {
+        Group& g = m_groups.back();
+        Frame f;
+        f.timestamp = ts;
+        for (auto it = pages.constBegin(); it != pages.constEnd(); ++it) {
+            auto kit = g.key.constFind(it.key());
+            PageDelta d;
+            if (kit == g.key.constEnd() || kit->size() != it->size()) {
+                d.data = *it;
+                d.raw = true;
+            } else {
+                // Pages carried over between refreshes share storage
+                if (kit->constData() == it->constData()
+                    || std::memcmp(kit->constData(), it->constData(), it->size()) == 0)
+                    continue;
+                d.data = encodeRuns(*kit, *it);
+                if (d.data.size() >= it->size()) {
+                    d.data = *it;
+                    d.raw = true;
+                }
+            }
+            f.bytes += d.data.size() + kEntryOverhead;
+            f.changed.insert(it.key(), std::move(d));
+        }
+        for (auto kit = g.key.constBegin(); kit != g.key.constEnd(); ++kit) {
+            if (!pages.contains(kit.key()))
+                f.removed.append(kit.key());
+        }
+        f.bytes += kEntryOverhead + f.removed.size() * (qint64)sizeof(uint64_t);
+        g.deltaBytes += f.bytes;
+        m_bytes += f.bytes;
+        g.frames.push_back(std::move(f));
+    }
+
+    // Drop oldest frames until within budget, always keeping the newest.
+    int evict() {
+        int dropped = 0;
+        while (m_bytes > m_budget && m_count > 1) {
+            Group& g = m_groups.front();
+            Frame& f = g.frames.front();
+            m_bytes -= f.bytes;
+            g.deltaBytes -= f.bytes;
+            g.frames.pop_front();
+            m_count--;
+            dropped++;
+            if (g.frames.empty()) {
+                m_bytes -= g.keyBytes;
+                m_groups.pop_front();
+            }
+        }
+        return dropped;
+    }
+
+    const Frame* locate(int frame, const Group** group) const {
+        if (frame < 0 || frame >= m_count) return nullptr;
+        for (const Group& g : m_groups) {
+            if (frame < (int)g.frames.size()) {
+                if (group) *group = &g;
+                return &g.frames[frame];
+            }
+            frame -= (int)g.frames.size();
+        }
+        return nullptr;
+    }
+
+    // Encoding: repeated [u16 offset][u16 length][length bytes of cur].
+    static QByteArray encodeRuns(const QByteArray& base, const QByteArray& cur) {
+        QByteArray out;
+        const char* b = base.constData();
+        const char* c = cur.constData();
+        const int n = cur.size();
+        if (n > 0xFFFF) return cur;   // caller stores it raw
+        int i = 0;
+        while (i < n) {
+            while (i < n && b[i] == c[i]) i++;
+            if (i >= n) break;
+            int start = i;
+            int end = i;      // one past the last differing byte
+            while (i < n) {
+                if (b[i] != c[i]) { end = ++i; continue; }
+                int gap = 0;
+                while (i + gap < n && b[i + gap] == c[i + gap] && gap < kRunMergeGap) gap++;
+                if (i + gap >= n || gap >= kRunMergeGap) break;
+                i += gap;
+            }
+            i = end;
+            uint16_t hdr[2] = { (uint16_t)start, (uint16_t)(end - start) };
+            out.append(reinterpret_cast<const char*>(hdr), sizeof(hdr));
+            out.append(c + start, end - start);
+        }
+        return out;
+    }
+
+    static QByteArray applyRuns(const QByteArray& base, const QByteArray& runs) {
+        QByteArray out = base;
+        char* o = out.data();
+        const char* p = runs.constData();
+        const char* end = p + runs.size();
+        while (end - p >= 4) {
+            uint16_t hdr[2];
+            std::memcpy(hdr, p, sizeof(hdr));
+            p += sizeof(hdr);
+            if (end - p < hdr[1] || hdr[0] + hdr[1] > out.size()) break;
+            std::memcpy(o + hdr[0], p, hdr[1]);
+            p += hdr[1];
+        }
+        return out;
+    }
+};
+
+} // namespace rcx
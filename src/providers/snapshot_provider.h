@@ -16,6 +16,7 @@ class SnapshotProvider : public Provider {
     std::shared_ptr<Provider> m_real;
     QHash<uint64_t, QByteArray> m_pages;   // page-aligned addr → 4096-byte page
     int m_mainExtent = 0;                  // logical size of the main struct range
+    bool m_frozen = false;                 // historical view: writes are refused
 
     static constexpr uint64_t kPageSize = 4096;
     static constexpr uint64_t kPageMask = ~(kPageSize - 1);
@@ -60,10 +61,13 @@ public:
     }
 
     int size() const override { return m_mainExtent; }
-    bool isWritable() const override { return m_real ? m_real->isWritable() : false; }
+    bool isWritable() const override { return !m_frozen && m_real && m_real->isWritable(); }
     bool isLive() const override { return m_real ? m_real->isLive() : false; }
     QString name() const override { return m_real ? m_real->name() : QString(); }
     QString kind() const override { return m_real ? m_real->kind() : QStringLiteral("File"); }
+    QVector<MemoryRegion> regions() const override {
+        return m_real ? m_real->regions() : QVector<MemoryRegion>();
+    }
     QString getSymbol(uint64_t addr) const override {
         return m_real ? m_real->getSymbol(addr) : QString();
     }
@@ -72,12 +76,17 @@ public:
     }
 
     bool write(uint64_t addr, const void* buf, int len) override {
-        if (!m_real) return false;
+        if (!m_real || m_frozen) return false;
         bool ok = m_real->write(addr, buf, len);
         if (ok) patchPages(addr, buf, len);
         return ok;
     }
 
+    // Pin the page table as a view of the past (see SnapshotHistory).
+    // Writes would land in the live target, not in what is displayed.
+    void freeze() { m_frozen = true; }
+    bool isFrozen() const { return m_frozen; }
+
     // Replace the entire page table (called after async read completes)
     void updatePages(PageMap pages, int mainExtent) {
         m_pages = std::move(pages);
@@ -0,0 +1,251 @@
+#pragma once
+#include "provider.h"
+#include <cerrno>
+#include <mutex>
+
+#if defined(__linux__) && !defined(RCX_NO_IO_URING) && defined(__has_include)
+#  if __has_include(<linux/io_uring.h>)
+#    define RCX_HAVE_IO_URING 1
+#  endif
+#endif
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+#ifdef RCX_HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <vector>
+#endif
+
+namespace rcx {
+
+// Batched positional reads from one file descriptor (a file, or
+// /proc/<pid>/mem with addresses as offsets) through io_uring.
+//
+// readBatch() queues every request as an IORING_OP_READ, submits them with
+// a single io_uring_enter per ring-full and reaps completions as they
+// arrive, so a refresh of N pages costs a handful of syscalls instead of N
+// blocking preads.  The ring is set up lazily on first use.  Builds without
+// <linux/io_uring.h> (or with RCX_NO_IO_URING), and kernels that refuse
+// io_uring_setup, report isAvailable() false and callers keep their pread
+// path.  Safe to call from several threads; calls are serialized.
+class UringReader {
+public:
+    explicit UringReader(unsigned entries = 256) : m_entries(entries) {}
+    ~UringReader() { teardown(); }
+
+    UringReader(const UringReader&) = delete;
+    UringReader& operator=(const UringReader&) = delete;
+
+    // False if the ring cannot be used (sets it up on first call)
+    bool isAvailable() {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return ensureRing();
+    }
+
+    // Same contract as Provider::readBatch, reading reqs[i].len bytes at
+    // file offset reqs[i].addr.  Returns false without touching reqs if the
+    // ring is unavailable.
+    bool readBatch(int fd, ReadRequest* reqs, int count) {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (!ensureRing()) return false;
+#ifdef RCX_HAVE_IO_URING
+        submitAndReap(fd, reqs, count);
+        return true;
+#else
+        Q_UNUSED(fd); Q_UNUSED(reqs); Q_UNUSED(count);
+        return false;
+#endif
+    }
+
+    // io_uring_enter calls made so far (for tests and diagnostics)
+    uint64_t enterCalls() const { return m_enterCalls; }
+
+private:
+    unsigned   m_entries;
+    std::mutex m_lock;
+    bool       m_tried = false;
+    bool       m_broken = false;
+    int        m_ringFd = -1;
+    uint64_t   m_enterCalls = 0;
+
+#ifdef RCX_HAVE_IO_URING
+    void*     m_sqRing = nullptr;
+    size_t    m_sqRingSize = 0;
+    void*     m_cqRing = nullptr;
+    size_t    m_cqRingSize = 0;
+    io_uring_sqe* m_sqes = nullptr;
+    size_t    m_sqesSize = 0;
+
+    unsigned* m_sqHead = nullptr;
+    unsigned* m_sqTail = nullptr;
+    unsigned  m_sqMask = 0;
+    unsigned* m_sqArray = nullptr;
+    unsigned  m_sqEntries = 0;
+    unsigned* m_cqHead = nullptr;
+    unsigned* m_cqTail = nullptr;
+    unsigned  m_cqMask = 0;
+    io_uring_cqe* m_cqes = nullptr;
+
+    static unsigned loadAcquire(const unsigned* p) {
+        return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+    }
+    static void storeRelease(unsigned* p, unsigned v) {
+        __atomic_store_n(p, v, __ATOMIC_RELEASE);
+    }
+
+    bool ensureRing() {
+        if (m_tried) return m_ringFd >= 0 && !m_broken;
+        m_tried = true;
+
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+        int fd = static_cast<int>(::syscall(__NR_io_uring_setup, m_entries, &p));
+        if (fd < 0) return false;   // ENOSYS, or disabled by sysctl/seccomp
+        m_ringFd = fd;
+
+        m_sqRingSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        m_cqRingSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single)
+            m_sqRingSize = m_cqRingSize = qMax(m_sqRingSize, m_cqRingSize);
+
+        m_sqRing = ::mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (m_sqRing == MAP_FAILED) { m_sqRing = nullptr; teardown(); return false; }
+        if (single) {
+            m_cqRing = m_sqRing;
+        } else {
+            m_cqRing = ::mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            if (m_cqRing == MAP_FAILED) { m_cqRing = nullptr; teardown(); return false; }
+        }
+        m_sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) { teardown(); return false; }
+        m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<char*>(m_sqRing);
+        auto* cq = static_cast<char*>(m_cqRing);
+        m_sqHead    = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+        m_sqTail    = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        m_sqMask    = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        m_sqArray   = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        m_sqEntries = p.sq_entries;
+        m_cqHead    = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        m_cqTail    = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        m_cqMask    = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        m_cqes      = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        return true;
+    }
+
+    void teardown() {
+        if (m_sqes) ::munmap(m_sqes, m_sqesSize);
+        if (m_cqRing && m_cqRing != m_sqRing) ::munmap(m_cqRing, m_cqRingSize);
+        if (m_sqRing) ::munmap(m_sqRing, m_sqRingSize);
+        m_sqes = nullptr;
+        m_sqRing = m_cqRing = nullptr;
+        if (m_ringFd >= 0) ::close(m_ringFd);
+        m_ringFd = -1;
+    }
+
+    static void preadOne(int fd, ReadRequest& r) {
+        ssize_t n = ::pread(fd, r.buf, static_cast<size_t>(r.len), static_cast<off_t>(r.addr));
+        r.ok = n == static_cast<ssize_t>(r.len);
+        if (!r.ok) std::memset(r.buf, 0, r.len);
+    }
+
+    // One round per ring-full: queue, then submit and wait in the same
+    // io_uring_enter.  Rounds are short (sq_entries reads), so a round never
+    // waits on more than the ring holds.
+    void submitAndReap(int fd, ReadRequest* reqs, int count) {
+        std::vector<int> round;
+        round.reserve(m_sqEntries);
+        int next = 0;
+        while (next < count) {
+            round.clear();
+            unsigned tail = *m_sqTail;
+            while (next < count && round.size() < m_sqEntries) {
+                ReadRequest& r = reqs[next];
+                if (r.len <= 0) {
+                    r.ok = false;
+                    next++;
+                    continue;
+                }
+                unsigned slot = tail & m_sqMask;
+                io_uring_sqe* sqe = &m_sqes[slot];
+                std::memset(sqe, 0, sizeof(*sqe));
+                sqe->opcode    = IORING_OP_READ;
+                sqe->fd        = fd;
+                sqe->off       = r.addr;
+                sqe->addr      = reinterpret_cast<uint64_t>(r.buf);
+                sqe->len       = static_cast<uint32_t>(r.len);
+                sqe->user_data = static_cast<uint64_t>(next);
+                m_sqArray[slot] = slot;
+                tail++;
+                round.push_back(next++);
+            }
+            if (round.empty()) break;
+            storeRelease(m_sqTail, tail);
+
+            unsigned toSubmit = static_cast<unsigned>(round.size());
+            int pending = static_cast<int>(round.size());
+            while (pending > 0) {
+                int ret = static_cast<int>(::syscall(__NR_io_uring_enter, m_ringFd, toSubmit,
+                                                     unsigned(pending), IORING_ENTER_GETEVENTS,
+                                                     nullptr, 0));
+                m_enterCalls++;
+                if (ret >= 0) {
+                    toSubmit -= qMin(toSubmit, unsigned(ret));
+                } else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                    abandonRing(fd, reqs, round, toSubmit, pending);
+                    break;
+                }
+                reap(fd, reqs, pending);
+            }
+        }
+    }
+
+    // io_uring_enter failed outright.  Reads the kernel never took are
+    // pulled back off the queue and served by pread; reads it did take
+    // still complete into the caller's buffers, so wait them out by polling
+    // the completion ring.  The ring is not used again.
+    void abandonRing(int fd, ReadRequest* reqs, const std::vector<int>& round,
+                     unsigned unsubmitted, int& pending) {
+        storeRelease(m_sqTail, *m_sqTail - unsubmitted);
+        for (size_t i = round.size() - unsubmitted; i < round.size(); i++)
+            preadOne(fd, reqs[round[i]]);
+        pending -= static_cast<int>(unsubmitted);
+        while (pending > 0) {
+            reap(fd, reqs, pending);
+            if (pending > 0) ::usleep(50);
+        }
+        m_broken = true;
+    }
+
+    void reap(int fd, ReadRequest* reqs, int& pending) {
+        unsigned head = *m_cqHead;
+        unsigned tail = loadAcquire(m_cqTail);
+        for (; head != tail; head++) {
+            const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+            ReadRequest& r = reqs[cqe.user_data];
+            if (cqe.res == -EINVAL || cqe.res == -EOPNOTSUPP) {
+                preadOne(fd, r);            // kernel predates IORING_OP_READ
+            } else {
+                r.ok = cqe.res == r.len;
+                if (!r.ok) std::memset(r.buf, 0, r.len);
+            }
+            pending--;
+        }
+        storeRelease(m_cqHead, head);
+    }
+#else
+    bool ensureRing() { return false; }
+    void teardown() {}
+#endif
+};
+
+} // namespace rcx
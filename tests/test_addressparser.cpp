@@ -76,6 +76,32 @@ private slots:
         QVERIFY(r.error.contains("not found"));
     }
 
+    void moduleSymbol() {
+        AddressParserCallbacks cbs;
+        QString asked;
+        cbs.resolveModule = [&](const QString& name, bool* ok) -> uint64_t {
+            asked = name;
+            *ok = (name == "libgame.so!g_World");
+            return *ok ? 0x7f0000401000ULL : 0;
+        };
+        auto r = AddressParser::evaluate("<libgame.so>!g_World + 0x10", 8, &cbs);
+        QVERIFY(r.ok);
+        QCOMPARE(r.value, 0x7f0000401010ULL);
+        QCOMPARE(asked, QStringLiteral("libgame.so!g_World"));
+
+        // Qualified names run up to the next operator
+        r = AddressParser::evaluate("[<libgame.so>!Game::instance]-8", 8, &cbs);
+        QVERIFY(!r.ok);
+        QCOMPARE(asked, QStringLiteral("libgame.so!Game::instance"));
+        QVERIFY(r.error.contains("symbol"));
+    }
+
+    void moduleSymbolMissingName() {
+        auto r = AddressParser::evaluate("<libgame.so>! + 0x10");
+        QVERIFY(!r.ok);
+        QVERIFY(r.error.contains("symbol name"));
+    }
+
     // -- Dereference --
 
     void derefSimple() {
@@ -175,6 +201,7 @@ private slots:
     void validateValid() {
         QCOMPARE(AddressParser::validate("0x100 + 0x200"), QString());
         QCOMPARE(AddressParser::validate("<Prog.exe> + [0x100]"), QString());
+        QCOMPARE(AddressParser::validate("<libgame.so>!g_World + 0x10"), QString());
     }
     void validateInvalid() {
         QVERIFY(!AddressParser::validate("").isEmpty());
@@ -1984,6 +1984,236 @@ private slots:
         }
     }
 
+
+    void testIncrementalComposeReusesUnchangedFields() {
+        NodeTree tree;
+        tree.baseAddress = 0;
+
+        Node root;
+        root.kind = NodeKind::Struct;
+        root.name = "Root";
+        root.parentId = 0;
+        int ri = tree.addNode(root);
+        uint64_t rootId = tree.nodes[ri].id;
+
+        for (int i = 0; i < 4; i++) {
+            Node f;
+            f.kind = NodeKind::UInt32;
+            f.name = QString("f%1").arg(i);
+            f.parentId = rootId;
+            f.offset = i * 4;
+            tree.addNode(f);
+        }
+        Node arr;
+        arr.kind = NodeKind::Array;
+        arr.name = "arr";
+        arr.parentId = rootId;
+        arr.offset = 16;
+        arr.elementKind = NodeKind::UInt16;
+        arr.arrayLen = 4;
+        tree.addNode(arr);
+
+        QByteArray data(64, '\0');
+        ComposeCache cache;
+        ComposeResult first;
+        {
+            BufferProvider prov(data);
+            first = compose(tree, prov, 0, cache);
+            ComposeResult full = compose(tree, prov);
+            QCOMPARE(first.text, full.text);
+            QVERIFY(!first.linesStable);  // nothing to compare against yet
+        }
+        // 4 fields + 4 array elements
+        QCOMPARE(cache.blocks.size(), 8);
+
+        // Two bytes change: one field and one array element are re-rendered,
+        // the output still matches a full compose
+        data[8] = 7;
+        data[20] = 9;
+        BufferProvider prov(data);
+        ComposeResult second = compose(tree, prov, 0, cache);
+        QCOMPARE(second.text, compose(tree, prov).text);
+        QVERIFY(second.linesStable);
+        QCOMPARE(second.changedLines.size(), 2);
+        int fieldLine = second.changedLines[0].first;
+        QCOMPARE(second.changedLines[0].second, fieldLine);
+        QCOMPARE(second.meta[fieldLine].offsetAddr, uint64_t(8));
+        int elemLine = second.changedLines[1].first;
+        QCOMPARE(second.meta[elemLine].offsetAddr, uint64_t(20));
+        QVERIFY(second.meta[elemLine].isArrayElement);
+
+        // Nothing changed: no lines to redraw
+        ComposeResult third = compose(tree, prov, 0, cache);
+        QVERIFY(third.linesStable);
+        QVERIFY(third.changedLines.isEmpty());
+        QCOMPARE(third.text, second.text);
+
+        // A collapsed array drops its element lines and blocks
+        int ai = tree.indexOfId(tree.nodes.last().id);
+        tree.nodes[ai].collapsed = true;
+        cache.clear();
+        ComposeResult folded = compose(tree, prov, 0, cache);
+        QCOMPARE(folded.text, compose(tree, prov).text);
+        QCOMPARE(cache.blocks.size(), 4);
+    }
+
+    void testCancelledComposeKeepsCache() {
+        NodeTree tree;
+        tree.baseAddress = 0;
+
+        Node root;
+        root.kind = NodeKind::Struct;
+        root.name = "Root";
+        root.parentId = 0;
+        int ri = tree.addNode(root);
+        uint64_t rootId = tree.nodes[ri].id;
+
+        for (int i = 0; i < 4; i++) {
+            Node f;
+            f.kind = NodeKind::UInt32;
+            f.name = QString("f%1").arg(i);
+            f.parentId = rootId;
+            f.offset = i * 4;
+            tree.addNode(f);
+        }
+
+        QByteArray data(16, '\0');
+        ComposeCache cache;
+        {
+            BufferProvider prov(data);
+            compose(tree, prov, 0, cache);
+        }
+        QCOMPARE(cache.blocks.size(), 4);
+        const QVector<uint> hashes = cache.lineHashes;
+
+        // A newer generation arrived: nothing is returned and the cache
+        // still describes the last finished compose
+        data[4] = 1;
+        BufferProvider prov(data);
+        Generation gen;
+        CancelToken token = gen.token();
+        ++gen;
+        ComposeResult cancelled = compose(tree, prov, 0, cache, {}, token);
+        QVERIFY(cancelled.text.isEmpty());
+        QVERIFY(cancelled.meta.isEmpty());
+        QCOMPARE(cache.lineHashes, hashes);
+        QCOMPARE(cache.blocks.size(), 4);
+
+        // The next compose diffs against that one as usual
+        ComposeResult next = compose(tree, prov, 0, cache, {}, gen.token());
+        QCOMPARE(next.text, compose(tree, prov).text);
+        QVERIFY(next.linesStable);
+        QCOMPARE(next.changedLines.size(), 1);
+    }
+
+    void testLongArrayRendersWindow() {
+        NodeTree tree;
+        tree.baseAddress = 0;
+
+        Node root;
+        root.kind = NodeKind::Struct;
+        root.name = "Root";
+        root.parentId = 0;
+        int ri = tree.addNode(root);
+        uint64_t rootId = tree.nodes[ri].id;
+
+        Node arr;
+        arr.kind = NodeKind::Array;
+        arr.name = "samples";
+        arr.parentId = rootId;
+        arr.offset = 0;
+        arr.elementKind = NodeKind::Float;
+        arr.arrayLen = 200000;
+        int ai = tree.addNode(arr);
+        uint64_t arrId = tree.nodes[ai].id;
+
+        NullProvider prov;
+        auto countKind = [](const ComposeResult& r, auto pred) {
+            int n = 0;
+            for (const auto& lm : r.meta) if (pred(lm)) n++;
+            return n;
+        };
+        auto isElem = [](const LineMeta& lm) { return lm.isArrayElement; };
+        auto isElided = [](const LineMeta& lm) { return lm.arrayElided > 0; };
+
+        // Default window starts at viewIndex 0: elements, then one
+        // placeholder for the rest
+        ComposeResult r = compose(tree, prov);
+        QCOMPARE(countKind(r, isElem), kArrayWindow);
+        QCOMPARE(countKind(r, isElided), 1);
+        const LineMeta* tail = nullptr;
+        for (const auto& lm : r.meta) if (lm.arrayElided > 0) tail = &lm;
+        QCOMPARE(tail->arrayElementIdx, kArrayWindow);
+        QCOMPARE(tail->arrayElided, 200000 - kArrayWindow);
+        QCOMPARE(tail->offsetAddr, uint64_t(kArrayWindow) * 4);
+        QCOMPARE(tail->lineKind, LineKind::ArrayElementSeparator);
+
+        // A slid window shows placeholders on both sides
+        ArrayWindows windows;
+        windows[arrId] = 1000;
+        r = compose(tree, prov, 0, windows);
+        QCOMPARE(countKind(r, isElem), kArrayWindow);
+        QCOMPARE(countKind(r, isElided), 2);
+        int firstElem = -1;
+        for (int i = 0; i < r.meta.size(); i++) {
+            if (r.meta[i].isArrayElement) { firstElem = i; break; }
+        }
+        QCOMPARE(r.meta[firstElem - 1].arrayElided, 1000);
+        QCOMPARE(r.meta[firstElem].arrayElementIdx, 1000);
+        QCOMPARE(r.meta[firstElem].offsetAddr, uint64_t(4000));
+
+        // Windows past the end are clamped to the last elements
+        windows[arrId] = 500000;
+        r = compose(tree, prov, 0, windows);
+        QCOMPARE(countKind(r, isElided), 1);
+        QCOMPARE(r.meta[firstElem].arrayElementIdx, 200000 - kArrayWindow);
+
+        // Short arrays are not windowed
+        tree.nodes[ai].arrayLen = kArrayWindow;
+        r = compose(tree, prov, 0, windows);
+        QCOMPARE(countKind(r, isElem), kArrayWindow);
+        QCOMPARE(countKind(r, isElided), 0);
+    }
+
+    void testArrayPlaceholderJumpSpan() {
+        NodeTree tree;
+        tree.baseAddress = 0;
+
+        Node root;
+        root.kind = NodeKind::Struct;
+        root.name = "Root";
+        root.parentId = 0;
+        int ri = tree.addNode(root);
+        uint64_t rootId = tree.nodes[ri].id;
+
+        Node arr;
+        arr.kind = NodeKind::Array;
+        arr.name = "samples";
+        arr.parentId = rootId;
+        arr.offset = 0;
+        arr.elementKind = NodeKind::Float;
+        arr.arrayLen = 200000;
+        tree.addNode(arr);
+
+        NullProvider prov;
+        ComposeResult r = compose(tree, prov);
+        QStringList lines = r.text.split('\n');
+        int tail = -1;
+        for (int i = 0; i < r.meta.size(); i++)
+            if (r.meta[i].arrayElided > 0) tail = i;
+        QVERIFY(tail >= 0);
+
+        // The placeholder's range is the editable index
+        ColumnSpan s = arrayElidedSpanFor(r.meta[tail], lines[tail]);
+        QVERIFY(s.valid);
+        QCOMPARE(lines[tail].mid(s.start, s.end - s.start),
+                 QStringLiteral("%1..199999").arg(kArrayWindow));
+
+        // Element lines carry no jump span
+        int elem = tail - 1;
+        QVERIFY(r.meta[elem].isArrayElement);
+        QVERIFY(!arrayElidedSpanFor(r.meta[elem], lines[elem]).valid);
+    }
 };
 
 QTEST_MAIN(TestCompose)
@@ -1,5 +1,6 @@
 #include <QtTest/QTest>
 #include "core.h"
+#include "pointer_chase.h"
 
 class TestCore : public QObject {
     Q_OBJECT
@@ -507,6 +508,84 @@ private slots:
         // Container span = array offset (8) + array size (80) = 88
         QCOMPARE(tree5.structSpan(containerId), 88);
     }
+
+    void testLayoutIndexFollowsGeneration() {
+        using namespace rcx;
+        NodeTree tree;
+        Node root; root.kind = NodeKind::Struct; root.name = "R"; root.offset = 0x10;
+        uint64_t rootId = tree.nodes[tree.addNode(root)].id;
+        Node inner; inner.kind = NodeKind::Struct; inner.name = "I";
+        inner.parentId = rootId; inner.offset = 8;
+        int ii = tree.addNode(inner);
+        uint64_t innerId = tree.nodes[ii].id;
+        Node leaf; leaf.kind = NodeKind::UInt32; leaf.name = "x";
+        leaf.parentId = innerId; leaf.offset = 4;
+        int li = tree.addNode(leaf);
+
+        QCOMPARE(tree.computeOffset(li), int64_t(0x10 + 8 + 4));
+        QCOMPARE(tree.depthOf(li), 2);
+        QCOMPARE(tree.structSpan(rootId), 16);
+        QCOMPARE(tree.childrenOf(innerId), QVector<int>{li});
+
+        // Queries reuse the index until the generation moves
+        uint64_t gen = tree.generation();
+        const auto* built = &tree.layoutIndex();
+        QCOMPARE(tree.layoutIndex().generation, gen);
+        tree.computeOffset(ii);
+        QCOMPARE(tree.generation(), gen);
+        QCOMPARE(&tree.layoutIndex(), built);
+
+        // Reads through a non-const tree keep the index
+        QCOMPARE(tree.nodes[ii].offset, 8);
+        QCOMPARE(&tree.layoutIndex(), built);
+        QCOMPARE(tree.layoutIndex().generation, gen);
+
+        // In-place edits are seen after invalidateLayout()
+        tree.nodes[ii].offset = 0x20;
+        tree.invalidateLayout();
+        QVERIFY(tree.generation() != gen);
+        QCOMPARE(tree.computeOffset(li), int64_t(0x10 + 0x20 + 4));
+        QCOMPARE(tree.structSpan(rootId), 0x28);
+
+        // addNode moves the generation too
+        gen = tree.generation();
+        Node leaf2; leaf2.kind = NodeKind::UInt64; leaf2.name = "y";
+        leaf2.parentId = innerId; leaf2.offset = 8;
+        int l2 = tree.addNode(leaf2);
+        QVERIFY(tree.generation() != gen);
+        QCOMPARE(tree.childrenOf(innerId), (QVector<int>{li, l2}));
+        QCOMPARE(tree.structSpan(innerId), 16);
+        QCOMPARE(tree.depthOf(l2), 2);
+    }
+    void testStructSpanIgnoresQueryOrderInCycles() {
+        using namespace rcx;
+        // A embeds B, and B embeds A back: each span cuts the cycle where
+        // the walk entered it
+        NodeTree tree;
+        Node a; a.kind = NodeKind::Struct; a.name = "A";
+        uint64_t aId = tree.nodes[tree.addNode(a)].id;
+        Node b; b.kind = NodeKind::Struct; b.name = "B";
+        uint64_t bId = tree.nodes[tree.addNode(b)].id;
+        Node f; f.kind = NodeKind::UInt32; f.name = "f"; f.parentId = aId;
+        tree.addNode(f);
+        Node eb; eb.kind = NodeKind::Struct; eb.name = "b"; eb.parentId = aId;
+        eb.offset = 4; eb.refId = bId;
+        tree.addNode(eb);
+        Node g; g.kind = NodeKind::UInt64; g.name = "g"; g.parentId = bId;
+        tree.addNode(g);
+        Node ea; ea.kind = NodeKind::Struct; ea.name = "a"; ea.parentId = bId;
+        ea.offset = 8; ea.refId = aId;
+        tree.addNode(ea);
+
+        int spanA = tree.structSpan(aId);
+        int spanB = tree.structSpan(bId);
+        tree.invalidateLayout();
+        QCOMPARE(tree.structSpan(bId), spanB);
+        QCOMPARE(tree.structSpan(aId), spanA);
+        QCOMPARE(spanA, 4 + 8);
+        QCOMPARE(spanB, 8 + 4);
+    }
+
     void testNormalizePreferAncestors() {
         using namespace rcx;
         NodeTree tree;
@@ -671,6 +750,118 @@ private slots:
         QCOMPARE(h.count, 4);       // 4 transitions
         QCOMPARE(h.heatLevel(), 2); // warm (count=4 → 3-4 range)
     }
+
+    // Main (at 0) -> A (at 0x3000) -> B (at 0x7000), B points back at A.
+    // Pages come from a flat buffer; every fetch call is one round.
+    void testPointerChase_roundsFollowFreshPointers() {
+        using namespace rcx;
+        NodeTree tree;
+        auto addStruct = [&](const char* name) {
+            Node n; n.kind = NodeKind::Struct; n.name = name; n.parentId = 0;
+            return tree.nodes[tree.addNode(n)].id;
+        };
+        auto addField = [&](uint64_t parent, NodeKind kind, int offset, uint64_t ref = 0) {
+            Node n; n.kind = kind; n.name = "f"; n.parentId = parent;
+            n.offset = offset; n.refId = ref;
+            return tree.addNode(n);
+        };
+        uint64_t mainId = addStruct("Main");
+        uint64_t aId = addStruct("A");
+        uint64_t bId = addStruct("B");
+        addField(mainId, NodeKind::UInt64, 0);
+        addField(mainId, NodeKind::Pointer64, 8, aId);
+        addField(aId, NodeKind::Pointer64, 0, bId);
+        addField(bId, NodeKind::Pointer32, 0, aId);
+        int hidden = addField(mainId, NodeKind::Pointer64, 16, bId);
+        tree.nodes[hidden].collapsed = true;
+
+        QByteArray mem(0x10000, '\0');
+        auto put64 = [&](int off, uint64_t v) { std::memcpy(mem.data() + off, &v, 8); };
+        put64(8, 0x3000);
+        put64(16, 0x9000);            // collapsed: never followed
+        put64(0x3000, 0x7000);
+        put64(0x7000, 0x3000);        // cycle back to A
+
+        QVector<QVector<uint64_t>> calls;
+        auto fetch = [&](const QVector<uint64_t>& want, ChasePlan::PageMap& into) {
+            calls.append(want);
+            for (uint64_t p : want)
+                if (p + 4096 <= uint64_t(mem.size()))
+                    into.insert(p, mem.mid(int(p), 4096));
+        };
+
+        ChasePlan plan = ChasePlan::build(tree, mainId, 0, 24);
+        QCOMPARE(plan.layouts.size(), 3);
+        int rounds = 0;
+        auto pages = plan.run(fetch, &rounds);
+        QCOMPARE(rounds, 3);
+        QCOMPARE(calls[0], QVector<uint64_t>{0});
+        QCOMPARE(calls[1], QVector<uint64_t>{0x3000});
+        QCOMPARE(calls[2], QVector<uint64_t>{0x7000});
+        QVERIFY(!pages.contains(0x9000));
+
+        // A pointer that moved is followed in the same run, not one later
+        put64(8, 0x5000);
+        put64(0x5000, 0);
+        calls.clear();
+        pages = plan.run(fetch, &rounds);
+        QCOMPARE(rounds, 2);
+        QVERIFY(pages.contains(0x5000));
+        QVERIFY(!pages.contains(0x3000));
+
+        // Depth limit stops the chain; unreadable targets end it quietly
+        put64(8, 0x3000);
+        plan.maxDepth = 2;
+        pages = plan.run(fetch, &rounds);
+        QCOMPARE(rounds, 2);
+        QVERIFY(!pages.contains(0x7000));
+        plan.maxDepth = 99;
+        put64(0x3000, 0xFFFF0000);
+        pages = plan.run(fetch, &rounds);
+        QCOMPARE(rounds, 3);
+        QVERIFY(!pages.contains(0xFFFF0000));
+    }
+
+    void testPointerChase_predictWalksKnownPagesOnly() {
+        using namespace rcx;
+        NodeTree tree;
+        Node m; m.kind = NodeKind::Struct; m.name = "Main"; m.parentId = 0;
+        uint64_t mainId = tree.nodes[tree.addNode(m)].id;
+        Node t; t.kind = NodeKind::Struct; t.name = "T"; t.parentId = 0;
+        uint64_t tId = tree.nodes[tree.addNode(t)].id;
+        Node p; p.kind = NodeKind::Pointer64; p.name = "p"; p.parentId = mainId;
+        p.offset = 0x1ff8; p.refId = tId;
+        tree.addNode(p);
+        Node q = p; q.parentId = tId; q.offset = 0;
+        tree.addNode(q);
+
+        ChasePlan plan = ChasePlan::build(tree, mainId, 0x10000, 0x2000);
+        QCOMPARE(plan.layouts.value(mainId).span, 0x2000);
+
+        // Nothing known: only the root range, no pointer followed
+        QCOMPARE(plan.predict({}), (QVector<uint64_t>{0x10000, 0x11000}));
+
+        // Root page known but the pointer's target page is not: the target
+        // is predicted, its own pointer is not
+        QByteArray root(4096, '\0');
+        uint64_t target = 0x40000;
+        std::memcpy(root.data() + 0xff8, &target, 8);
+        ChasePlan::PageMap known;
+        known.insert(0x11000, root);
+        QCOMPARE(plan.predict(known), (QVector<uint64_t>{0x10000, 0x11000, 0x40000}));
+
+        // Target known too: the chain continues through it
+        QByteArray tp(4096, '\0');
+        uint64_t next = 0x80000;
+        std::memcpy(tp.data(), &next, 8);
+        known.insert(0x40000, tp);
+        QCOMPARE(plan.predict(known),
+                 (QVector<uint64_t>{0x10000, 0x11000, 0x40000, 0x80000}));
+
+        // The base moves without a rebuild
+        plan.rootBase = 0x20000;
+        QCOMPARE(plan.predict({}), (QVector<uint64_t>{0x20000, 0x21000}));
+    }
 };
 
 QTEST_MAIN(TestCore)
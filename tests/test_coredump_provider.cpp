@@ -0,0 +1,197 @@
+#include <QTest>
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <cstring>
+
+#include "providers/provider.h"
+#include "../plugins/CoreDump/CoreDumpPlugin.h"
+
+using namespace rcx;
+
+// ── Synthetic core builder ──
+//
+// Layout (ELF64, little-endian):
+//   0x0000  ELF header + 3 program headers
+//   0x00E8  PT_NOTE: NT_FILE with two mapped files
+//   0x1000  PT_LOAD  0x400000          filesz 0x1000 memsz 0x2000  r-x
+//   0x2000  PT_LOAD  0x7f0000000000    filesz 0x1000 memsz 0x1000  rw-
+
+static constexpr uint64_t kExeBase  = 0x400000;
+static constexpr uint64_t kLibcBase = 0x7f0000000000ULL;
+
+template<typename T>
+static void put(QByteArray& b, int off, T v) { std::memcpy(b.data() + off, &v, sizeof(T)); }
+
+static QByteArray buildNtFile() {
+    struct Entry { uint64_t start, end, pgoff; const char* path; };
+    const Entry entries[] = {
+        { kExeBase,          kExeBase + 0x1000,  0, "/usr/bin/demo" },
+        { kExeBase + 0x1000, kExeBase + 0x2000,  1, "/usr/bin/demo" },
+        { kLibcBase,         kLibcBase + 0x1000, 0, "/lib/libc.so.6" },
+    };
+    QByteArray desc;
+    auto word = [&](uint64_t v) { desc.append(reinterpret_cast<const char*>(&v), 8); };
+    word(3);
+    word(4096);
+    for (const auto& e : entries) { word(e.start); word(e.end); word(e.pgoff); }
+    for (const auto& e : entries) desc.append(e.path, int(std::strlen(e.path) + 1));
+    while (desc.size() % 4) desc.append('\0');
+
+    QByteArray note(12, '\0');
+    put<uint32_t>(note, 0, 5);                       // "CORE\0"
+    put<uint32_t>(note, 4, uint32_t(desc.size()));
+    put<uint32_t>(note, 8, 0x46494C45);              // NT_FILE
+    note.append("CORE\0\0\0\0", 8);
+    note.append(desc);
+    return note;
+}
+
+static QByteArray buildCore() {
+    QByteArray note = buildNtFile();
+    QByteArray f(0x3000, '\0');
+
+    std::memcpy(f.data(), "\x7f" "ELF", 4);
+    f[4] = 2;                       // ELFCLASS64
+    f[5] = 1;                       // ELFDATA2LSB
+    f[6] = 1;                       // EV_CURRENT
+    put<uint16_t>(f, 16, 4);        // ET_CORE
+    put<uint16_t>(f, 18, 62);       // EM_X86_64
+    put<uint32_t>(f, 20, 1);
+    put<uint64_t>(f, 32, 64);       // e_phoff
+    put<uint16_t>(f, 52, 64);       // e_ehsize
+    put<uint16_t>(f, 54, 56);       // e_phentsize
+    put<uint16_t>(f, 56, 3);        // e_phnum
+
+    auto phdr = [&](int i, uint32_t type, uint32_t flags, uint64_t off,
+                    uint64_t vaddr, uint64_t filesz, uint64_t memsz) {
+        int p = 64 + i * 56;
+        put<uint32_t>(f, p + 0,  type);
+        put<uint32_t>(f, p + 4,  flags);
+        put<uint64_t>(f, p + 8,  off);
+        put<uint64_t>(f, p + 16, vaddr);
+        put<uint64_t>(f, p + 32, filesz);
+        put<uint64_t>(f, p + 40, memsz);
+    };
+    const int noteOff = 64 + 3 * 56;
+    phdr(0, 4, 0, noteOff, 0, note.size(), 0);
+    phdr(1, 1, 4 | 1, 0x1000, kExeBase, 0x1000, 0x2000);
+    phdr(2, 1, 4 | 2, 0x2000, kLibcBase, 0x1000, 0x1000);
+    std::memcpy(f.data() + noteOff, note.constData(), note.size());
+
+    for (int i = 0; i < 0x1000; i++) f[0x1000 + i] = char(i & 0xFF);
+    std::memset(f.data() + 0x2000, 0xAB, 0x1000);
+    return f;
+}
+
+class TestCoreDumpProvider : public QObject {
+    Q_OBJECT
+
+private:
+    QString m_path;
+
+    static QString writeTemp(const QString& name, const QByteArray& data) {
+        QString path = QDir::tempPath() + "/" + name;
+        QFile f(path);
+        if (f.open(QIODevice::WriteOnly)) f.write(data);
+        return path;
+    }
+
+private slots:
+    void initTestCase() {
+        m_path = writeTemp("rcx_test_core.core", buildCore());
+    }
+
+    void cleanupTestCase() {
+        QFile::remove(m_path);
+    }
+
+    void opensAndIndexesSegments() {
+        CoreDumpProvider p(m_path);
+        QVERIFY2(p.isValid(), qPrintable(p.errorString()));
+        QVERIFY(p.isMapped());
+        QVERIFY(!p.isLive());
+        QCOMPARE(p.kind(), QStringLiteral("CoreDump"));
+        QCOMPARE(p.segments().size(), 2);
+        QCOMPARE(p.segments()[0].vaddr, kExeBase);
+        QCOMPARE(p.segments()[1].vaddr, kLibcBase);
+        QCOMPARE(p.size64(), kLibcBase + 0x1000);
+    }
+
+    void readsFromMapping() {
+        CoreDumpProvider p(m_path);
+        QCOMPARE(p.readU8(kExeBase + 0x10), (uint8_t)0x10);
+        QCOMPARE(p.readU32(kExeBase + 0x100), (uint32_t)0x03020100);
+        QCOMPARE(p.readU8(kLibcBase + 0xFFF), (uint8_t)0xAB);
+    }
+
+    void tailPastFileszReadsZero() {
+        CoreDumpProvider p(m_path);
+        QVERIFY(p.isReadable(kExeBase + 0x1800, 8));
+        uint64_t v = ~0ULL;
+        QVERIFY(p.read(kExeBase + 0xFFC, &v, 8));   // straddles filesz
+        QCOMPARE(v, (uint64_t)0x00000000FFFEFDFCULL);
+    }
+
+    void unmappedAddressFails() {
+        CoreDumpProvider p(m_path);
+        uint32_t v = 0;
+        QVERIFY(!p.read(0x500000, &v, 4));
+        QVERIFY(!p.isReadable(0x500000, 4));
+        QVERIFY(!p.isReadable(kExeBase + 0x1FFE, 4));   // runs off the segment
+        QVERIFY(!p.isReadable(kExeBase - 1, 1));
+    }
+
+    void regionsFromSegments() {
+        CoreDumpProvider p(m_path);
+        auto regs = p.regions();
+        QCOMPARE(regs.size(), 2);
+        QCOMPARE(regs[0].base, kExeBase);
+        QCOMPARE(regs[0].size, (uint64_t)0x2000);
+        QCOMPARE(regs[0].prot, (uint32_t)(RP_Read | RP_Exec));
+        QCOMPARE(regs[0].name, QStringLiteral("/usr/bin/demo"));
+        QCOMPARE(regs[1].prot, (uint32_t)(RP_Read | RP_Write));
+        QCOMPARE(regs[1].name, QStringLiteral("/lib/libc.so.6"));
+    }
+
+    void modulesFromNtFile() {
+        CoreDumpProvider p(m_path);
+        QCOMPARE(p.modules().size(), 2);
+        QCOMPARE(p.base(), kExeBase);
+        QCOMPARE(p.getSymbol(kExeBase + 0x1234), QStringLiteral("demo+0x1234"));
+        QCOMPARE(p.getSymbol(kLibcBase + 0x10), QStringLiteral("libc.so.6+0x10"));
+        QVERIFY(p.getSymbol(0x500000).isEmpty());
+        QCOMPARE(p.symbolToAddress("LIBC.so.6"), kLibcBase);
+        QCOMPARE(p.symbolToAddress("missing"), (uint64_t)0);
+    }
+
+    void rejectsNonCore() {
+        QByteArray exe = buildCore();
+        exe[16] = 2;   // ET_EXEC
+        QString path = writeTemp("rcx_test_not_core.bin", exe);
+        {
+            CoreDumpProvider p(path);
+            QVERIFY(!p.isValid());
+            QVERIFY(!p.errorString().isEmpty());
+        }
+        QFile::remove(path);
+
+        CoreDumpProvider missing(QDir::tempPath() + "/rcx_no_such_core");
+        QVERIFY(!missing.isValid());
+    }
+
+    void pluginHandlesCorePrefix() {
+        CoreDumpPlugin plugin;
+        QVERIFY(plugin.canHandle("core:/tmp/x"));
+        QVERIFY(!plugin.canHandle("1234:notepad"));
+        QString err;
+        QVERIFY(!plugin.createProvider("core:/nonexistent/core", &err));
+        QVERIFY(!err.isEmpty());
+        auto prov = plugin.createProvider("core:" + m_path, &err);
+        QVERIFY(prov);
+        QCOMPARE(plugin.getInitialBaseAddress("core:" + m_path), kExeBase);
+    }
+};
+
+QTEST_MAIN(TestCoreDumpProvider)
+#include "test_coredump_provider.moc"
@@ -1497,6 +1497,102 @@ private slots:
         m_editor->applyDocument(m_result);
     }
 
+    // ── Test: value-only refresh patches changed lines in place ──
+    void testValueRefreshPatchesLinesInPlace() {
+        constexpr int IND_HEAT_WARM = 17;  // replicated from editor.cpp
+
+        NodeTree tree;
+        tree.baseAddress = 0;
+        Node root;
+        root.kind = NodeKind::Struct;
+        root.structTypeName = "Pair";
+        root.name = "p";
+        root.parentId = 0;
+        root.offset = 0;
+        int ri = tree.addNode(root);
+        uint64_t rootId = tree.nodes[ri].id;
+        uint64_t ids[2];
+        for (int i = 0; i < 2; i++) {
+            Node n;
+            n.kind = NodeKind::UInt32;
+            n.name = i == 0 ? "count" : "flags";
+            n.parentId = rootId;
+            n.offset = i * 4;
+            ids[i] = tree.nodes[tree.addNode(n)].id;
+        }
+
+        QByteArray data(8, '\0');
+        data[0] = 7;
+        ComposeResult before = compose(tree, BufferProvider(data));
+        auto lineOf = [&](uint64_t id) {
+            for (int i = 0; i < before.meta.size(); i++)
+                if (before.meta[i].nodeId == id && before.meta[i].lineKind == LineKind::Field)
+                    return i;
+            return -1;
+        };
+        int countLine = lineOf(ids[0]);
+        int flagsLine = lineOf(ids[1]);
+        QVERIFY(countLine >= 0 && flagsLine >= 0);
+        before.meta[flagsLine].heatLevel = 2;
+
+        auto* editor = new RcxEditor();
+        editor->resize(600, 300);
+        editor->show();
+        QVERIFY(QTest::qWaitForWindowExposed(editor));
+        auto* sci = editor->scintilla();
+        auto lineText = [&](int line) {
+            QString t = sci->text(line);
+            while (t.endsWith('\n') || t.endsWith('\r')) t.chop(1);
+            return t;
+        };
+        auto heatAt = [&](int line) {
+            long pos = sci->SendScintilla(QsciScintillaBase::SCI_POSITIONFROMLINE,
+                                          (unsigned long)line);
+            long end = sci->SendScintilla(QsciScintillaBase::SCI_GETLINEENDPOSITION,
+                                          (unsigned long)line);
+            for (; pos < end; pos++)
+                if (sci->SendScintilla(QsciScintillaBase::SCI_INDICATORVALUEAT,
+                                       (unsigned long)IND_HEAT_WARM, pos))
+                    return true;
+            return false;
+        };
+
+        // First apply loads the whole document
+        QVERIFY(!editor->applyDocument(before));
+        QVERIFY(heatAt(flagsLine));
+        QString flagsText = lineText(flagsLine);
+        sci->setCursorPosition(flagsLine, 5);
+
+        // A new value on one line and cooled heat on another: same structure
+        data[0] = 9;
+        ComposeResult after = compose(tree, BufferProvider(data));
+        QCOMPARE(after.meta.size(), before.meta.size());
+        QVERIFY(editor->applyDocument(after));
+
+        const QStringList want = after.text.split('\n');
+        QCOMPARE(lineText(countLine), want[countLine]);
+        QVERIFY(lineText(countLine) != before.text.split('\n')[countLine]);
+        QCOMPARE(lineText(flagsLine), flagsText);
+        QVERIFY(!heatAt(flagsLine));
+        int line, col;
+        sci->getCursorPosition(&line, &col);
+        QCOMPARE(line, flagsLine);
+        QCOMPARE(col, 5);
+
+        // Adding a field changes the structure: full reload
+        Node extra;
+        extra.kind = NodeKind::UInt32;
+        extra.name = "extra";
+        extra.parentId = rootId;
+        extra.offset = 8;
+        tree.addNode(extra);
+        ComposeResult grown = compose(tree, BufferProvider(QByteArray(12, '\0')));
+        QVERIFY(!editor->applyDocument(grown));
+        QCOMPARE(sci->lines(), grown.meta.size());
+
+        delete editor;
+    }
+
     void testMenuHoverRendersAmberText() {
         // Replicate MenuBarStyle with drawControl hover override
         class TestMenuStyle : public QProxyStyle {
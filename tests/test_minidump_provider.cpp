@@ -0,0 +1,209 @@
+#include <QTest>
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <cstring>
+
+#include "providers/provider.h"
+#include "../plugins/Minidump/MinidumpPlugin.h"
+
+using namespace rcx;
+
+// ── Synthetic minidump builder ──
+//
+//   header → directory of 4 streams
+//   ModuleList      game.exe @ 0x140000000 (0x3000), ntdll.dll @ 0x7ff800000000
+//   Memory64List    0x140000000 (0x1000) + 0x140001000 (0x1000), contiguous
+//   MemoryList      0x1000000 (0x100), a thread stack
+//   MemoryInfoList  0x140000000 r-x, 0x140001000 rw-
+
+static constexpr uint64_t kExeBase   = 0x140000000ULL;
+static constexpr uint64_t kNtdllBase = 0x7ff800000000ULL;
+static constexpr uint64_t kStackVa   = 0x1000000;
+
+template<typename T>
+static void put(QByteArray& b, int off, T v) { std::memcpy(b.data() + off, &v, sizeof(T)); }
+
+template<typename T>
+static int append(QByteArray& b, T v) {
+    int off = b.size();
+    b.append(reinterpret_cast<const char*>(&v), sizeof(T));
+    return off;
+}
+
+static int appendString(QByteArray& b, const char* s) {
+    int off = append<uint32_t>(b, uint32_t(std::strlen(s) * 2));
+    for (const char* p = s; *p; p++) append<uint16_t>(b, uint16_t(*p));
+    append<uint16_t>(b, 0);
+    return off;
+}
+
+static QByteArray buildMinidump() {
+    QByteArray f(32 + 4 * 12, '\0');
+    put<uint32_t>(f, 0, 0x504D444D);
+    put<uint32_t>(f, 4, 0xA793);
+    put<uint32_t>(f, 8, 4);
+    put<uint32_t>(f, 12, 32);
+    auto dirEntry = [&](int i, uint32_t type, int rva, int size) {
+        put<uint32_t>(f, 32 + i * 12, type);
+        put<uint32_t>(f, 32 + i * 12 + 4, uint32_t(size));
+        put<uint32_t>(f, 32 + i * 12 + 8, uint32_t(rva));
+    };
+
+    int exeName   = appendString(f, "C:\\game\\game.exe");
+    int ntdllName = appendString(f, "C:\\Windows\\System32\\ntdll.dll");
+
+    // ModuleList
+    int modList = append<uint32_t>(f, 2);
+    auto module = [&](uint64_t base, uint32_t size, int nameRva) {
+        QByteArray m(108, '\0');
+        put<uint64_t>(m, 0, base);
+        put<uint32_t>(m, 8, size);
+        put<uint32_t>(m, 20, uint32_t(nameRva));
+        f.append(m);
+    };
+    module(kExeBase, 0x3000, exeName);
+    module(kNtdllBase, 0x1000, ntdllName);
+    dirEntry(0, 4, modList, f.size() - modList);
+
+    // MemoryInfoList
+    int infoList = append<uint32_t>(f, 16);
+    append<uint32_t>(f, 48);
+    append<uint64_t>(f, 2);
+    auto info = [&](uint64_t base, uint64_t size, uint32_t protect) {
+        QByteArray e(48, '\0');
+        put<uint64_t>(e, 0, base);
+        put<uint64_t>(e, 24, size);
+        put<uint32_t>(e, 32, 0x1000);   // MEM_COMMIT
+        put<uint32_t>(e, 36, protect);
+        f.append(e);
+    };
+    info(kExeBase, 0x1000, 0x20);            // PAGE_EXECUTE_READ
+    info(kExeBase + 0x1000, 0x1000, 0x04);   // PAGE_READWRITE
+    dirEntry(1, 16, infoList, f.size() - infoList);
+
+    // MemoryList: one descriptor, data placed after the Memory64 blob
+    int memList = append<uint32_t>(f, 1);
+    append<uint64_t>(f, kStackVa);
+    int stackDesc = append<uint32_t>(f, 0x100);
+    append<uint32_t>(f, 0);                  // RVA patched below
+    dirEntry(2, 5, memList, f.size() - memList);
+
+    // Memory64List
+    int mem64 = append<uint64_t>(f, 2);
+    int baseRvaOff = append<uint64_t>(f, 0);
+    append<uint64_t>(f, kExeBase);
+    append<uint64_t>(f, 0x1000);
+    append<uint64_t>(f, kExeBase + 0x1000);
+    append<uint64_t>(f, 0x1000);
+    dirEntry(3, 9, mem64, f.size() - mem64);
+
+    put<uint64_t>(f, baseRvaOff, uint64_t(f.size()));
+    for (int i = 0; i < 0x2000; i++) f.append(char(i & 0xFF));
+
+    put<uint32_t>(f, stackDesc + 4, uint32_t(f.size()));
+    f.append(QByteArray(0x100, '\x5A'));
+    return f;
+}
+
+class TestMinidumpProvider : public QObject {
+    Q_OBJECT
+
+private:
+    QString m_path;
+
+    static QString writeTemp(const QString& name, const QByteArray& data) {
+        QString path = QDir::tempPath() + "/" + name;
+        QFile f(path);
+        if (f.open(QIODevice::WriteOnly)) f.write(data);
+        return path;
+    }
+
+private slots:
+    void initTestCase() {
+        m_path = writeTemp("rcx_test_minidump.dmp", buildMinidump());
+    }
+
+    void cleanupTestCase() {
+        QFile::remove(m_path);
+    }
+
+    void indexesBothMemoryLists() {
+        MinidumpProvider p(m_path);
+        QVERIFY2(p.isValid(), qPrintable(p.errorString()));
+        QCOMPARE(p.kind(), QStringLiteral("Minidump"));
+        QVERIFY(!p.isLive());
+        QCOMPARE(p.ranges().size(), 3);
+        QCOMPARE(p.ranges()[0].va, kStackVa);
+        QCOMPARE(p.ranges()[1].va, kExeBase);
+        QCOMPARE(p.ranges()[2].va, kExeBase + 0x1000);
+    }
+
+    void readsAcrossContiguousRanges() {
+        MinidumpProvider p(m_path);
+        QCOMPARE(p.readU8(kExeBase + 0x10), (uint8_t)0x10);
+        QCOMPARE(p.readU32(kExeBase + 0xFFE), (uint32_t)0x0100FFFE);
+        QCOMPARE(p.readU8(kExeBase + 0x1FFF), (uint8_t)0xFF);
+        QCOMPARE(p.readU8(kStackVa + 0x80), (uint8_t)0x5A);
+    }
+
+    void undumpedMemoryFails() {
+        MinidumpProvider p(m_path);
+        uint32_t v = 0;
+        QVERIFY(!p.read(kExeBase + 0x2000, &v, 4));
+        QVERIFY(!p.read(kExeBase + 0x1FFE, &v, 4));
+        QVERIFY(p.isReadable(kExeBase + 0xFF0, 0x20));
+        QVERIFY(!p.isReadable(kExeBase + 0x1FF0, 0x20));
+        QVERIFY(!p.isReadable(kNtdllBase, 1));
+    }
+
+    void regionsCarryProtection() {
+        MinidumpProvider p(m_path);
+        auto regs = p.regions();
+        QCOMPARE(regs.size(), 3);
+        QCOMPARE(regs[1].prot, (uint32_t)(RP_Read | RP_Exec));
+        QCOMPARE(regs[2].prot, (uint32_t)(RP_Read | RP_Write));
+        QCOMPARE(regs[0].prot, (uint32_t)RP_Read);
+        QCOMPARE(regs[1].name, QStringLiteral("C:\\game\\game.exe"));
+    }
+
+    void modulesFromModuleList() {
+        MinidumpProvider p(m_path);
+        QCOMPARE(p.modules().size(), 2);
+        QCOMPARE(p.base(), kExeBase);
+        QCOMPARE(p.getSymbol(kExeBase + 0x2100), QStringLiteral("game.exe+0x2100"));
+        QCOMPARE(p.getSymbol(kNtdllBase + 0xA30), QStringLiteral("ntdll.dll+0xa30"));
+        QVERIFY(p.getSymbol(kStackVa).isEmpty());
+        QCOMPARE(p.symbolToAddress("NTDLL.DLL"), kNtdllBase);
+        QCOMPARE(p.symbolToAddress("kernel32.dll"), (uint64_t)0);
+    }
+
+    void rejectsBadFiles() {
+        QByteArray bad = buildMinidump();
+        bad[0] = 'X';
+        QString path = writeTemp("rcx_test_bad.dmp", bad);
+        {
+            MinidumpProvider p(path);
+            QVERIFY(!p.isValid());
+            QVERIFY(!p.errorString().isEmpty());
+        }
+        QFile::remove(path);
+
+        MinidumpProvider missing(QDir::tempPath() + "/rcx_no_such_dump.dmp");
+        QVERIFY(!missing.isValid());
+    }
+
+    void pluginHandlesMinidumpPrefix() {
+        MinidumpPlugin plugin;
+        QVERIFY(plugin.canHandle("minidump:/tmp/x.dmp"));
+        QVERIFY(!plugin.canHandle("dump:/tmp/x.dmp"));
+        QString err;
+        QVERIFY(!plugin.createProvider("minidump:/nonexistent.dmp", &err));
+        QVERIFY(!err.isEmpty());
+        QVERIFY(plugin.createProvider("minidump:" + m_path, &err));
+        QCOMPARE(plugin.getInitialBaseAddress("minidump:" + m_path), kExeBase);
+    }
+};
+
+QTEST_MAIN(TestMinidumpProvider)
+#include "test_minidump_provider.moc"
@@ -95,6 +95,9 @@ private slots:
         input.menuBarTitleCase = false;
         input.safeMode = true;
         input.autoStartMcp = true;
+        input.softDirtyRefresh = true;
+        input.adaptiveRefresh = false;
+        input.refreshPrefetchLines = 64;
 
         OptionsDialog dlg(input);
         auto r = dlg.result();
@@ -104,6 +107,9 @@ private slots:
         QCOMPARE(r.menuBarTitleCase, false);
         QCOMPARE(r.safeMode, true);
         QCOMPARE(r.autoStartMcp, true);
+        QCOMPARE(r.softDirtyRefresh, true);
+        QCOMPARE(r.adaptiveRefresh, false);
+        QCOMPARE(r.refreshPrefetchLines, 64);
     }
 
     void noStyleSheetOnDialog() {
@@ -262,6 +268,19 @@ private slots:
         QCOMPARE(spin->value(), 1);
     }
 
+    void historyBudgetResultReflectsInput() {
+        OptionsResult input;
+        input.historyBudgetMB = 512;
+        OptionsDialog dlg(input);
+        QCOMPARE(dlg.result().historyBudgetMB, 512);
+
+        auto* spin = dlg.findChild<QSpinBox*>("historyBudgetSpin");
+        QVERIFY(spin);
+        QCOMPARE(spin->minimum(), 0);   // 0 turns history off
+        spin->setValue(0);
+        QCOMPARE(dlg.result().historyBudgetMB, 0);
+    }
+
     void dialogInheritsPalette() {
         auto& tm = ThemeManager::instance();
         const auto& theme = tm.current();
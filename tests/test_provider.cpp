@@ -2,13 +2,126 @@
 #include <QByteArray>
 #include <QDir>
 #include <QFile>
+#include <QThread>
 #include <cstring>
+#include <thread>
 #include "providers/provider.h"
 #include "providers/buffer_provider.h"
 #include "providers/null_provider.h"
+#include "providers/mapped_file_provider.h"
+#include "providers/caching_provider.h"
+#include "providers/snapshot_provider.h"
+#include "providers/snapshot_history.h"
+#include "providers/async_read.h"
+#include "providers/parallel_read.h"
+#include "providers/elf_symbols.h"
+#include "providers/image_provider.h"
+#include "providers/page_diff.h"
+#include "providers/refresh_scheduler.h"
+#ifdef __linux__
+#include "providers/uring_reader.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 using namespace rcx;
 
+#ifdef __linux__
+namespace rcx_test {
+// Symbolization targets; noinline keeps elfProbe a real function
+__attribute__((noinline)) int elfProbe(int x) { return x * 3 + 1; }
+int g_elfProbeData[16];
+uint32_t g_imageProbe = 0x5EC7104;
+}
+
+// Lowest mapping of this test executable
+static ModuleSymbolizer::Module selfModule() {
+    ModuleSymbolizer::Module m;
+    char exe[4096];
+    ssize_t n = ::readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+    if (n <= 0) return m;
+    exe[n] = 0;
+    QFile maps(QStringLiteral("/proc/self/maps"));
+    if (!maps.open(QIODevice::ReadOnly)) return m;
+    uint64_t lo = 0, hi = 0;
+    for (const QByteArray& line : maps.readAll().split('\n')) {
+        if (!line.endsWith(QByteArray(exe))) continue;
+        int dash = line.indexOf('-'), sp = line.indexOf(' ');
+        uint64_t a = line.left(dash).toULongLong(nullptr, 16);
+        uint64_t b = line.mid(dash + 1, sp - dash - 1).toULongLong(nullptr, 16);
+        if (!lo || a < lo) lo = a;
+        if (b > hi) hi = b;
+    }
+    m.path = QString::fromUtf8(exe);
+    m.name = m.path.mid(m.path.lastIndexOf('/') + 1);
+    m.base = lo;
+    m.size = hi - lo;
+    return m;
+}
+#endif
+
+template<typename T>
+static void put(QByteArray& b, int off, T v) { std::memcpy(b.data() + off, &v, sizeof(T)); }
+
+static QString writeTemp(const QString& name, const QByteArray& data) {
+    QString path = QDir::tempPath() + "/" + name;
+    QFile f(path);
+    if (f.open(QIODevice::WriteOnly)) f.write(data);
+    return path;
+}
+
+static QByteArray makeBuffer(int size) {
+    QByteArray d(size, Qt::Uninitialized);
+    for (int i = 0; i < size; i++)
+        d[i] = static_cast<char>(i * 7);
+    return d;
+}
+
+// High-latency source: every readBatch call stalls, and the peak number of
+// calls in progress at once is recorded
+class SlowBatchProvider : public BufferProvider {
+public:
+    SlowBatchProvider(QByteArray data, int limit)
+        : BufferProvider(std::move(data)), m_limit(limit) {}
+    mutable std::atomic<int> calls{0}, inFlight{0}, peak{0};
+    void readBatch(ReadRequest* reqs, int count) const override {
+        calls++;
+        int now = ++inFlight;
+        int seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        BufferProvider::readBatch(reqs, count);
+        inFlight--;
+    }
+    int maxConcurrentReads() const override { return m_limit; }
+private:
+    int m_limit;
+};
+
+static QVector<ReadRequest> pageRequests(QVector<QByteArray>& bufs, int pages) {
+    bufs = QVector<QByteArray>(pages, QByteArray(4096, '\xCC'));
+    QVector<ReadRequest> reqs(pages);
+    for (int i = 0; i < pages; i++) {
+        reqs[i].addr = uint64_t(i) * 4096;
+        reqs[i].buf  = bufs[i].data();
+        reqs[i].len  = 4096;
+    }
+    return reqs;
+}
+
+// Live buffer that counts how often the target is actually read
+class CountingLiveProvider : public BufferProvider {
+public:
+    using BufferProvider::BufferProvider;
+    mutable int reads = 0;
+    bool read(uint64_t addr, void* buf, int len) const override {
+        reads++;
+        return BufferProvider::read(addr, buf, len);
+    }
+    bool isLive() const override { return true; }
+};
+
 class TestProvider : public QObject {
     Q_OBJECT
 
@@ -259,6 +372,907 @@ private slots:
         QFile::remove(path);
     }
 
+    // ---------------------------------------------------------------
+    // MappedFileProvider
+    // ---------------------------------------------------------------
+
+    void mapped_nonexistent() {
+        MappedFileProvider p("/tmp/__rcx_test_nonexistent_file__");
+        QVERIFY(!p.isMapped());
+        QVERIFY(!p.isValid());
+        QCOMPARE(p.size64(), (uint64_t)0);
+    }
+
+    void mapped_readsFileContents() {
+        QString path = QDir::tempPath() + "/rcx_test_mapped_provider.bin";
+        {
+            QFile f(path);
+            QVERIFY(f.open(QIODevice::WriteOnly));
+            QByteArray d(8192, '\0');
+            d[0] = '\x4D'; d[8191] = '\x5A';
+            f.write(d);
+        }
+        {
+            MappedFileProvider p(path);
+            QVERIFY(p.isMapped());
+            QCOMPARE(p.size(), 8192);
+            QCOMPARE(p.size64(), (uint64_t)8192);
+            QCOMPARE(p.readU8(0), (uint8_t)0x4D);
+            QCOMPARE(p.readU8(8191), (uint8_t)0x5A);
+            QVERIFY(p.isReadable(8191, 1));
+            QVERIFY(!p.isReadable(8191, 2));
+            QCOMPARE(p.name(), QStringLiteral("rcx_test_mapped_provider.bin"));
+        }
+        QFile::remove(path);
+    }
+
+    void mapped_writeIsCopyOnWriteUntilSaved() {
+        QString path = QDir::tempPath() + "/rcx_test_mapped_patch.bin";
+        {
+            QFile f(path);
+            QVERIFY(f.open(QIODevice::WriteOnly));
+            f.write(QByteArray(64, '\0'));
+        }
+        {
+            MappedFileProvider p(path);
+            QVERIFY(p.isWritable());
+            QVERIFY(p.writeBytes(4, QByteArray("\xAA\xBB", 2)));
+            QVERIFY(p.writeBytes(6, QByteArray("\xCC", 1)));
+            QVERIFY(p.writeBytes(32, QByteArray("\xDD", 1)));
+            QCOMPARE(p.readU8(5), (uint8_t)0xBB);
+            QCOMPARE(p.patches().size(), 2);   // [4,7) merged, [32,33)
+
+            // Disk copy unchanged before savePatches
+            QFile f(path);
+            QVERIFY(f.open(QIODevice::ReadOnly));
+            QCOMPARE(f.readAll(), QByteArray(64, '\0'));
+            f.close();
+
+            QVERIFY(p.savePatches());
+            QVERIFY(!p.hasPatches());
+        }
+        QFile f(path);
+        QVERIFY(f.open(QIODevice::ReadOnly));
+        QByteArray disk = f.readAll();
+        QCOMPARE((uint8_t)disk[4], (uint8_t)0xAA);
+        QCOMPARE((uint8_t)disk[6], (uint8_t)0xCC);
+        QCOMPARE((uint8_t)disk[32], (uint8_t)0xDD);
+        f.close();
+        QFile::remove(path);
+    }
+
+    void mapped_writePastEndFails() {
+        QString path = QDir::tempPath() + "/rcx_test_mapped_oob.bin";
+        {
+            QFile f(path);
+            QVERIFY(f.open(QIODevice::WriteOnly));
+            f.write(QByteArray(16, '\0'));
+        }
+        {
+            MappedFileProvider p(path);
+            QVERIFY(!p.writeBytes(12, QByteArray(8, 'X')));
+            QVERIFY(!p.hasPatches());
+        }
+        QFile::remove(path);
+    }
+
+    // ---------------------------------------------------------------
+    // Region map
+    // ---------------------------------------------------------------
+
+    void regions_defaultEmpty() {
+        BufferProvider p(QByteArray(16, '\0'));
+        QVERIFY(p.regions().isEmpty());
+    }
+
+    void regionsCover_binarySearch() {
+        QVector<MemoryRegion> regs;
+        regs.append({0x1000, 0x1000, RP_Read, {}});
+        regs.append({0x2000, 0x1000, RP_Read | RP_Write, {}});   // contiguous
+        regs.append({0x5000, 0x1000, RP_None, {}});              // guard page
+        regs.append({0x8000, 0x2000, RP_Read | RP_Exec, {}});
+        QVERIFY(regionsCover(regs, 0x1000, 4));
+        QVERIFY(regionsCover(regs, 0x1FFC, 8));      // spans two adjacent regions
+        QVERIFY(!regionsCover(regs, 0x2FFC, 8));     // runs into the gap
+        QVERIFY(!regionsCover(regs, 0x0800, 4));     // before first region
+        QVERIFY(!regionsCover(regs, 0x5000, 1));     // not readable
+        QVERIFY(regionsCover(regs, 0x9FFF, 1));
+        QVERIFY(!regionsCover(regs, 0xA000, 1));     // past last region
+        QVERIFY(regionsCover(regs, 0x4000, 0));      // empty range always ok
+    }
+
+    // ---------------------------------------------------------------
+    // readBatch -- default loop over read()
+    // ---------------------------------------------------------------
+
+    void readBatch_allInRange() {
+        QByteArray d(16, '\0');
+        for (int i = 0; i < d.size(); i++) d[i] = char(i);
+        BufferProvider p(d);
+        uint8_t a[4], b[4];
+        ReadRequest reqs[2];
+        reqs[0].addr = 0; reqs[0].buf = a; reqs[0].len = 4;
+        reqs[1].addr = 8; reqs[1].buf = b; reqs[1].len = 4;
+        p.readBatch(reqs, 2);
+        QVERIFY(reqs[0].ok);
+        QVERIFY(reqs[1].ok);
+        QCOMPARE(a[0], (uint8_t)0);
+        QCOMPARE(b[3], (uint8_t)11);
+    }
+
+    void readBatch_failedRangeZeroFilled() {
+        BufferProvider p(QByteArray(8, '\x11'));
+        uint8_t a[4], b[4];
+        std::memset(b, 0xFF, sizeof(b));
+        ReadRequest reqs[2];
+        reqs[0].addr = 0;  reqs[0].buf = a; reqs[0].len = 4;
+        reqs[1].addr = 64; reqs[1].buf = b; reqs[1].len = 4;
+        p.readBatch(reqs, 2);
+        QVERIFY(reqs[0].ok);
+        QVERIFY(!reqs[1].ok);
+        QCOMPARE(a[0], (uint8_t)0x11);
+        QCOMPARE(b[0], (uint8_t)0);
+        QCOMPARE(b[3], (uint8_t)0);
+    }
+
+    void readBatch_zeroLenNotOk() {
+        BufferProvider p(QByteArray(8, '\0'));
+        ReadRequest r;
+        r.addr = 0; r.buf = nullptr; r.len = 0;
+        p.readBatch(&r, 1);
+        QVERIFY(!r.ok);
+    }
+
+    // ---------------------------------------------------------------
+    // CachingProvider
+    // ---------------------------------------------------------------
+
+    void caching_repeatedReadsHitCache() {
+        auto real = std::make_shared<CountingLiveProvider>(makeBuffer(8192));
+        CachingProvider c(real, 16, 60000);
+        QCOMPARE(c.readU32(0x10), real->readU32(0x10));
+        int after = real->reads;
+        for (int i = 0; i < 10; i++)
+            c.readU32(0x20 + i * 4);
+        QCOMPARE(real->reads, after);
+        QCOMPARE(c.misses(), (uint64_t)1);
+        QCOMPARE(c.hits(), (uint64_t)10);
+    }
+
+    void caching_zeroTtlAlwaysRefetches() {
+        auto real = std::make_shared<CountingLiveProvider>(makeBuffer(4096));
+        CachingProvider c(real, 16, 0);
+        c.readU8(0);
+        c.readU8(0);
+        QCOMPARE(c.hits(), (uint64_t)0);
+        QCOMPARE(c.misses(), (uint64_t)2);
+    }
+
+    void caching_crossPageRead() {
+        auto real = std::make_shared<CountingLiveProvider>(makeBuffer(8192));
+        CachingProvider c(real, 16, 60000);
+        QCOMPARE(c.readBytes(4090, 12), real->readBytes(4090, 12));
+        QCOMPARE(c.cachedPages(), 2);
+    }
+
+    void caching_lruEvictsOldest() {
+        auto real = std::make_shared<CountingLiveProvider>(makeBuffer(4096 * 3));
+        CachingProvider c(real, 2, 60000);
+        c.readU8(0);
+        c.readU8(4096);
+        c.readU8(0);            // page 0 now most recent
+        c.readU8(8192);         // evicts page 1
+        QCOMPARE(c.cachedPages(), 2);
+        c.resetStats();
+        c.readU8(0);
+        c.readU8(4096);
+        QCOMPARE(c.hits(), (uint64_t)1);
+        QCOMPARE(c.misses(), (uint64_t)1);
+    }
+
+    void caching_writePatchesCachedPage() {
+        auto real = std::make_shared<CountingLiveProvider>(QByteArray(4096, '\0'));
+        CachingProvider c(real, 16, 60000);
+        QCOMPARE(c.readU32(0x40), (uint32_t)0);
+        uint32_t v = 0xDEADBEEF;
+        QVERIFY(c.write(0x40, &v, 4));
+        int after = real->reads;
+        QCOMPARE(c.readU32(0x40), v);
+        QCOMPARE(real->readU32(0x40), v);
+        QCOMPARE(real->reads, after + 1);   // only the direct check above
+    }
+
+    void caching_unreadablePageIsNegativeCached() {
+        auto real = std::make_shared<CountingLiveProvider>(makeBuffer(4096));
+        CachingProvider c(real, 16, 60000);
+        uint32_t v = 0xFFFFFFFF;
+        QVERIFY(!c.read(0x10000, &v, 4));
+        QCOMPARE(v, (uint32_t)0);
+        int after = real->reads;
+        QVERIFY(!c.read(0x10000, &v, 4));
+        QCOMPARE(real->reads, after);
+    }
+
+    void caching_sharedPerProvider() {
+        std::shared_ptr<Provider> real = std::make_shared<CountingLiveProvider>(makeBuffer(64));
+        auto a = CachingProvider::shared(real);
+        auto b = CachingProvider::shared(real);
+        QVERIFY(a != real);
+        QCOMPARE(a.get(), b.get());
+
+        std::shared_ptr<Provider> file = std::make_shared<BufferProvider>(makeBuffer(64));
+        QCOMPARE(CachingProvider::shared(file).get(), file.get());
+    }
+
+    // ---------------------------------------------------------------
+    // SnapshotHistory
+    // ---------------------------------------------------------------
+
+    static SnapshotHistory::PageMap makePages(int count, char fill) {
+        SnapshotHistory::PageMap pages;
+        for (int i = 0; i < count; i++)
+            pages.insert(uint64_t(i) * 4096, QByteArray(4096, fill));
+        return pages;
+    }
+
+    void history_roundTripsEveryFrame() {
+        SnapshotHistory h;
+        auto pages = makePages(4, 'a');
+        QVector<SnapshotHistory::PageMap> expected;
+        for (int t = 0; t < 20; t++) {
+            pages[4096].data()[t * 3] = char(t);             // small change each tick
+            if (t == 10) pages.insert(0x10000, QByteArray(4096, 'n'));
+            if (t == 15) pages.remove(0);
+            h.push(pages, 1000 + t);
+            expected.append(pages);
+        }
+        QCOMPARE(h.count(), 20);
+        for (int t = 0; t < 20; t++) {
+            QCOMPARE(h.timestamp(t), qint64(1000 + t));
+            QVERIFY(h.pagesAt(t) == expected[t]);
+        }
+        QVERIFY(h.pagesAt(20).isEmpty());
+    }
+
+    void history_deltasAreSmall() {
+        SnapshotHistory h;
+        auto pages = makePages(64, 'x');
+        h.push(pages, 0);
+        qint64 keyframe = h.memoryUsage();
+        for (int t = 1; t <= 100; t++) {
+            pages[0].data()[0] = char(t);
+            h.push(pages, t);
+        }
+        QCOMPARE(h.keyframeCount(), 1);
+        QVERIFY(h.memoryUsage() - keyframe < 100 * 256);
+    }
+
+    void history_newKeyframeWhenDeltasGrow() {
+        SnapshotHistory h;
+        for (int t = 0; t < 8; t++)
+            h.push(makePages(4, char('a' + t)), t);   // every page rewritten
+        QVERIFY(h.keyframeCount() > 1);
+        QVERIFY(h.pagesAt(7) == makePages(4, 'h'));
+        QVERIFY(h.pagesAt(0) == makePages(4, 'a'));
+    }
+
+    void history_budgetDropsOldestFrames() {
+        SnapshotHistory h(64 * 1024);
+        int dropped = 0;
+        for (int t = 0; t < 40; t++)
+            dropped += h.push(makePages(4, char(t)), t);
+        QVERIFY(dropped > 0);
+        QCOMPARE(h.count(), 40 - dropped);
+        QVERIFY(h.memoryUsage() <= h.budget());
+        QCOMPARE(h.timestamp(h.count() - 1), qint64(39));
+        QVERIFY(h.pagesAt(h.count() - 1) == makePages(4, char(39)));
+
+        // The newest frame survives even when it alone exceeds the budget
+        h.setBudget(1);
+        QCOMPARE(h.count(), 1);
+        QVERIFY(h.pagesAt(0) == makePages(4, char(39)));
+    }
+
+    void history_frozenSnapshotRefusesWrites() {
+        auto real = std::make_shared<BufferProvider>(makeBuffer(4096));
+        SnapshotProvider snap(real, makePages(1, 'q'), 4096);
+        QVERIFY(snap.isWritable());
+        snap.freeze();
+        QVERIFY(!snap.isWritable());
+        uint8_t v = 1;
+        QVERIFY(!snap.write(0, &v, 1));
+        QCOMPARE(snap.readU8(0), (uint8_t)'q');
+        QCOMPARE(real->readU8(1), (uint8_t)7);
+    }
+
+    // ---------------------------------------------------------------
+    // Asynchronous reads
+    // ---------------------------------------------------------------
+
+    static QVector<AsyncRead> asyncRanges(std::initializer_list<QPair<uint64_t, int>> ranges) {
+        QVector<AsyncRead> reads;
+        for (const auto& r : ranges) {
+            AsyncRead a;
+            a.addr = r.first;
+            a.len  = r.second;
+            reads.append(a);
+        }
+        return reads;
+    }
+
+    void async_readFillsRanges() {
+        auto prov = std::make_shared<BufferProvider>(makeBuffer(256));
+        auto future = readFuture(prov, asyncRanges({{16, 8}, {250, 16}}));
+        future.waitForFinished();
+        QVERIFY(!future.isCanceled());
+        QVector<AsyncRead> reads = future.result();
+        QCOMPARE(reads.size(), 2);
+        QVERIFY(reads[0].ok);
+        QCOMPARE(reads[0].data, makeBuffer(256).mid(16, 8));
+        QVERIFY(!reads[1].ok);                          // runs past the end
+        QCOMPARE(reads[1].data, QByteArray(16, '\0'));
+    }
+
+    void async_cancelledTokenSkipsRead() {
+        Generation gen;
+        CancelToken token = gen.token();
+        QVERIFY(!token.isCancelled());
+        gen++;
+        QVERIFY(token.isCancelled());
+        QVERIFY(!gen.token().isCancelled());
+        QVERIFY(!CancelToken().isCancelled());
+
+        auto prov = std::make_shared<CountingLiveProvider>(makeBuffer(64));
+        auto future = readFuture(prov, asyncRanges({{0, 8}}), token);
+        future.waitForFinished();
+        QVERIFY(future.isCanceled());
+        QCOMPARE(prov->reads, 0);
+    }
+
+    void async_deliversOnCallerThread() {
+        auto prov = std::make_shared<BufferProvider>(makeBuffer(64));
+        QObject context;
+        bool delivered = false;
+        QThread* deliveredOn = nullptr;
+        readAsyncOn(&context, prov, asyncRanges({{4, 4}}), CancelToken(),
+            [&](const QVector<AsyncRead>& reads) {
+                delivered = true;
+                deliveredOn = QThread::currentThread();
+                QVERIFY(reads[0].ok);
+                QCOMPARE(reads[0].data, makeBuffer(64).mid(4, 4));
+            });
+        QTRY_VERIFY(delivered);
+        QCOMPARE(deliveredOn, QThread::currentThread());
+
+        // A result that lands after its generation moved on is dropped
+        Generation gen;
+        bool stale = false;
+        readAsyncOn(&context, prov, asyncRanges({{0, 4}}), gen.token(),
+            [&](const QVector<AsyncRead>&) { stale = true; });
+        ++gen;
+        QTest::qWait(50);
+        QVERIFY(!stale);
+    }
+
+    // ---------------------------------------------------------------
+    // readBatchParallel -- chunked fetch on the page pool
+    // ---------------------------------------------------------------
+
+    void parallel_chunksRunConcurrently() {
+        QByteArray data = makeBuffer(64 * 4096);
+        SlowBatchProvider prov(data, 4);
+        QVector<QByteArray> bufs;
+        QVector<ReadRequest> reqs = pageRequests(bufs, 64);
+        readBatchParallel(prov, reqs.data(), reqs.size());
+
+        QCOMPARE(prov.calls.load(), 4);
+        QVERIFY(prov.peak.load() >= 2);
+        QVERIFY(prov.peak.load() <= 4);
+        for (int i = 0; i < 64; i++) {
+            QVERIFY(reqs[i].ok);
+            QCOMPARE(bufs[i], data.mid(i * 4096, 4096));
+        }
+    }
+
+    void parallel_honoursLimitAndChunkSize() {
+        QByteArray data = makeBuffer(64 * 4096);
+        QVector<QByteArray> bufs;
+
+        SlowBatchProvider serial(data, 1);
+        QVector<ReadRequest> reqs = pageRequests(bufs, 64);
+        readBatchParallel(serial, reqs.data(), reqs.size());
+        QCOMPARE(serial.calls.load(), 1);
+        QVERIFY(reqs[63].ok);
+
+        // 20 pages make two chunks of at least 16
+        SlowBatchProvider wide(data, 8);
+        reqs = pageRequests(bufs, 20);
+        readBatchParallel(wide, reqs.data(), reqs.size());
+        QCOMPARE(wide.calls.load(), 2);
+        QCOMPARE(bufs[19], data.mid(19 * 4096, 4096));
+
+        // Pages past the end fail in their own chunk only
+        SlowBatchProvider shortProv(data.left(40 * 4096), 4);
+        reqs = pageRequests(bufs, 64);
+        readBatchParallel(shortProv, reqs.data(), reqs.size());
+        QVERIFY(reqs[39].ok);
+        QVERIFY(!reqs[40].ok);
+        QCOMPARE(bufs[40], QByteArray(4096, '\0'));
+    }
+
+    void parallel_cancelledChunksSkipRead() {
+        SlowBatchProvider prov(makeBuffer(64 * 4096), 4);
+        Generation gen;
+        CancelToken token = gen.token();
+        ++gen;
+        QVector<QByteArray> bufs;
+        QVector<ReadRequest> reqs = pageRequests(bufs, 64);
+        readBatchParallel(prov, reqs.data(), reqs.size(), token);
+        QCOMPARE(prov.calls.load(), 0);
+        QVERIFY(!reqs[0].ok);
+        QCOMPARE(bufs[0], QByteArray(4096, '\0'));
+    }
+
+#ifdef __linux__
+    // ---------------------------------------------------------------
+    // UringReader (/proc/self/mem as the file)
+    // ---------------------------------------------------------------
+
+    void uring_batchReadsProcMem() {
+        UringReader ring(8);
+        if (!ring.isAvailable()) QSKIP("io_uring unavailable on this kernel/build");
+
+        int fd = ::open("/proc/self/mem", O_RDONLY);
+        QVERIFY(fd >= 0);
+        QByteArray src = makeBuffer(40 * 1000);
+        char* gone = static_cast<char*>(mmap(nullptr, 4096, PROT_READ,
+                                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        munmap(gone, 4096);
+
+        constexpr int kCount = 40;
+        QVector<QByteArray> bufs(kCount);
+        QVector<ReadRequest> reqs(kCount);
+        for (int i = 0; i < kCount; i++) {
+            bufs[i] = QByteArray(1000, 'x');
+            reqs[i].addr = reinterpret_cast<uint64_t>(src.constData() + i * 1000);
+            reqs[i].buf  = bufs[i].data();
+            reqs[i].len  = 1000;
+        }
+        reqs[7].addr = reinterpret_cast<uint64_t>(gone);     // unmapped
+        reqs[9].len  = 0;
+
+        QVERIFY(ring.readBatch(fd, reqs.data(), kCount));
+        for (int i = 0; i < kCount; i++) {
+            if (i == 7 || i == 9) continue;
+            QVERIFY(reqs[i].ok);
+            QCOMPARE(bufs[i], src.mid(i * 1000, 1000));
+        }
+        QVERIFY(!reqs[7].ok);
+        QCOMPARE(bufs[7], QByteArray(1000, '\0'));
+        QVERIFY(!reqs[9].ok);
+        // 39 reads through an 8-entry ring: one submit+wait per ring-full,
+        // not one syscall per read
+        QVERIFY(ring.enterCalls() >= 5 && ring.enterCalls() < uint64_t(kCount));
+        ::close(fd);
+    }
+
+    // ---------------------------------------------------------------
+    // ModuleSymbolizer / ElfSymbolTable
+    // ---------------------------------------------------------------
+
+    void elf_symbolizesOwnFunctions() {
+        ModuleSymbolizer::Module self = selfModule();
+        QVERIFY(self.size > 0);
+        ElfSymbolTable table(self.path);
+        QVERIFY(table.isValid());
+        if (table.symbolCount() == 0) QSKIP("test binary is stripped");
+
+        ModuleSymbolizer sym;
+        sym.setModules({self});
+        uint64_t fn = reinterpret_cast<uint64_t>(&rcx_test::elfProbe);
+        QCOMPARE(sym.symbolize(fn), self.name + QStringLiteral("!rcx_test::elfProbe"));
+        QCOMPARE(sym.symbolize(fn + 2), self.name + QStringLiteral("!rcx_test::elfProbe+0x2"));
+        uint64_t data = reinterpret_cast<uint64_t>(&rcx_test::g_elfProbeData[3]);
+        QCOMPARE(sym.symbolize(data), self.name + QStringLiteral("!rcx_test::g_elfProbeData+0xc"));
+    }
+
+    void elf_addressOfModuleAndSymbol() {
+        ModuleSymbolizer::Module self = selfModule();
+        QVERIFY(self.size > 0);
+        if (ElfSymbolTable(self.path).symbolCount() == 0) QSKIP("test binary is stripped");
+
+        ModuleSymbolizer sym;
+        sym.setModules({{QStringLiteral("libother.so"), {}, 0x1000, 0x1000}, self});
+        QCOMPARE(sym.addressOf(self.name), self.base);
+        QCOMPARE(sym.addressOf(QStringLiteral("libother.so")), uint64_t(0x1000));
+        QCOMPARE(sym.addressOf(self.name + QStringLiteral("!rcx_test::elfProbe")),
+                 reinterpret_cast<uint64_t>(&rcx_test::elfProbe));
+        QCOMPARE(sym.addressOf(self.name + QStringLiteral("!_ZN8rcx_test8elfProbeEi")),
+                 reinterpret_cast<uint64_t>(&rcx_test::elfProbe));
+        QCOMPARE(sym.addressOf(self.name + QStringLiteral("!rcx_test::g_elfProbeData")),
+                 reinterpret_cast<uint64_t>(&rcx_test::g_elfProbeData[0]));
+        QCOMPARE(sym.addressOf(self.name + QStringLiteral("!no_such_symbol")), uint64_t(0));
+        QCOMPARE(sym.addressOf(QStringLiteral("libother.so!anything")), uint64_t(0));
+        QCOMPARE(sym.addressOf(QStringLiteral("missing.so")), uint64_t(0));
+    }
+
+    void elf_moduleIntervalsAndFallback() {
+        ModuleSymbolizer sym(2);
+        // Out of order on purpose; no path means no symbols
+        sym.setModules({{QStringLiteral("b.dll"), {}, 0x20000, 0x1000},
+                        {QStringLiteral("a.dll"), {}, 0x10000, 0x800}});
+        QCOMPARE(sym.moduleAt(0x10000), 0);
+        QCOMPARE(sym.moduleAt(0x10800), -1);             // gap after a.dll
+        QCOMPARE(sym.moduleAt(0x20fff), 1);
+        QCOMPARE(sym.symbolize(0x10010), QStringLiteral("a.dll+0x10"));
+        QCOMPARE(sym.symbolize(0x20000), QStringLiteral("b.dll+0x0"));
+        QVERIFY(sym.symbolize(0x8000).isEmpty());
+        QVERIFY(sym.symbolize(0x21000).isEmpty());
+        // Capacity 2: older entries are evicted, results stay correct
+        QCOMPARE(sym.symbolize(0x10010), QStringLiteral("a.dll+0x10"));
+
+        // New module list drops memoised results
+        sym.setModules({{QStringLiteral("c.dll"), {}, 0x10000, 0x100}});
+        QCOMPARE(sym.symbolize(0x10010), QStringLiteral("c.dll+0x10"));
+        QVERIFY(sym.symbolize(0x20000).isEmpty());
+    }
+
+    void elf_rejectsNonElf() {
+        QString path = QDir::tempPath() + "/rcx_test_not_elf.bin";
+        {
+            QFile f(path);
+            QVERIFY(f.open(QIODevice::WriteOnly));
+            f.write(QByteArray(256, 'M'));
+        }
+        {
+            ElfSymbolTable table(path);
+            QVERIFY(!table.isValid());
+            QCOMPARE(table.symbolCount(), 0);
+            QVERIFY(!table.lookup(0x1000, nullptr));
+        }
+        QFile::remove(path);
+    }
+
+    void elf_demangleStripsParameters() {
+#ifdef RCX_HAVE_CXXABI
+        QCOMPARE(demangleSymbol("_ZN3foo3barEi"), QStringLiteral("foo::bar"));
+        QCOMPARE(demangleSymbol("_ZNK3foo3bazEv"), QStringLiteral("foo::baz"));
+#endif
+        QCOMPARE(demangleSymbol("main"), QStringLiteral("main"));
+    }
+#endif
+
+    // ---------------------------------------------------------------
+    // PageDiffer / PageChanges
+    // ---------------------------------------------------------------
+
+    void pagediff_changeBitmaps() {
+        PageDiffer::PageMap oldPages, newPages;
+        oldPages[0x10000] = makeBuffer(4096);
+        oldPages[0x11000] = makeBuffer(4096);
+        newPages = oldPages;
+        newPages[0x10000].data()[0] ^= 1;
+        newPages[0x10000].data()[63] ^= 1;
+        newPages[0x10000].data()[64] ^= 1;
+        newPages[0x10000].data()[4095] ^= 1;
+
+        PageChanges ch;
+        PageDiffer differ;
+        QVERIFY(!differ.diff(oldPages, newPages, ch));
+        QCOMPARE(ch.changedPageCount(), 1);
+        QCOMPARE(ch.changedByteCount(), 4);
+        QVERIFY(ch.anyChanged(0x10000, 1));
+        QVERIFY(!ch.anyChanged(0x10001, 62));
+        QVERIFY(ch.anyChanged(0x10001, 63));
+        QVERIFY(!ch.anyChanged(0x10041, 4096 - 0x42));
+        QVERIFY(ch.anyChanged(0x10FF0, 0x20));      // straddles into the clean page
+        QVERIFY(!ch.anyChanged(0x11000, 4096));
+        QVERIFY(ch.covers(0x10800, 0x1000));
+        QVERIFY(!ch.covers(0x11800, 0x1000));       // runs past the compared pages
+
+        QVector<int> idx;
+        ch.changedIndices(0x1003C, 8, idx);
+        QCOMPARE(idx, QVector<int>({3, 4}));
+        idx.clear();
+        ch.changedIndices(0x10FFC, 8, idx);
+        QCOMPARE(idx, QVector<int>({3}));
+    }
+
+    void pagediff_identicalAndNewPages() {
+        PageDiffer::PageMap a;
+        a[0x1000] = makeBuffer(4096);
+        PageDiffer::PageMap b = a;                   // shares storage
+        PageChanges ch;
+        PageDiffer differ;
+        QVERIFY(differ.diff(a, b, ch));
+        QVERIFY(ch.isEmpty());
+        QVERIFY(ch.covers(0x1000, 4096));
+
+        // Same bytes in a separate copy: still identical (hash match)
+        PageDiffer::PageMap c;
+        c[0x1000] = QByteArray(a[0x1000].constData(), 4096);
+        QVERIFY(differ.diff(b, c, ch));
+
+        // A page with no previous copy is not compared
+        c[0x2000] = makeBuffer(4096);
+        QVERIFY(!differ.diff(b, c, ch));
+        QVERIFY(ch.isEmpty());
+        QVERIFY(!ch.covers(0x2000, 1));
+    }
+
+    void pagediff_churningPageIsOneBitmap() {
+        PageDiffer::PageMap a, b;
+        a[0] = QByteArray(4096, '\x00');
+        b[0] = QByteArray(4096, '\x01');
+        PageChanges ch;
+        PageDiffer differ;
+        QVERIFY(!differ.diff(a, b, ch));
+        QCOMPARE(ch.changedPageCount(), 1);
+        QCOMPARE(ch.changedByteCount(), 4096);
+        QVector<int> idx;
+        ch.changedIndices(100, 16, idx);
+        QCOMPARE(idx.size(), 16);
+        QCOMPARE(idx.first(), 0);
+    }
+
+    void pagediff_kernelsAgree() {
+        QByteArray a = makeBuffer(4096), b = a;
+        for (int i = 0; i < 4096; i += 7 + (i % 13)) b.data()[i] ^= char(0x80 >> (i % 8));
+        const auto* pa = reinterpret_cast<const uint8_t*>(a.constData());
+        const auto* pb = reinterpret_cast<const uint8_t*>(b.constData());
+        uint64_t ref[64], got[64];
+        QVERIFY(pagediff::diffScalar(pa, pb, 4096, ref));
+#ifdef RCX_DIFF_SSE2
+        QVERIFY(pagediff::diffSse2(pa, pb, 4096, got));
+        QVERIFY(std::memcmp(ref, got, sizeof(ref)) == 0);
+#endif
+#ifdef RCX_DIFF_AVX2
+        if (__builtin_cpu_supports("avx2")) {
+            QVERIFY(pagediff::diffAvx2(pa, pb, 4096, got));
+            QVERIFY(std::memcmp(ref, got, sizeof(ref)) == 0);
+        }
+#endif
+        QVERIFY(!pagediff::bestDiff()(pa, pa, 4096, got));
+        QCOMPARE(got[63], uint64_t(0));
+    }
+
+    // ---------------------------------------------------------------
+    // RefreshScheduler -- per-page poll intervals
+    // ---------------------------------------------------------------
+
+    void sched_staticPagesBackOff() {
+        RefreshScheduler s;
+        s.setIntervals(16, 660);
+        QVector<uint64_t> pages{0x1000, 0x2000};
+        QCOMPARE(s.due(pages, 0), pages);          // never read: always due
+        s.observe(0x1000, false, 0);
+        s.observe(0x2000, false, 0);
+        QCOMPARE(s.intervalOf(0x1000), 16);
+
+        // Unchanged reads double the interval up to the ceiling
+        qint64 t = 0;
+        for (int i = 0; i < 10; i++) {
+            t += s.intervalOf(0x1000);
+            QVERIFY(s.due(pages, t).contains(0x1000));
+            s.observe(0x1000, false, t);
+        }
+        QCOMPARE(s.intervalOf(0x1000), 660);
+        QVERIFY(!s.due(pages, t + 100).contains(0x1000));
+        QVERIFY(s.due(pages, t + 660).contains(0x1000));
+    }
+
+    void sched_changeResetsToFast() {
+        RefreshScheduler s;
+        s.setIntervals(16, 660);
+        s.observe(0x1000, false, 0);
+        for (int i = 1; i <= 5; i++) s.observe(0x1000, false, i * 1000);
+        QVERIFY(s.intervalOf(0x1000) > 16);
+        s.observe(0x1000, true, 6000);
+        QCOMPARE(s.intervalOf(0x1000), 16);
+        QCOMPARE(s.due({0x1000}, 6016).size(), 1);
+    }
+
+    void sched_heatLowersCeiling() {
+        RefreshScheduler s;
+        s.setIntervals(16, 640);
+        s.observe(0x1000, false, 0);
+        for (int i = 1; i <= 10; i++) s.observe(0x1000, false, i * 1000);
+        QCOMPARE(s.intervalOf(0x1000), 640);
+
+        // A field straddling two pages heats both; the hottest field wins
+        s.beginHeat();
+        s.noteHeat(0x1FFC, 8, 1);
+        s.noteHeat(0x1010, 4, 3);
+        QCOMPARE(s.intervalOf(0x1000), 80);
+        s.observe(0x2000, false, 0);
+        for (int i = 1; i <= 10; i++) s.observe(0x2000, false, i * 1000);
+        QCOMPARE(s.intervalOf(0x2000), 320);
+
+        // Heat is re-collected each compose; a page the plan clamped down
+        // regrows from its clamped interval once it cools
+        s.due({0x1000, 0x2000}, 11000);
+        s.beginHeat();
+        QCOMPARE(s.intervalOf(0x1000), 80);
+        s.observe(0x1000, false, 20000);
+        QCOMPARE(s.intervalOf(0x1000), 160);
+    }
+
+    void sched_dropsPagesLeavingThePlan() {
+        RefreshScheduler s;
+        s.observe(0x1000, false, 0);
+        s.observe(0x2000, false, 0);
+        QCOMPARE(s.trackedPages(), 2);
+        s.due({0x2000, 0x3000}, 1);
+        QCOMPARE(s.trackedPages(), 1);
+        QCOMPARE(s.intervalOf(0x1000), 0);
+
+        // fast == slow: every page due on every tick of the timer
+        RefreshScheduler fixed;
+        fixed.setIntervals(660, 660);
+        fixed.observe(0x2000, false, 0);
+        fixed.observe(0x2000, false, 0);
+        QCOMPARE(fixed.intervalOf(0x2000), 660);
+        QCOMPARE(fixed.due({0x2000}, 660).size(), 1);
+    }
+
+    void sched_sleepsUntilFirstDuePage() {
+        RefreshScheduler s;
+        s.setIntervals(16, 640);
+        QCOMPARE(s.msUntilDue({}, 0), 640);
+        QCOMPARE(s.msUntilDue({0x1000}, 0), 0);    // never read: due now
+
+        // One page backed off to the ceiling, one still fast: wake for the
+        // fast one, less the half-tick slack due() allows
+        s.observe(0x1000, false, 0);
+        for (int i = 1; i <= 10; i++) s.observe(0x1000, false, i * 1000);
+        s.observe(0x2000, true, 10000);
+        QCOMPARE(s.msUntilDue({0x1000, 0x2000}, 10000), 8);
+        QCOMPARE(s.msUntilDue({0x1000}, 10000), 632);
+        QCOMPARE(s.msUntilDue({0x1000}, 10700), 0);
+        QVERIFY(s.due({0x1000}, 10000 + 632).contains(0x1000));
+    }
+
+    // ---------------------------------------------------------------
+    // ImageProvider -- loaded layout of ELF/PE files
+    // ---------------------------------------------------------------
+
+    void image_elfSegmentsAndBss() {
+        // ELF64 with two PT_LOADs: text at 0x400000, data at 0x401000 with
+        // 0x10 bytes on disk and the rest of its page as bss
+        QByteArray f(0x210, '\0');
+        std::memcpy(f.data(), "\x7f" "ELF", 4);
+        f[4] = 2; f[5] = 1;
+        put<uint16_t>(f, 16, 2);            // e_type = ET_EXEC
+        put<uint64_t>(f, 32, 64);           // e_phoff
+        put<uint16_t>(f, 54, 56);           // e_phentsize
+        put<uint16_t>(f, 56, 2);            // e_phnum
+        auto phdr = [&](int i, uint32_t flags, uint64_t off, uint64_t va, uint64_t filesz, uint64_t memsz) {
+            int ph = 64 + i * 56;
+            put<uint32_t>(f, ph, 1);
+            put<uint32_t>(f, ph + 4, flags);
+            put<uint64_t>(f, ph + 8, off);
+            put<uint64_t>(f, ph + 16, va);
+            put<uint64_t>(f, ph + 32, filesz);
+            put<uint64_t>(f, ph + 40, memsz);
+        };
+        phdr(0, 5, 0, 0x400000, 0x200, 0x200);
+        phdr(1, 6, 0x200, 0x401000, 0x10, 0x1000);
+        put<uint64_t>(f, 0x200, 0x401008);  // pointer into its own segment
+        put<uint64_t>(f, 0x208, 0x1122334455667788ULL);
+        QString path = writeTemp("rcx_test_image.elf", f);
+        {
+            ImageProvider p(path);
+            QVERIFY(p.isImage());
+            QVERIFY(p.format() == ImageProvider::Format::Elf);
+            QCOMPARE(p.base(), uint64_t(0x400000));
+            QCOMPARE(p.size64(), uint64_t(0x402000));
+            QCOMPARE(p.regions().size(), 2);
+            QCOMPARE(p.regions()[1].prot, uint32_t(RP_Read | RP_Write));
+
+            QCOMPARE(p.readU32(0x400000), uint32_t(0x464C457F));
+            uint64_t ptr = p.readU64(0x401000);
+            QCOMPARE(p.readU64(ptr), 0x1122334455667788ULL);
+            // bss reads as zero, including a read straddling the file tail
+            char buf[16];
+            std::memset(buf, 'x', sizeof(buf));
+            QVERIFY(p.read(0x401008, buf, sizeof(buf)));
+            QCOMPARE(QByteArray(buf + 8, 8), QByteArray(8, '\0'));
+            QCOMPARE(p.readU64(0x401FF8), uint64_t(0));
+            // The gap between segments and the space past the image are unmapped
+            QVERIFY(!p.isReadable(0x400200, 4));
+            QVERIFY(!p.read(0x4001FC, buf, 8));
+            QVERIFY(!p.isReadable(0x402000, 1));
+        }
+        QFile::remove(path);
+
+        // The same segments in an ET_CORE are left to the CoreDump source
+        put<uint16_t>(f, 16, 4);
+        path = writeTemp("rcx_test_image.core", f);
+        {
+            ImageProvider p(path);
+            QVERIFY(!p.isImage());
+        }
+        QFile::remove(path);
+    }
+
+    void image_peSections() {
+        // PE32+ with .text and a .data whose virtual size exceeds its raw data
+        QByteArray f(0x600, '\0');
+        f[0] = 'M'; f[1] = 'Z';
+        put<uint32_t>(f, 0x3C, 0x40);
+        std::memcpy(f.data() + 0x40, "PE\0\0", 4);
+        put<uint16_t>(f, 0x46, 2);          // NumberOfSections
+        put<uint16_t>(f, 0x54, 0xF0);       // SizeOfOptionalHeader
+        int opt = 0x58;
+        put<uint16_t>(f, opt, 0x20b);
+        put<uint64_t>(f, opt + 24, 0x140000000ULL);
+        put<uint32_t>(f, opt + 60, 0x200);  // SizeOfHeaders
+        auto section = [&](int i, const char* name, uint32_t vsize, uint32_t rva,
+                           uint32_t rawSize, uint32_t rawPtr, uint32_t chars) {
+            int sh = opt + 0xF0 + i * 40;
+            std::memcpy(f.data() + sh, name, std::strlen(name));
+            put<uint32_t>(f, sh + 8, vsize);
+            put<uint32_t>(f, sh + 12, rva);
+            put<uint32_t>(f, sh + 16, rawSize);
+            put<uint32_t>(f, sh + 20, rawPtr);
+            put<uint32_t>(f, sh + 36, chars);
+        };
+        section(0, ".text", 0x100, 0x1000, 0x200, 0x200, 0x60000020);
+        section(1, ".data", 0x2000, 0x2000, 0x200, 0x400, 0xC0000040);
+        put<uint64_t>(f, 0x400, 0x140002010ULL);
+        put<uint32_t>(f, 0x410, 0xC0FFEE);
+        QString path = writeTemp("rcx_test_image.exe", f);
+        {
+            ImageProvider p(path);
+            QVERIFY(p.isImage());
+            QVERIFY(p.format() == ImageProvider::Format::Pe);
+            QCOMPARE(p.base(), uint64_t(0x140000000ULL));
+            QCOMPARE(p.readU16(0x140000000ULL), uint16_t(0x5A4D));
+            QCOMPARE(p.readU32(p.readU64(0x140002000ULL)), uint32_t(0xC0FFEE));
+            QCOMPARE(p.readU64(0x140003000ULL), uint64_t(0));   // past raw data
+            QVERIFY(!p.isReadable(0x140001100ULL, 1));          // past .text's virtual size
+
+            auto regs = p.regions();
+            QCOMPARE(regs.size(), 3);
+            QCOMPARE(regs[0].name, QStringLiteral("headers"));
+            QCOMPARE(regs[2].name, QStringLiteral(".data"));
+            QCOMPARE(regs[1].prot, uint32_t(RP_Read | RP_Exec));
+            QCOMPARE(p.getSymbol(0x140002010ULL), QStringLiteral("rcx_test_image.exe+0x2010"));
+            QCOMPARE(p.symbolToAddress(QStringLiteral("RCX_TEST_IMAGE.EXE")), uint64_t(0x140000000ULL));
+        }
+        QFile::remove(path);
+    }
+
+    void image_rejectsFlatFiles() {
+        QString path = writeTemp("rcx_test_image.bin", makeBuffer(4096));
+        {
+            ImageProvider p(path);
+            QVERIFY(!p.isImage());
+            QVERIFY(!p.isValid());
+            QVERIFY(p.regions().isEmpty());
+        }
+        QFile::remove(path);
+        ImageProvider missing(QDir::tempPath() + "/rcx_test_no_such_image");
+        QVERIFY(!missing.isImage());
+    }
+
+#ifdef __linux__
+    void image_selfMatchesLiveLayout() {
+        ModuleSymbolizer::Module self = selfModule();
+        QVERIFY(self.size > 0);
+        ImageProvider p(self.path);
+        QVERIFY(p.isImage());
+        // Same offset from the image base on disk and in memory
+        uint64_t live = reinterpret_cast<uint64_t>(&rcx_test::g_imageProbe);
+        uint64_t onDisk = live - self.base + p.base();
+        QCOMPARE(p.readU32(onDisk), uint32_t(0x5EC7104));
+        uint64_t bss = reinterpret_cast<uint64_t>(&rcx_test::g_elfProbeData[0]);
+        QCOMPARE(p.readU64(bss - self.base + p.base()), uint64_t(0));
+        if (ElfSymbolTable(self.path).symbolCount() > 0)
+            QCOMPARE(p.getSymbol(onDisk), self.name + QStringLiteral("!rcx_test::g_imageProbe"));
+    }
+#endif
+
     // ---------------------------------------------------------------
     // Polymorphism -- unique_ptr<Provider> usage
     // ---------------------------------------------------------------
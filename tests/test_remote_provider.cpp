@@ -0,0 +1,338 @@
+#include <QTest>
+#include <QByteArray>
+#include <QDir>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "providers/provider.h"
+#include "../plugins/RemoteMemory/RemoteMemoryPlugin.h"
+#include "../plugins/RemoteMemory/agent/rcx_agent.h"
+
+using namespace rcx;
+
+// The reference agent, run in-process against this test's own memory.
+// Each accepted connection is served on its own thread, like rcx-agent.
+class AgentServer {
+public:
+    bool start(const std::string& endpoint, const remote::AgentOptions& opts = {}) {
+        std::string err;
+        m_fd = remote::listenOn(endpoint, &err);
+        if (m_fd < 0) return false;
+        m_accept = std::thread([this, opts] {
+            for (;;) {
+                int c = ::accept(m_fd, nullptr, nullptr);
+                if (c < 0) return;
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_conns.emplace_back([c, opts] { remote::serveConnection(c, ::getpid(), opts); });
+            }
+        });
+        return true;
+    }
+
+    uint16_t tcpPort() const {
+        sockaddr_in sa{};
+        socklen_t len = sizeof(sa);
+        getsockname(m_fd, reinterpret_cast<sockaddr*>(&sa), &len);
+        return ntohs(sa.sin_port);
+    }
+
+    // Providers must be gone first so their connections have closed
+    void stop() {
+        if (m_fd < 0) return;
+        ::shutdown(m_fd, SHUT_RDWR);
+        m_accept.join();
+        ::close(m_fd);
+        m_fd = -1;
+        for (auto& t : m_conns) t.join();
+        m_conns.clear();
+    }
+
+private:
+    int m_fd = -1;
+    std::thread m_accept;
+    std::mutex m_lock;
+    std::vector<std::thread> m_conns;
+};
+
+static constexpr int kPage = 4096;
+static constexpr int kDataPages = 320;
+
+class TestRemoteProvider : public QObject {
+    Q_OBJECT
+
+private:
+    QString         m_sockPath;
+    AgentServer     m_server;
+    char*           m_data = nullptr;     // kDataPages of patterned bytes
+    char*           m_holed = nullptr;    // 3 pages, middle one PROT_NONE
+
+    QString endpoint() const { return QStringLiteral("unix:") + m_sockPath; }
+    uint64_t addrOf(const void* p) const { return reinterpret_cast<uint64_t>(p); }
+
+private slots:
+    void initTestCase() {
+        m_data = static_cast<char*>(mmap(nullptr, size_t(kDataPages) * kPage, PROT_READ | PROT_WRITE,
+                                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        QVERIFY(m_data != MAP_FAILED);
+        for (int i = 0; i < kDataPages * kPage; i++)
+            m_data[i] = char((i * 13) ^ (i >> 12));
+
+        m_holed = static_cast<char*>(mmap(nullptr, 3 * kPage, PROT_READ | PROT_WRITE,
+                                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        QVERIFY(m_holed != MAP_FAILED);
+        std::memset(m_holed, 0x11, 3 * kPage);
+        QCOMPARE(mprotect(m_holed + kPage, kPage, PROT_NONE), 0);
+
+        m_sockPath = QDir::tempPath() + QStringLiteral("/rcx_test_agent_%1.sock").arg(::getpid());
+        remote::AgentOptions opts;
+        opts.allowWrite = true;
+        QVERIFY(m_server.start("unix:" + m_sockPath.toStdString(), opts));
+    }
+
+    void cleanupTestCase() {
+        m_server.stop();
+        ::unlink(m_sockPath.toUtf8().constData());
+        munmap(m_data, size_t(kDataPages) * kPage);
+        munmap(m_holed, 3 * kPage);
+    }
+
+    void handshakeDescribesProcess() {
+        RemoteMemoryProvider p(endpoint());
+        QVERIFY2(p.isConnected(), qPrintable(p.errorString()));
+        QVERIFY(p.isValid());
+        QCOMPARE(p.remotePid(), uint32_t(::getpid()));
+        QVERIFY(p.isLive());
+        QVERIFY(p.isWritable());
+        QCOMPARE(p.kind(), QStringLiteral("Remote"));
+        QVERIFY(p.name().endsWith(QStringLiteral("@") + endpoint()));
+        QVERIFY(p.base() != 0);
+    }
+
+    void readsRemoteMemory() {
+        RemoteMemoryProvider p(endpoint());
+        uint64_t base = addrOf(m_data);
+        QCOMPARE(p.readU32(base + 100), *reinterpret_cast<uint32_t*>(m_data + 100));
+        // Crosses a page boundary
+        QByteArray got = p.readBytes(base + kPage - 10, 20);
+        QCOMPARE(got, QByteArray(m_data + kPage - 10, 20));
+    }
+
+    void largeBatchIsPipelined() {
+        RemoteMemoryProvider p(endpoint());
+        QVERIFY(p.isConnected());
+        std::vector<char> out(size_t(kDataPages) * kPage);
+        std::vector<ReadRequest> reqs(kDataPages);
+        for (int i = 0; i < kDataPages; i++) {
+            reqs[i].addr = addrOf(m_data) + uint64_t(i) * kPage;
+            reqs[i].buf = out.data() + size_t(i) * kPage;
+            reqs[i].len = kPage;
+        }
+        uint64_t before = p.requestsSent();
+        p.readBatch(reqs.data(), kDataPages);
+        // 320 pages split at 256 ranges per message: two messages, sent back to back
+        QCOMPARE(p.requestsSent() - before, uint64_t(2));
+        for (const auto& r : reqs) QVERIFY(r.ok);
+        QVERIFY(std::memcmp(out.data(), m_data, out.size()) == 0);
+    }
+
+    void zeroPagesCostAStatusByte() {
+        char* zeros = static_cast<char*>(mmap(nullptr, 64 * kPage, PROT_READ | PROT_WRITE,
+                                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        std::memset(zeros, 0, 64 * kPage);
+        RemoteMemoryProvider p(endpoint());
+        std::vector<char> out(64 * kPage, 'x');
+        ReadRequest r;
+        r.addr = addrOf(zeros);
+        r.buf = out.data();
+        r.len = 64 * kPage;
+        uint64_t before = p.bytesReceived();
+        p.readBatch(&r, 1);
+        QVERIFY(r.ok);
+        QVERIFY(p.bytesReceived() - before < 64);
+        QVERIFY(std::all_of(out.begin(), out.end(), [](char c) { return c == 0; }));
+        munmap(zeros, 64 * kPage);
+    }
+
+    void compressiblePagesRoundTrip() {
+        std::vector<char> text(16 * kPage);
+        for (size_t i = 0; i < text.size(); i++) text[i] = "reclass "[i % 8];
+        RemoteMemoryProvider p(endpoint());
+        uint64_t before = p.bytesReceived();
+        QByteArray got = p.readBytes(addrOf(text.data()), int(text.size()));
+        QCOMPARE(got, QByteArray(text.data(), int(text.size())));
+#ifdef RCX_AGENT_HAVE_ZLIB
+        QVERIFY(p.bytesReceived() - before < text.size() / 4);
+#else
+        Q_UNUSED(before);
+#endif
+    }
+
+    void unreadableRangeFailsAlone() {
+        RemoteMemoryProvider p(endpoint());
+        char bufs[3][64];
+        ReadRequest reqs[3];
+        for (int i = 0; i < 3; i++) {
+            std::memset(bufs[i], 'x', sizeof(bufs[i]));
+            reqs[i].addr = addrOf(m_holed + i * kPage);
+            reqs[i].buf = bufs[i];
+            reqs[i].len = sizeof(bufs[i]);
+        }
+        p.readBatch(reqs, 3);
+        QVERIFY(reqs[0].ok);
+        QVERIFY(!reqs[1].ok);
+        QVERIFY(reqs[2].ok);
+        QCOMPARE(bufs[0][0], char(0x11));
+        QCOMPARE(bufs[1][0], char(0));       // failed ranges are zero-filled
+        QCOMPARE(bufs[2][63], char(0x11));
+
+        // A range running into the hole fails as a whole
+        char tail[32];
+        QVERIFY(!p.read(addrOf(m_holed + kPage - 16), tail, sizeof(tail)));
+    }
+
+    void regionsAndSymbols() {
+        RemoteMemoryProvider p(endpoint());
+        auto regs = p.regions();
+        QVERIFY(!regs.isEmpty());
+        QVERIFY(regionsCover(regs, addrOf(m_data), uint64_t(kDataPages) * kPage));
+        QVERIFY(p.isReadable(addrOf(m_holed), 16));
+        QVERIFY(!p.isReadable(addrOf(m_holed + kPage), 16));
+
+        QString sym = p.getSymbol(p.base() + 0x10);
+        QVERIFY2(sym.endsWith(QStringLiteral("+0x10")), qPrintable(sym));
+        QString module = sym.left(sym.indexOf('+'));
+        QCOMPARE(p.symbolToAddress(module.toUpper()), p.base());
+    }
+
+    void writesReachTarget() {
+        RemoteMemoryProvider p(endpoint());
+        uint32_t v = 0xA5A5F00D;
+        QVERIFY(p.write(addrOf(m_data + 8), &v, sizeof(v)));
+        QCOMPARE(*reinterpret_cast<uint32_t*>(m_data + 8), v);
+    }
+
+    void readOnlyAgentRefusesWrites() {
+        AgentServer ro;
+        QString path = m_sockPath + QStringLiteral(".ro");
+        remote::AgentOptions opts;
+        opts.allowWrite = false;
+        QVERIFY(ro.start("unix:" + path.toStdString(), opts));
+        {
+            RemoteMemoryProvider p(QStringLiteral("unix:") + path);
+            QVERIFY(p.isConnected());
+            QVERIFY(!p.isWritable());
+            uint32_t v = 1;
+            QVERIFY(!p.write(addrOf(m_data), &v, sizeof(v)));
+        }
+        ro.stop();
+        ::unlink(path.toUtf8().constData());
+    }
+
+    void agentIsReadOnlyByDefault() {
+        AgentServer ro;
+        QString path = m_sockPath + QStringLiteral(".default");
+        QVERIFY(ro.start("unix:" + path.toStdString()));
+        {
+            RemoteMemoryProvider p(QStringLiteral("unix:") + path);
+            QVERIFY(p.isConnected());
+            QVERIFY(!p.isWritable());
+        }
+        ro.stop();
+        ::unlink(path.toUtf8().constData());
+    }
+
+    void tcpEndpoint() {
+        AgentServer tcp;
+        remote::AgentOptions opts;
+        opts.token = "s3cret";
+        QVERIFY(tcp.start("tcp:127.0.0.1:0", opts));
+        {
+            RemoteMemoryProvider p(QStringLiteral("tcp:127.0.0.1:%1").arg(tcp.tcpPort()), "s3cret");
+            QVERIFY2(p.isConnected(), qPrintable(p.errorString()));
+            QCOMPARE(p.readU64(addrOf(m_data + 64)), *reinterpret_cast<uint64_t*>(m_data + 64));
+        }
+        tcp.stop();
+    }
+
+    void tcpPeersNeedTheToken() {
+        AgentServer tcp;
+        remote::AgentOptions opts;
+        opts.token = "s3cret";
+        QVERIFY(tcp.start("tcp:127.0.0.1:0", opts));
+        QString ep = QStringLiteral("tcp:127.0.0.1:%1").arg(tcp.tcpPort());
+        {
+            RemoteMemoryProvider wrong(ep, "guess");
+            QVERIFY(!wrong.isConnected());
+            QVERIFY2(wrong.errorString().contains(QStringLiteral("authentication")),
+                     qPrintable(wrong.errorString()));
+            RemoteMemoryProvider none(ep);
+            QVERIFY(!none.isConnected());
+        }
+        tcp.stop();
+
+        // Without a configured token, TCP peers are not served at all
+        AgentServer open;
+        QVERIFY(open.start("tcp:127.0.0.1:0"));
+        {
+            RemoteMemoryProvider p(QStringLiteral("tcp:127.0.0.1:%1").arg(open.tcpPort()));
+            QVERIFY(!p.isConnected());
+        }
+        open.stop();
+    }
+
+    void localListenersAreDetected() {
+        std::string err;
+        int lo = remote::listenOn("tcp:127.0.0.1:0", &err);
+        int any = remote::listenOn("tcp:0.0.0.0:0", &err);
+        QVERIFY(lo >= 0 && any >= 0);
+        QVERIFY(remote::isLocalListener(lo));
+        QVERIFY(!remote::isLocalListener(any));
+        ::close(lo);
+        ::close(any);
+    }
+
+    void concurrentCallersShareOneConnection() {
+        RemoteMemoryProvider p(endpoint());
+        std::atomic<int> mismatches{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < 200; i++) {
+                    int off = ((t * 200 + i) * 37) % (kDataPages * kPage - 8);
+                    uint64_t want;
+                    std::memcpy(&want, m_data + off, 8);
+                    if (p.readU64(addrOf(m_data + off)) != want) mismatches++;
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+        QCOMPARE(mismatches.load(), 0);
+    }
+
+    void pluginHandlesRemotePrefix() {
+        RemoteMemoryPlugin plugin;
+        QVERIFY(plugin.canHandle("remote:tcp:host:1"));
+        QVERIFY(!plugin.canHandle("tcp:host:1"));
+
+        QString err;
+        QVERIFY(!plugin.createProvider("remote:unix:/nonexistent/agent.sock", &err));
+        QVERIFY(!err.isEmpty());
+        QVERIFY(!plugin.createProvider("remote:carrier-pigeon", &err));
+
+        auto prov = plugin.createProvider("remote:" + endpoint(), &err);
+        QVERIFY2(prov, qPrintable(err));
+        QCOMPARE(plugin.getInitialBaseAddress("remote:" + endpoint()), prov->base());
+    }
+};
+
+QTEST_MAIN(TestRemoteProvider)
+#include "test_remote_provider.moc"